@@ -8,19 +8,30 @@
 #include <string>
 
 #include <cameraserver/CameraServer.h>
+#include <frc/Timer.h>
 
 #include <auton/CyclePrimitives.h>
+#include <auton/TrajectoryCache.h>
 #include <chassis/ChassisFactory.h>
 #include <chassis/IChassis.h>
 #include <chassis/differential/ArcadeDrive.h>
+#include <chassis/swerve/SwerveChassis.h>
 #include <chassis/swerve/SwerveDrive.h>
 #include <TeleopControl.h>
+#include <hw/CANFrameBudget.h>
+#include <hw/DeviceConfigQueue.h>
 #include <hw/DragonLimelight.h>
+#include <hw/FrameRateProfiles.h>
 #include <hw/factories/LimelightFactory.h>
+#include <hw/sim/DragonSimulation.h>
+#include <utils/InputRecorder.h>
 #include <utils/Logger.h>
 #include <utils/LoggerData.h>
 #include <utils/LoggerEnums.h>
+#include <utils/LoopProfiler.h>
+#include <RobotState.h>
 #include <RobotXmlParser.h>
+#include <mechanisms/MechanismRegistry.h>
 #include <mechanisms/StateMgrHelper.h>
 
 using namespace std;
@@ -28,7 +39,7 @@ using namespace std;
 void Robot::RobotInit() 
 {
     Logger::GetLogger()->PutLoggingSelectionsOnDashboard();
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("RobotInit"), string("arrived"));   
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("RobotInit"), string("arrived"));   
 
     //CameraServer::SetSize(CameraServer::kSize320x240);
     //CameraServer::StartAutomaticCapture();
@@ -37,6 +48,25 @@ void Robot::RobotInit()
     auto XmlParser = new RobotXmlParser();
     XmlParser->ParseXML();
 
+    // every device has asked for its status frames; fit them to each CAN bus and write them
+    CANFrameBudget::GetInstance()->Plan();
+
+    // the mechanisms are all created; collect them so the periodic code doesn't look them up
+    MechanismRegistry::GetInstance()->Build();
+
+    // the motor configurations are written in the background while parsing; the drive has to be 
+    // ready before anything else starts, the mechanism motors may finish after RobotInit (the 
+    // mechanisms don't run until they do)
+    auto configQueue = DeviceConfigQueue::GetInstance();
+    configQueue->WaitForRequired();
+    if (!m_finishMechanismConfigAfterInit)
+    {
+        configQueue->WaitForAll();
+    }
+
+    // parse the auton paths in the background so DrivePath never reads files during auton
+    TrajectoryCache::GetInstance()->StartLoading();
+
     // Get local copies of the teleop controller and the chassis
     m_controller = TeleopControl::GetInstance();
     auto factory = ChassisFactory::GetChassisFactory();
@@ -47,12 +77,34 @@ void Robot::RobotInit()
     {
          m_swerve = m_chassis->GetType() == IChassis::CHASSIS_TYPE::SWERVE ? new SwerveDrive() : nullptr;
          m_arcade = m_chassis->GetType() == IChassis::CHASSIS_TYPE::DIFFERENTIAL ? new ArcadeDrive() : nullptr;
+
+         // the CAN frames are planned and the drive motors configured, so odometry can sample them now
+         if (m_chassis->GetType() == IChassis::CHASSIS_TYPE::SWERVE)
+         {
+             factory->GetSwerveChassis()->StartOdometryThread();
+         }
     }
     m_dragonLimeLight = LimelightFactory::GetLimelightFactory()->GetLimelight();
+    RobotStateMgr::GetInstance()->Init();
         
 
     m_cyclePrims = new CyclePrimitives();
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("RobotInit"), string("end"));}
+
+    // record what every loop reads so a match can be replayed on the desktop (inputReplay)
+    if (m_recordInputs && frc::RobotBase::IsReal())
+    {
+        InputRecorder::GetInstance()->StartRecording();
+    }
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("RobotInit"), string("end"));}
+
+/// @brief  Take this loop's sensor snapshot.  TimedRobot runs the mode's periodic function before 
+///         RobotPeriodic, so each of them calls this first; the mode code and the odometry in 
+///         RobotPeriodic then all read the same, current snapshot instead of going back to the CAN bus.
+void Robot::SampleState()
+{
+    PROFILE_PHASE(SENSORS);
+    RobotStateMgr::GetInstance()->Update();
+}
 
 /**
  * This function is called every robot packet, no matter the mode. Use
@@ -64,18 +116,31 @@ void Robot::RobotInit()
  */
 void Robot::RobotPeriodic() 
 {
+    // the mode's periodic function already took this loop's snapshot (SampleState)
+    const auto& state = RobotStateMgr::GetInstance()->GetState();
+
     if (m_chassis != nullptr)
     {
+        PROFILE_PHASE(ODOMETRY);
         m_chassis->UpdateOdometry();
     }
-    if (m_dragonLimeLight != nullptr)
+
     {
-        LoggerDoubleValue horAngle = {string("Horizontal Angle"), m_dragonLimeLight->GetTargetHorizontalOffset().to<double>()};
-        LoggerDoubleValue distance = { string("distance "), m_dragonLimeLight->EstimateTargetDistance().to<double>()};
-        LoggerData  data = {LOGGER_LEVEL::PRINT, string("DragonLimelight"), {}, {}, {horAngle, distance}, {}};
-        Logger::GetLogger()->LogData(data);
+        PROFILE_PHASE(LOGGER);
+        if (state.limelight.valid && Logger::IsLoggingEnabled(LOGGER_LEVEL::PRINT))
+        {
+            LoggerDoubleValue horAngle = {string("Horizontal Angle"), state.limelight.horizontalOffset.to<double>()};
+            LoggerDoubleValue distance = { string("distance "), state.limelight.targetDistance.to<double>()};
+            LoggerData  data = {LOGGER_LEVEL::PRINT, string("DragonLimelight"), {}, {}, {horAngle, distance}, {}};
+            Logger::GetLogger()->LogData(data);
+        }
+        Logger::GetLogger()->PeriodicLog();
     }
-    Logger::GetLogger()->PeriodicLog();
+
+    // RobotPeriodic runs after the mode code, so this loop's mechanism run (if any) is done
+    InputRecorder::GetInstance()->EndLoop();
+    MechanismRegistry::GetInstance()->EndLoop();
+    PROFILE_END_LOOP();
 }
 
 /**
@@ -91,25 +156,29 @@ void Robot::RobotPeriodic()
  */
 void Robot::AutonomousInit() 
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("AutonomousInit"), string("arrived"));   
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("AutonomousInit"), string("arrived"));   
+    FrameRateProfiles::GetInstance()->SetMode(FrameRateProfiles::ROBOT_MODE::AUTON);
     if (m_cyclePrims != nullptr)
     {
         m_cyclePrims->Init();
     }
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("AutonomousInit"), string("end"));
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("AutonomousInit"), string("end"));
 }
 
 void Robot::AutonomousPeriodic() 
 {
+    SampleState();
     if (m_cyclePrims != nullptr)
     {
+        PROFILE_PHASE(AUTON);
         m_cyclePrims->Run();
     }
 }
 
 void Robot::TeleopInit() 
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TeleopInit"), string("arrived"));   
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TeleopInit"), string("arrived"));   
+    FrameRateProfiles::GetInstance()->SetMode(FrameRateProfiles::ROBOT_MODE::TELEOP);
     if (m_chassis != nullptr && m_controller != nullptr)
     {
         if (m_swerve != nullptr)
@@ -123,14 +192,16 @@ void Robot::TeleopInit()
     }
     StateMgrHelper::RunCurrentMechanismStates();
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TeleopInit"), string("end"));
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TeleopInit"), string("end"));
 }
 
 
 void Robot::TeleopPeriodic() 
 {
+    SampleState();
     if (m_chassis != nullptr && m_controller != nullptr)
     {
+        PROFILE_PHASE(DRIVE);
         if (m_swerve != nullptr)
         {
             m_swerve->Run();
@@ -140,27 +211,63 @@ void Robot::TeleopPeriodic()
             m_arcade->Run();
         }
     }
-    StateMgrHelper::RunCurrentMechanismStates();
+
+    {
+        PROFILE_PHASE(MECHANISMS);
+        StateMgrHelper::RunCurrentMechanismStates();
+    }
 }
 
 void Robot::DisabledInit() 
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("DisabledInit"), string("arrived"));   
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("DisabledInit"), string("arrived"));   
+    FrameRateProfiles::GetInstance()->SetMode(FrameRateProfiles::ROBOT_MODE::DISABLED);
 }
 
 void Robot::DisabledPeriodic() 
 {
+    SampleState();
 
+    // get the selected auton ready so AutonomousInit doesn't parse anything
+    if (m_cyclePrims != nullptr)
+    {
+        m_cyclePrims->Preload();
+    }
 }
 
 void Robot::TestInit() 
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TestInit"), string("arrived"));   
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("ArrivedAt"), string("TestInit"), string("arrived"));   
+    FrameRateProfiles::GetInstance()->SetMode(FrameRateProfiles::ROBOT_MODE::TEST);
 }
 
 void Robot::TestPeriodic() 
 {
+    SampleState();
+}
 
+void Robot::SimulationInit()
+{
+    m_lastSimTime = frc::Timer::GetFPGATimestamp();
+}
+
+/// @brief  Step the motor models and feed the chassis sensors.  dt is measured from the FPGA clock rather 
+///         than assumed to be 20 ms so the models stay right when the sim GUI runs faster than real time.
+void Robot::SimulationPeriodic()
+{
+    auto now = frc::Timer::GetFPGATimestamp();
+    auto dt = now - m_lastSimTime;
+    m_lastSimTime = now;
+    if (dt <= units::time::second_t(0.0))
+    {
+        return;
+    }
+
+    DragonSimulation::GetInstance()->Update(dt);
+    if (m_chassis != nullptr && m_chassis->GetType() == IChassis::CHASSIS_TYPE::SWERVE)
+    {
+        ChassisFactory::GetChassisFactory()->GetSwerveChassis()->UpdateSimulation(dt);
+    }
 }
 
 
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <frc/TimedRobot.h>
+#include <units/time.h>
 
 class CyclePrimitives;
 class TeleopControl;
@@ -39,8 +40,13 @@ class Robot : public frc::TimedRobot
         void DisabledPeriodic() override;
         void TestInit() override;
         void TestPeriodic() override;
+        void SimulationInit() override;
+        void SimulationPeriodic() override;
 
     private:
+        /// @brief  Take this loop's sensor snapshot; called first in every mode's periodic function
+        void SampleState();
+
         TeleopControl*        m_controller;
         IChassis*             m_chassis;
         CyclePrimitives*      m_cyclePrims;
@@ -48,4 +54,7 @@ class Robot : public frc::TimedRobot
         SwerveDrive*          m_swerve;
         ArcadeDrive*          m_arcade;
         DragonLimelight*      m_dragonLimeLight;
+        units::time::second_t m_lastSimTime;
+        const bool            m_finishMechanismConfigAfterInit = true;
+        const bool            m_recordInputs = true;           // write an InputRecorder log on the real robot (enabled or FMS loops only)
 };
@@ -0,0 +1,159 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+
+// FRC includes
+#include <frc/PowerDistribution.h>
+#include <frc/Timer.h>
+
+// Team 302 includes
+#include <chassis/ChassisFactory.h>
+#include <chassis/IChassis.h>
+#include <chassis/swerve/SwerveChassis.h>
+#include <chassis/swerve/SwerveModule.h>
+#include <hw/DragonLimelight.h>
+#include <hw/DragonPigeon.h>
+#include <hw/factories/LimelightFactory.h>
+#include <hw/factories/PDPFactory.h>
+#include <hw/factories/PigeonFactory.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <RobotState.h>
+#include <utils/InputRecorder.h>
+
+// Third Party Includes
+
+using namespace std;
+
+RobotStateMgr* RobotStateMgr::m_instance = nullptr;
+RobotStateMgr* RobotStateMgr::GetInstance()
+{
+    if ( RobotStateMgr::m_instance == nullptr )
+    {
+        RobotStateMgr::m_instance = new RobotStateMgr();
+    }
+    return RobotStateMgr::m_instance;
+}
+
+RobotStateMgr::RobotStateMgr() : m_state(),
+                                 m_swerve(nullptr),
+                                 m_pigeon(nullptr),
+                                 m_pdp(nullptr),
+                                 m_limelight(nullptr)
+{
+}
+
+/// @brief  Look up the hardware that gets sampled.  Call after the robot XML has been parsed.
+void RobotStateMgr::Init()
+{
+    auto factory = ChassisFactory::GetChassisFactory();
+    auto chassis = factory->GetIChassis();
+    m_swerve = ( chassis != nullptr && chassis->GetType() == IChassis::CHASSIS_TYPE::SWERVE ) ? factory->GetSwerveChassis() : nullptr;
+
+    m_pigeon    = PigeonFactory::GetFactory()->GetPigeon(DragonPigeon::PIGEON_USAGE::CENTER_OF_ROBOT);
+    m_pdp       = PDPFactory::GetFactory()->GetPDP();
+    m_limelight = LimelightFactory::GetLimelightFactory()->GetLimelight();
+}
+
+/// @brief  Sample every module, the gyro, the PDP and the limelight once for this cycle
+void RobotStateMgr::Update()
+{
+    m_state.cycle++;
+    if ( m_state.cycle == 0 )
+    {
+        m_state.cycle = 1;  // 0 is reserved for "no snapshot yet"
+    }
+    m_state.timestamp = frc::Timer::GetFPGATimestamp();
+
+    // a replayed loop gets the recorded sensor values instead of the hardware ones
+    auto recorder = InputRecorder::GetInstance();
+    if ( recorder->IsReplaying() )
+    {
+        recorder->ReplayState(m_state);
+        return;
+    }
+
+    if ( m_swerve != nullptr )
+    {
+        for ( auto module : { m_swerve->GetFrontLeft(), m_swerve->GetFrontRight(), m_swerve->GetBackLeft(), m_swerve->GetBackRight() } )
+        {
+            if ( module.get() != nullptr )
+            {
+                module.get()->Sample(m_state.modules[module.get()->GetType()]);
+            }
+        }
+    }
+
+    m_state.gyroValid = m_pigeon != nullptr;
+    if ( m_state.gyroValid )
+    {
+        m_state.yaw = units::angle::degree_t(m_pigeon->GetYaw());
+    }
+
+    m_state.pdpValid = m_pdp != nullptr;
+    if ( m_state.pdpValid )
+    {
+        m_state.batteryVoltage = units::voltage::volt_t(m_pdp->GetVoltage());
+        m_state.totalCurrent   = units::current::ampere_t(m_pdp->GetTotalCurrent());
+    }
+
+    if ( m_limelight != nullptr )
+    {
+        m_state.limelight = m_limelight->GetObservation();
+    }
+    else
+    {
+        m_state.limelight = TargetObservation();
+    }
+
+    recorder->RecordState(m_state);
+}
+
+/// @brief  Gyro yaw from the snapshot (reads the pigeon directly before the first snapshot)
+/// @return units::angle::degree_t  yaw
+units::angle::degree_t RobotStateMgr::GetYaw() const
+{
+    if ( m_state.gyroValid )
+    {
+        return m_state.yaw;
+    }
+    auto pigeon = PigeonFactory::GetFactory()->GetPigeon(DragonPigeon::PIGEON_USAGE::CENTER_OF_ROBOT);
+    return pigeon != nullptr ? units::angle::degree_t(pigeon->GetYaw()) : units::angle::degree_t(0.0);
+}
+
+/// @brief  Read the motor position and speed if they haven't been read this cycle
+/// @param [in]     IDragonMotorController*     motor:  motor to read
+/// @param [in/out] MotorSample&                sample: cached values for that motor
+/// @return const MotorSample&  the up to date sample
+const MotorSample& RobotStateMgr::SampleMotor
+(
+    IDragonMotorController*     motor,
+    MotorSample&                sample
+) const
+{
+    if ( motor != nullptr && ( m_state.cycle == 0 || sample.cycle != m_state.cycle ) )
+    {
+        auto recorder = InputRecorder::GetInstance();
+        if ( !recorder->ReplayMotor(motor->GetID(), sample.rotations, sample.rps) )
+        {
+            sample.rotations = motor->GetRotations();
+            sample.rps       = motor->GetRPS();
+            recorder->RecordMotor(motor->GetID(), sample.rotations, sample.rps);
+        }
+        sample.cycle     = m_state.cycle;
+    }
+    return sample;
+}
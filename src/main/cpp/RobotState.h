@@ -0,0 +1,124 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+
+// FRC includes
+#include <units/angle.h>
+#include <units/current.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <hw/TargetObservation.h>
+
+// Third Party Includes
+
+class DragonLimelight;
+class DragonPigeon;
+class IDragonMotorController;
+class SwerveChassis;
+
+namespace frc
+{
+    class PowerDistribution;
+}
+
+/// @struct SwerveModuleSample
+/// @brief  Sensor values for one swerve module, read once per cycle
+struct SwerveModuleSample
+{
+    bool                                valid = false;
+    double                              driveRPS = 0.0;             // drive wheel revolutions per second
+    double                              driveRotations = 0.0;       // drive wheel rotations
+    double                              turnTicks = 0.0;            // turn motor integrated sensor position
+    units::angle::degree_t              absoluteAngle{0.0};         // CANCoder absolute position (-180 to 180)
+    units::angle::degree_t              angle{0.0};                 // CANCoder accumulated position
+};
+
+/// @struct MotorSample
+/// @brief  Position and speed of a mechanism motor, memoized for the cycle it was read in
+struct MotorSample
+{
+    unsigned int                        cycle = 0;
+    double                              rotations = 0.0;
+    double                              rps = 0.0;
+};
+
+/// @struct RobotState
+/// @brief  Snapshot of the robot sensors taken at the top of RobotPeriodic.  Chassis and mechanism
+///         code read from here instead of going back to the CAN devices.
+struct RobotState
+{
+    unsigned int                        cycle = 0;                  // 0 until the first snapshot is taken
+    units::time::second_t               timestamp{0.0};
+    std::array<SwerveModuleSample, 4>   modules;                    // indexed by SwerveModule::ModuleID
+    bool                                gyroValid = false;
+    units::angle::degree_t              yaw{0.0};
+    bool                                pdpValid = false;
+    units::voltage::volt_t              batteryVoltage{0.0};
+    units::current::ampere_t            totalCurrent{0.0};
+    TargetObservation                   limelight;
+};
+
+/// @class RobotStateMgr
+/// @brief Owns the per-cycle RobotState snapshot
+class RobotStateMgr
+{
+    public:
+        /// @brief  Find or create the state manager
+        /// @return RobotStateMgr* pointer to the state manager
+        static RobotStateMgr* GetInstance();
+
+        /// @brief  Look up the hardware that gets sampled.  Call after the robot XML has been parsed.
+        void Init();
+
+        /// @brief  Sample every module, the gyro, the PDP and the limelight once for this cycle
+        void Update();
+
+        const RobotState& GetState() const { return m_state; }
+        unsigned int GetCycle() const { return m_state.cycle; }
+
+        /// @brief  Gyro yaw from the snapshot (reads the pigeon directly before the first snapshot)
+        /// @return units::angle::degree_t  yaw
+        units::angle::degree_t GetYaw() const;
+
+        /// @brief  Read the motor position and speed if they haven't been read this cycle
+        /// @param [in]     IDragonMotorController*     motor:  motor to read
+        /// @param [in/out] MotorSample&                sample: cached values for that motor
+        /// @return const MotorSample&  the up to date sample
+        const MotorSample& SampleMotor
+        (
+            IDragonMotorController*     motor,
+            MotorSample&                sample
+        ) const;
+
+    private:
+        RobotStateMgr();
+        ~RobotStateMgr() = default;
+
+        RobotState                          m_state;
+        SwerveChassis*                      m_swerve;
+        DragonPigeon*                       m_pigeon;
+        frc::PowerDistribution*             m_pdp;
+        DragonLimelight*                    m_limelight;
+
+        static RobotStateMgr*               m_instance;
+};
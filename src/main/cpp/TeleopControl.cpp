@@ -29,6 +29,7 @@
 #include <gamepad/DragonGamePad.h>
 #include <TeleopControl.h>
 #include <frc/DriverStation.h>
+#include <utils/InputRecorder.h>
 #include <utils/Logger.h>
 
 using namespace frc;
@@ -287,7 +288,7 @@ double TeleopControl::GetAxisValue
     		value = m_controller[ ctlIndex ]->GetAxisValue( axis );
     	}
     }
-    return value;
+    return InputRecorder::GetInstance()->Axis( function, value );
 }
 
 //------------------------------------------------------------------
@@ -311,7 +312,7 @@ bool TeleopControl::IsButtonPressed
     		isSelected = m_controller[ ctlIndex ]->IsButtonPressed( btn );
     	}
     }
-    return isSelected;
+    return InputRecorder::GetInstance()->Button( function, isSelected );
 }
 
 
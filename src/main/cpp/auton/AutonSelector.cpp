@@ -28,6 +28,7 @@
 
 //Team302 includes
 #include <auton/AutonSelector.h>
+#include <utils/InputRecorder.h>
 
 
 using namespace std;
@@ -53,7 +54,7 @@ AutonSelector::AutonSelector() : m_xmlFiles(),
 //---------------------------------------------------------------------
 std::string AutonSelector::GetSelectedAutoFile()
 {
-	return m_chooser.GetSelected();
+	return InputRecorder::GetInstance()->AutonSelection(m_chooser.GetSelected());
 }
 
 //---------------------------------------------------------------------
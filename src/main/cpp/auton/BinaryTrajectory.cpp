@@ -0,0 +1,174 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
+#include <frc/trajectory/Trajectory.h>
+
+// Team 302 includes
+#include <auton/BinaryTrajectory.h>
+#include <auton/TrajectoryFormat.h>
+
+// Third Party Includes
+
+using namespace std;
+using namespace TrajectoryFormat;
+
+BinaryTrajectory::BinaryTrajectory() : m_data(nullptr),
+                                       m_size(0),
+                                       m_mapped(false),
+                                       m_buffer(),
+                                       m_columns(),
+                                       m_count(0),
+                                       m_source(0),
+                                       m_sourceSize(0)
+{
+}
+
+BinaryTrajectory::~BinaryTrajectory()
+{
+    Close();
+}
+
+bool BinaryTrajectory::Open
+(
+    const string&   path
+)
+{
+    Close();
+
+#ifdef __linux__
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            auto addr = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                m_data = static_cast<const uint8_t*>(addr);
+                m_size = static_cast<size_t>(info.st_size);
+                m_mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    if (!m_mapped)
+    {
+        ifstream file(path, ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        m_buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    Header header;
+    if (m_size < sizeof(header))
+    {
+        Close();
+        return false;
+    }
+    memcpy(&header, m_data, sizeof(header));
+
+    auto columnBytes = static_cast<size_t>(header.count) * sizeof(float);
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.columns != NUM_COLUMNS ||
+        header.count == 0 ||
+        m_size < sizeof(header) + NUM_COLUMNS * columnBytes)
+    {
+        Close();
+        return false;
+    }
+
+    m_count = header.count;
+    m_source = header.source;
+    m_sourceSize = header.sourceSize;
+    for (auto inx=0; inx<NUM_COLUMNS; ++inx)
+    {
+        m_columns[inx] = reinterpret_cast<const float*>(m_data + sizeof(header) + inx * columnBytes);
+    }
+    return true;
+}
+
+void BinaryTrajectory::Close()
+{
+#ifdef __linux__
+    if (m_mapped)
+    {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_count = 0;
+    m_source = 0;
+    m_sourceSize = 0;
+    for (auto inx=0; inx<NUM_COLUMNS; ++inx)
+    {
+        m_columns[inx] = nullptr;
+    }
+}
+
+frc::Trajectory::State BinaryTrajectory::GetState
+(
+    size_t      index
+) const
+{
+    frc::Trajectory::State state;
+    state.t = units::second_t(Get(TIME, index));
+    state.velocity = units::meters_per_second_t(Get(VELOCITY, index));
+    state.acceleration = units::meters_per_second_squared_t(Get(ACCELERATION, index));
+    state.pose = frc::Pose2d(units::meter_t(Get(X, index)), 
+                             units::meter_t(Get(Y, index)), 
+                             frc::Rotation2d(units::radian_t(Get(HEADING, index))));
+    state.curvature = units::curvature_t(Get(CURVATURE, index));
+    return state;
+}
+
+frc::Trajectory BinaryTrajectory::ToTrajectory() const
+{
+    vector<frc::Trajectory::State> states;
+    states.reserve(m_count);
+    for (size_t inx=0; inx<m_count; ++inx)
+    {
+        states.emplace_back(GetState(inx));
+    }
+    return frc::Trajectory(states);
+}
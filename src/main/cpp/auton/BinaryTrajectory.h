@@ -0,0 +1,87 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/trajectory/Trajectory.h>
+
+// Team 302 includes
+#include <auton/TrajectoryFormat.h>
+
+// Third Party Includes
+
+
+/// @brief Read only view of a binary trajectory file (see TrajectoryFormat.h).  On the roboRIO the file
+///        is memory mapped, so opening it costs no parsing and no allocation per state.
+class BinaryTrajectory
+{
+    public:
+        BinaryTrajectory();
+        ~BinaryTrajectory();
+
+        BinaryTrajectory(const BinaryTrajectory&) = delete;
+        BinaryTrajectory& operator=(const BinaryTrajectory&) = delete;
+
+        /// @brief map the file and validate its header
+        /// @param [in] const std::string&  path - full path of the .traj file
+        /// @return bool - true if the file is a trajectory file this code understands
+        bool Open
+        (
+            const std::string&  path
+        );
+
+        size_t Size() const { return m_count; }
+
+        /// @brief TrajectoryFormat::HashSource of the json this file was converted from
+        uint64_t Source() const { return m_source; }
+
+        /// @brief length in bytes of the json this file was converted from
+        uint64_t SourceSize() const { return m_sourceSize; }
+
+        /// @brief value of one column of one state
+        float Get
+        (
+            TrajectoryFormat::COLUMN    column,
+            size_t                      index
+        ) const { return m_columns[column][index]; }
+
+        frc::Trajectory::State GetState
+        (
+            size_t      index
+        ) const;
+
+        /// @brief copy the states into a WPILib trajectory (what the drive controllers consume)
+        frc::Trajectory ToTrajectory() const;
+
+    private:
+        void Close();
+
+        const uint8_t*          m_data;
+        size_t                  m_size;
+        bool                    m_mapped;
+        std::vector<uint8_t>    m_buffer;       // file contents when the file couldn't be mapped
+        const float*            m_columns[TrajectoryFormat::NUM_COLUMNS];
+        size_t                  m_count;
+        uint64_t                m_source;
+        uint64_t                m_sourceSize;
+};
@@ -15,6 +15,8 @@
 //====================================================================================================================================================
 
 // C++ Includes
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -29,6 +31,7 @@
 #include <auton/PrimitiveFactory.h>
 #include <auton/PrimitiveParams.h>
 #include <auton/PrimitiveParser.h>
+#include <auton/TrajectoryCache.h>
 #include <auton/drivePrimitives/IPrimitive.h>
 #include <mechanisms/MechanismFactory.h>
 #include <utils/Logger.h>
@@ -50,7 +53,11 @@ CyclePrimitives::CyclePrimitives() : m_primParams(),
 									 m_autonSelector( new AutonSelector()) ,
 									 m_timer( make_unique<Timer>()),
 									 m_maxTime( 0.0 ),
-									 m_isDone( false )
+									 m_isDone( false ),
+									 m_preloadedFile(),
+									 m_preloadedParams(),
+									 m_loadingFile(),
+									 m_loading()
 {
 }
 
@@ -59,7 +66,28 @@ void CyclePrimitives::Init()
 	m_currentPrimSlot = 0; //Reset current prim
 	m_primParams.clear();
 
-	m_primParams = PrimitiveParser::ParseXML( m_autonSelector->GetSelectedAutoFile() );
+	auto autonFile = m_autonSelector->GetSelectedAutoFile();
+	if (m_loading.valid())
+	{
+		// a preload is still running; it is usually for this selection, so finishing it beats starting over
+		DeletePlan(m_preloadedParams);
+		m_preloadedParams = m_loading.get();
+		m_preloadedFile = m_loadingFile;
+	}
+
+	if (!m_preloadedFile.empty() && m_preloadedFile == autonFile)
+	{
+		m_primParams = m_preloadedParams;
+		m_preloadedParams.clear();
+	}
+	else
+	{
+		Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("CyclePrimitives"), string("auton not preloaded"), autonFile);
+		DeletePlan(m_preloadedParams);
+		m_primParams = PrimitiveParser::ParseXML( autonFile );
+	}
+	m_preloadedFile.clear();	// the plan is consumed, so it gets preloaded again the next time we are disabled
+
 	if (!m_primParams.empty())
 	{
 		GetNextPrim();
@@ -87,6 +115,66 @@ void CyclePrimitives::Run()
 	}
 }
 
+void CyclePrimitives::Preload()
+{
+	if (m_loading.valid())
+	{
+		if (m_loading.wait_for(chrono::seconds(0)) != future_status::ready)
+		{
+			return;
+		}
+
+		DeletePlan(m_preloadedParams);
+		m_preloadedParams = m_loading.get();
+		m_preloadedFile = m_loadingFile;
+
+		// construct the primitives here, on the robot thread, rather than in the first auton loop
+		for (auto param : m_preloadedParams)
+		{
+			m_primFactory->GetIPrimitive(param);
+		}
+		LOG_DATA(LOGGER_LEVEL::PRINT, string("CyclePrimitives"), string("auton preloaded"), m_preloadedFile);
+	}
+
+	auto autonFile = m_autonSelector->GetSelectedAutoFile();
+	if (!autonFile.empty() && autonFile != m_preloadedFile)
+	{
+		m_loadingFile = autonFile;
+		m_loading = async(launch::async, &CyclePrimitives::LoadPlan, autonFile);
+	}
+}
+
+/// @brief Parse the auton file and look up every path it drives, which both checks that the path
+///        exists and makes sure TrajectoryCache has it loaded (runs off the robot thread)
+PrimitiveParamsVector CyclePrimitives::LoadPlan
+(
+	string	autonFile
+)
+{
+	auto plan = PrimitiveParser::ParseXML( autonFile );
+	for (auto param : plan)
+	{
+		if (param->GetID() == DRIVE_PATH &&
+			TrajectoryCache::GetInstance()->GetTrajectory(param->GetPathName()).get() == nullptr)
+		{
+			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR, string("CyclePrimitives"), autonFile + string(" missing path"), param->GetPathName());
+		}
+	}
+	return plan;
+}
+
+void CyclePrimitives::DeletePlan
+(
+	PrimitiveParamsVector&	plan
+)
+{
+	for (auto param : plan)
+	{
+		delete param;
+	}
+	plan.clear();
+}
+
 void CyclePrimitives::Exit()
 {
 	
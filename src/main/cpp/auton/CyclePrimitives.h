@@ -17,13 +17,16 @@
 #pragma once
 
 // C++ Includes
+#include <future>
 #include <memory>
+#include <string>
 #include <vector>
 
 // FRC includes
 #include <frc/Timer.h>
 
 // Team 302 includes
+#include <auton/PrimitiveParams.h>
 #include <mechanisms/base/IState.h>
 
 // Third Party Includes
@@ -31,7 +34,6 @@
 class AutonSelector;
 class IPrimitive;
 class PrimitiveFactory;
-class PrimitiveParams;
 
 class LeftIntakeStateMgr;
 class RightIntakeStateMgr;
@@ -51,12 +53,19 @@ class CyclePrimitives : public IState
 		void Exit() override;
 	 	bool AtTarget() const override;
 
+		/// @brief Called while disabled: when the auton selection changes, parse and validate the
+		///        new plan in the background so Init only has to swap it in
+		void Preload();
+
 
 	protected:
 		void GetNextPrim();
 		void RunDriveStop();
 
 	private:
+		static PrimitiveParamsVector LoadPlan(std::string autonFile);
+		void DeletePlan(PrimitiveParamsVector& plan);
+
 		std::vector<PrimitiveParams*> 	m_primParams;
 		int 							m_currentPrimSlot;
 		IPrimitive*						m_currentPrim;
@@ -66,5 +75,9 @@ class CyclePrimitives : public IState
 		std::unique_ptr<frc::Timer>     m_timer;
 		double                          m_maxTime;
 		bool							m_isDone;
+		std::string						m_preloadedFile;
+		PrimitiveParamsVector			m_preloadedParams;
+		std::string						m_loadingFile;
+		std::future<PrimitiveParamsVector>	m_loading;		// background parse of m_loadingFile
 };
 
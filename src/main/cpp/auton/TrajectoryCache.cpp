@@ -0,0 +1,276 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#endif
+
+// FRC includes
+#include <frc/Filesystem.h>
+#include <frc/trajectory/TrajectoryUtil.h>
+#include <wpi/fs.h>
+
+// Team 302 includes
+#include <auton/BinaryTrajectory.h>
+#include <auton/TrajectoryCache.h>
+#include <auton/TrajectoryFormat.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+TrajectoryCache* TrajectoryCache::m_instance = nullptr;
+TrajectoryCache* TrajectoryCache::GetInstance()
+{
+    if ( TrajectoryCache::m_instance == nullptr )
+    {
+        TrajectoryCache::m_instance = new TrajectoryCache();
+    }
+    return TrajectoryCache::m_instance;
+}
+
+TrajectoryCache::TrajectoryCache() : m_trajectories(),
+                                     m_mutex(),
+                                     m_loaderMutex(),
+                                     m_loader(),
+                                     m_started(false),
+                                     m_loaded(false)
+{
+}
+
+TrajectoryCache::~TrajectoryCache()
+{
+    WaitForLoad();
+}
+
+void TrajectoryCache::StartLoading()
+{
+    lock_guard<mutex> lock(m_loaderMutex);
+    if (!m_started)
+    {
+        m_started = true;
+        m_loader = thread(&TrajectoryCache::LoadAll, this);
+    }
+}
+
+void TrajectoryCache::WaitForLoad()
+{
+    lock_guard<mutex> lock(m_loaderMutex);
+    if (m_loader.joinable())
+    {
+        m_loader.join();
+    }
+}
+
+shared_ptr<const frc::Trajectory> TrajectoryCache::GetTrajectory
+(
+    const string&   name
+)
+{
+    if (name.empty())
+    {
+        return nullptr;
+    }
+
+    if (!IsLoaded())
+    {
+        // only happens if a path is requested before the startup load finished (or was never started)
+        StartLoading();
+        WaitForLoad();
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto itr = m_trajectories.find(name);
+        if (itr != m_trajectories.end())
+        {
+            return itr->second;
+        }
+    }
+
+    // not in the deploy directory at startup, so parse it now (slow, but no worse than before)
+    auto deployDir = frc::filesystem::GetDeployDirectory();
+    auto directory = deployDir + "/paths/";
+    if (!fs::exists(directory + name))
+    {
+        directory = deployDir + "/pathplanner/generatedJSON/";
+    }
+    auto trajectory = LoadFile(directory, name);
+
+    if (trajectory.get() != nullptr)
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("TrajectoryCache"), string("not preloaded"), name);
+        lock_guard<mutex> lock(m_mutex);
+        m_trajectories.emplace(name, trajectory);
+    }
+    return trajectory;
+}
+
+void TrajectoryCache::LoadAll()
+{
+    auto deployDir = frc::filesystem::GetDeployDirectory();
+
+    // paths are loaded first so they win over pathplanner files with the same name
+    LoadDirectory(deployDir + "/paths/");
+    LoadDirectory(deployDir + "/pathplanner/generatedJSON/");
+
+    size_t count = 0;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        count = m_trajectories.size();
+    }
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("TrajectoryCache"), string("trajectories loaded"), to_string(count));
+
+    m_loaded.store(true, memory_order_release);
+}
+
+void TrajectoryCache::LoadDirectory
+(
+    const string&   directory
+)
+{
+#ifdef __linux__
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    while (true)
+    {
+        auto entry = readdir(dir);
+        if (entry == nullptr)
+        {
+            break;
+        }
+
+        string name(entry->d_name);
+        const string ext(".json");
+        if (name.size() <= ext.size() || name.compare(name.size()-ext.size(), ext.size(), ext) != 0)
+        {
+            continue;
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (m_trajectories.find(name) != m_trajectories.end())
+            {
+                Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("TrajectoryCache"), string("duplicate path ignored"), directory + name);
+                continue;
+            }
+        }
+
+        auto trajectory = LoadFile(directory, name);
+        if (trajectory.get() != nullptr)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_trajectories.emplace(name, trajectory);
+        }
+    }
+    closedir(dir);
+#endif
+}
+
+shared_ptr<const frc::Trajectory> TrajectoryCache::LoadFile
+(
+    const string&   directory,
+    const string&   name
+)
+{
+    // prefer the binary version written by the TrajectoryConverter tool; it needs no parsing, but
+    // only if it was converted from the json that is deployed now
+    auto jsonPath = directory + name;
+    auto binaryPath = directory + TrajectoryFormat::BinaryName(name);
+    if (fs::exists(binaryPath))
+    {
+        BinaryTrajectory binary;
+        if (binary.Open(binaryPath))
+        {
+            if (IsCurrent(binary, jsonPath, binaryPath))
+            {
+                return make_shared<const frc::Trajectory>(binary.ToTrajectory());
+            }
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("TrajectoryCache"), string("stale binary trajectory"), binaryPath);
+        }
+        else
+        {
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("TrajectoryCache"), string("bad binary trajectory"), binaryPath);
+        }
+    }
+
+    // FromPathweaverJson throws on a missing or malformed file; that can't be allowed to escape
+    // the loader thread
+    try
+    {
+        return make_shared<const frc::Trajectory>(frc::TrajectoryUtil::FromPathweaverJson(jsonPath));
+    }
+    catch (const exception& e)
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("TrajectoryCache"), jsonPath, string(e.what()));
+    }
+    return nullptr;
+}
+
+bool TrajectoryCache::IsCurrent
+(
+    const BinaryTrajectory& binary,
+    const string&           jsonPath,
+    const string&           binaryPath
+)
+{
+    // a different length means the path was edited, no need to read the json
+    error_code error;
+    auto jsonSize = fs::file_size(jsonPath, error);
+    if (error || jsonSize != binary.SourceSize())
+    {
+        return false;
+    }
+
+    // once the hash has matched, the .traj is given the json's modification time; matching times mean
+    // neither file has been deployed again since, so the json doesn't have to be read every boot
+    auto jsonTime = fs::last_write_time(jsonPath, error);
+    auto hasTime = !error;
+    if (hasTime)
+    {
+        auto binaryTime = fs::last_write_time(binaryPath, error);
+        if (!error && binaryTime == jsonTime)
+        {
+            return true;
+        }
+    }
+
+    ifstream file(jsonPath, ios::binary);
+    string json((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    if (binary.Source() != TrajectoryFormat::HashSource(json.data(), json.size()))
+    {
+        return false;
+    }
+    if (hasTime)
+    {
+        fs::last_write_time(binaryPath, jsonTime, error);
+    }
+    return true;
+}
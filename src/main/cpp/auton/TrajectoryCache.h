@@ -0,0 +1,100 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// FRC includes
+#include <frc/trajectory/Trajectory.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+class BinaryTrajectory;
+
+/// @brief Parses every pathweaver / pathplanner json file in the deploy directory once and hands
+///        out shared, immutable trajectories by name, so drive primitives never touch the file system
+///        while autonomous is running.  When a binary version of a json file (see TrajectoryFormat.h)
+///        was deployed next to it, the binary one is loaded instead.
+class TrajectoryCache
+{
+    public:
+        static TrajectoryCache* GetInstance();
+
+        /// @brief Start parsing deploy/paths and deploy/pathplanner/generatedJSON on a background
+        ///        thread.  Calling it again after the load started does nothing.
+        void StartLoading();
+
+        /// @brief Block until the background load is finished
+        void WaitForLoad();
+
+        /// @brief true once every file found at startup has been parsed
+        bool IsLoaded() const { return m_loaded.load(std::memory_order_acquire); }
+
+        /// @brief Get the trajectory for a json file name (e.g. "fiveBallRight4.wpilib.json").  If the
+        ///        file wasn't found at startup it is parsed now and added to the cache.
+        /// @param [in] const std::string&  name - json file name
+        /// @return std::shared_ptr<const frc::Trajectory> - trajectory or nullptr if it can't be loaded
+        std::shared_ptr<const frc::Trajectory> GetTrajectory
+        (
+            const std::string&  name
+        );
+
+    private:
+        TrajectoryCache();
+        ~TrajectoryCache();
+
+        void LoadAll();
+        void LoadDirectory
+        (
+            const std::string&  directory
+        );
+        std::shared_ptr<const frc::Trajectory> LoadFile
+        (
+            const std::string&  directory,
+            const std::string&  name
+        );
+
+        /// @brief check that a .traj was converted from the json that is deployed now.  The json length is
+        ///        compared first and the hash is only computed the first boot after a deploy.
+        /// @param [in] const BinaryTrajectory& binary - the opened .traj file
+        /// @param [in] const std::string&  jsonPath - full path of the json
+        /// @param [in] const std::string&  binaryPath - full path of the .traj
+        /// @return bool - true if the binary can be used
+        bool IsCurrent
+        (
+            const BinaryTrajectory& binary,
+            const std::string&      jsonPath,
+            const std::string&      binaryPath
+        );
+
+        static TrajectoryCache*     m_instance;
+
+        std::unordered_map<std::string, std::shared_ptr<const frc::Trajectory>>   m_trajectories;
+        std::mutex                  m_mutex;            // guards m_trajectories
+        std::mutex                  m_loaderMutex;      // guards starting / joining m_loader
+        std::thread                 m_loader;
+        bool                        m_started;
+        std::atomic<bool>           m_loaded;
+};
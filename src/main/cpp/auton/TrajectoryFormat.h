@@ -0,0 +1,94 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief Layout of the binary trajectory files (*.traj) written by the TrajectoryConverter desktop tool 
+///        from PathWeaver / PathPlanner json.  This header has no WPILib dependencies.
+///
+///   file      := header column[NUM_COLUMNS]
+///   header    := MAGIC[8] version:u16 columns:u16 count:u32 source:u64 sourceSize:u64
+///   column    := count little endian float32 values
+///
+/// The columns are stored one after the other in COLUMN order, so the file can be mapped and each 
+/// column read in place.  The header is 32 bytes, which keeps the floats 4 byte aligned.  source is
+/// the HashSource and sourceSize the length of the json the file was converted from, so a .traj left 
+/// behind after the path was edited is detected and the json is used instead.
+namespace TrajectoryFormat
+{
+    constexpr char      MAGIC[8] = { 'T', '3', '0', '2', 'T', 'R', 'J', '\0' };
+    constexpr uint16_t  VERSION = 3;
+
+    /// @enum COLUMN
+    enum COLUMN : uint16_t
+    {
+        TIME,           ///< seconds
+        X,              ///< meters
+        Y,              ///< meters
+        HEADING,        ///< radians
+        VELOCITY,       ///< meters per second
+        ACCELERATION,   ///< meters per second squared
+        CURVATURE,      ///< radians per meter
+        NUM_COLUMNS
+    };
+
+    struct Header
+    {
+        char        magic[8];
+        uint16_t    version;
+        uint16_t    columns;
+        uint32_t    count;
+        uint64_t    source;
+        uint64_t    sourceSize;
+    };
+    static_assert( sizeof( Header ) == 32, "trajectory header must stay 32 bytes" );
+
+    /// @brief 64 bit FNV-1a hash of the json text a binary file was converted from
+    inline uint64_t HashSource
+    (
+        const char*     data,
+        size_t          size
+    )
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for ( size_t inx=0; inx<size; ++inx )
+        {
+            hash ^= static_cast<uint8_t>( data[inx] );
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /// @brief binary file name for a json file name (e.g. "fiveBallRight4.wpilib.json" -> "fiveBallRight4.wpilib.traj")
+    inline std::string BinaryName
+    (
+        const std::string&  jsonName
+    )
+    {
+        const std::string ext( ".json" );
+        auto base = jsonName;
+        if ( base.size() > ext.size() && base.compare( base.size()-ext.size(), ext.size(), ext ) == 0 )
+        {
+            base.erase( base.size()-ext.size() );
+        }
+        return base + ".traj";
+    }
+}
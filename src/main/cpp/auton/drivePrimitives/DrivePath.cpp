@@ -25,8 +25,10 @@
 #include <wpi/fs.h>
 
 // 302 Includes
+#include <auton/TrajectoryCache.h>
 #include <auton/drivePrimitives/DrivePath.h>
 #include <chassis/ChassisFactory.h>
+#include <chassis/swerve/SwerveChassis.h>
 #include <utils/Logger.h>
 
 
@@ -38,7 +40,8 @@ using namespace wpi::math;
 DrivePath::DrivePath() : m_chassis(ChassisFactory::GetChassisFactory()->GetIChassis()),
                          m_timer(make_unique<Timer>()),
                          m_currentChassisPosition(m_chassis.get()->GetPose()),
-                         m_trajectory(),
+                         m_trajectory(nullptr),
+                         m_sampler(),
                          m_runHoloController(true),
                          m_ramseteController(),
                          m_holoController(frc2::PIDController{1.5, 0, 0},
@@ -52,7 +55,6 @@ DrivePath::DrivePath() : m_chassis(ChassisFactory::GetChassisFactory()->GetIChas
                          m_targetPose(),
                          m_deltaX(0.0),
                          m_deltaY(0.0),
-                         m_trajectoryStates(),
                          m_desiredState(),
                          m_headingOption(IChassis::HEADING_OPTION::MAINTAIN),
                          m_heading(0.0),
@@ -60,7 +62,6 @@ DrivePath::DrivePath() : m_chassis(ChassisFactory::GetChassisFactory()->GetIChas
                          m_ntName("DrivePath")
 
 {
-    m_trajectoryStates.clear();
 }
 void DrivePath::Init(PrimitiveParams *params)
 {
@@ -70,40 +71,47 @@ void DrivePath::Init(PrimitiveParams *params)
     m_heading = params->GetHeading();
     m_maxTime = params->GetTime();
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), string(m_pathname));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), string(m_pathname));
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), string(m_pathname));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), string(m_pathname));
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Initialized", "False");
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Running", "False");
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Done", "False");
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "WhyDone", "Not done");
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Times Ran", 0);
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Initialized", "False");
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Running", "False");
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Done", "False");
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "WhyDone", "Not done");
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Times Ran", 0);
 
-    m_trajectoryStates.clear(); //Clears the primitive of previous path/trajectory
+    m_trajectory.reset(); //Clears the primitive of previous path/trajectory
 
     m_wasMoving = false;
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Initialized", "True"); //Signals that drive path is initialized in the console
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Initialized", "True"); //Signals that drive path is initialized in the console
 
-    GetTrajectory(params->GetPathName());  //Parses path from json file based on path name given in xml
+    GetTrajectory(params->GetPathName());  //Looks up the preloaded path based on path name given in xml
     
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Trajectory Time", m_trajectory.TotalTime().to<double>());// Debugging
-
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), to_string(m_trajectoryStates.size()));
-    
-    if (!m_trajectoryStates.empty()) // only go if path name found
+    if (HasStates()) // only go if path name found
     {
-        m_desiredState = m_trajectoryStates.front(); //m_desiredState is the first state, or starting position
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Trajectory Time", m_trajectory->TotalTime().to<double>());// Debugging
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePathInit"), to_string(m_trajectory->States().size()));
+
+        m_desiredState = m_trajectory->States().front(); //m_desiredState is the first state, or starting position
+
+        // aim at where the path will be when the command reaches the modules
+        m_sampler.Reset(m_trajectory);
+        auto factory = ChassisFactory::GetChassisFactory();
+        if (m_chassis.get()->GetType() == IChassis::CHASSIS_TYPE::SWERVE && factory->GetSwerveChassis() != nullptr)
+        {
+            m_sampler.SetLookAhead(factory->GetSwerveChassis()->GetActuationLatency());
+        }
 
         m_timer.get()->Reset(); //Restarts and starts timer
         m_timer.get()->Start();
 
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosX", m_currentChassisPosition.X().to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosY", m_currentChassisPosition.Y().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosX", m_currentChassisPosition.X().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosY", m_currentChassisPosition.Y().to<double>());
 
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", "0");
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", "0");
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", "0");
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", "0");
 
         //A timer used for position change detection
         m_PosChgTimer.get()->Reset(); 
@@ -116,7 +124,7 @@ void DrivePath::Init(PrimitiveParams *params)
 
         //Sampling means to grab a state based on the time, if we want to know what state we should be running at 5 seconds,
         //we will sample the 5 second state.
-        auto targetState = m_trajectory.Sample(m_trajectory.TotalTime());  //"Samples" or grabs the position we should be at based on time
+        auto targetState = m_trajectory->Sample(m_trajectory->TotalTime());  //"Samples" or grabs the position we should be at based on time
 
         m_targetPose = targetState.pose;  //Target pose represents the pose that we want to be at, based on the target state from above
 
@@ -132,14 +140,14 @@ void DrivePath::Init(PrimitiveParams *params)
 }
 void DrivePath::Run()
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Running", "True");
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Running", "True");
 
-    if (!m_trajectoryStates.empty()) //If we have a path parsed / have states to run
+    if (HasStates()) //If we have a path parsed / have states to run
     {
         // debugging
         m_timesRun++;
         
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Times Ran", m_timesRun);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Times Ran", m_timesRun);
 
         // calculate where we are and where we want to be
         CalcCurrentAndDesiredStates();
@@ -181,12 +189,12 @@ void DrivePath::Run()
                     rotation = m_desiredState.pose.Rotation();
                     break;
             }
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose x", m_currentChassisPosition.X().to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose y", m_currentChassisPosition.Y().to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose omega", m_currentChassisPosition.Rotation().Degrees().to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose x", m_desiredState.pose.X().to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose y", m_desiredState.pose.Y().to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose omega", m_desiredState.pose.Rotation().Degrees().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose x", m_currentChassisPosition.X().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose y", m_currentChassisPosition.Y().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: current pose omega", m_currentChassisPosition.Rotation().Degrees().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose x", m_desiredState.pose.X().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose y", m_desiredState.pose.Y().to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: desired pose omega", m_desiredState.pose.Rotation().Degrees().to<double>());
             refChassisSpeeds = m_holoController.Calculate(m_currentChassisPosition, 
                                                           m_desiredState, 
                                                           m_desiredState.pose.Rotation());
@@ -197,9 +205,9 @@ void DrivePath::Run()
                                                              m_desiredState);
         }
         // debugging
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsX", refChassisSpeeds.vx());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsY", refChassisSpeeds.vy());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsZ", units::degrees_per_second_t(refChassisSpeeds.omega()).to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsX", refChassisSpeeds.vx());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsY", refChassisSpeeds.vy());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: ChassisSpeedsZ", units::degrees_per_second_t(refChassisSpeeds.omega()).to<double>());
 
         m_chassis->Drive(refChassisSpeeds,
                          IChassis::CHASSIS_DRIVE_MODE::ROBOT_ORIENTED,
@@ -224,7 +232,7 @@ bool DrivePath::IsDone() //Default primitive function to determine if the primit
     bool isDone = false;
     string whyDone = ""; //debugging variable that we used to determine why the path was stopping
     
-    if (!m_trajectoryStates.empty()) //If we have states... 
+    if (HasStates()) //If we have states... 
     {
         auto curPos = m_chassis.get()->GetPose();
         // allow a time out to be put into the xml
@@ -284,18 +292,25 @@ bool DrivePath::IsDone() //Default primitive function to determine if the primit
         // a new state.
         if (!isDone)
         {
-            //return (units::second_t(m_timer.get()->Get()) >= m_trajectory.TotalTime()); 
+            //return (units::second_t(m_timer.get()->Get()) >= m_trajectory->TotalTime()); 
         }
     }
     else
     {
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Done", "True");
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Done", "True");
         return true;
     }
     if (isDone)
     {   //debugging
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "Done", "True");
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "WhyDone", whyDone);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Done", "True");
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "WhyDone", whyDone);
+
+        auto stats = m_sampler.GetTrackingStats();
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Tracking: samples", static_cast<int>(stats.samples));
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Tracking: RMS error (m)", stats.rmsError.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Tracking: max error (m)", stats.maxError.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Tracking: final error (m)", stats.finalError.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "Tracking: max heading error (deg)", stats.maxHeadingError.to<double>());
     }
     return isDone;
     
@@ -312,8 +327,8 @@ bool DrivePath::IsSamePose(frc::Pose2d lCurPos, frc::Pose2d lPrevPos, double tol
     double dDeltaX = abs(dPrevPosX - dCurPosX);
     double dDeltaY = abs(dPrevPosY - dCurPosY);
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", to_string(dDeltaX));
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaY", to_string(dDeltaY));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaX", to_string(dDeltaX));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: iDeltaY", to_string(dDeltaY));
 
     //  If Position of X or Y has moved since last scan..  Using Delta X/Y
     return (dDeltaX <= tolerance && dDeltaY <= tolerance);
@@ -324,27 +339,13 @@ void DrivePath::GetTrajectory //Parses pathweaver json to create a series of poi
     string  path
 )
 {
-    if (!path.empty()) // only go if path name found
+    // The trajectories are parsed from the deploy directory at startup (see TrajectoryCache), so this
+    // is only a lookup; the trajectory is shared and must not be modified.
+    m_trajectory = TrajectoryCache::GetInstance()->GetTrajectory(path);
+    if (HasStates())
     {
-        // Read path into trajectory for deploy directory.  JSON File ex. Bounce1.wpilid.json
-        //wpi::SmallString<64> deployDir;  //creates a string variable
-        //frc::filesystem::GetDeployDirectory(deployDir);  //grabs the deploy directory: "/lvuser/deploy" on roborio
-        //wpi::sys::path::append(deployDir, "paths");  //goes into "/lvuser/deploy/paths" on roborio
-        //wpi::sys::path::append(deployDir, path); // load path from deploy directory
-    	auto deployDir = frc::filesystem::GetDeployDirectory();
-        deployDir += "/paths/" + path;
-
-        m_trajectory = frc::TrajectoryUtil::FromPathweaverJson(deployDir);
-
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, string("Deploy path is "), deployDir.c_str()); //Debugging
-        
-        //This doesn't work, gives parsing error
-        m_trajectory = frc::TrajectoryUtil::FromPathweaverJson(deployDir);  //Creates a trajectory or path that can be used in the code, parsed from pathweaver json
-        //m_trajectory = frc::TrajectoryUtil::FromPathweaverJson("/home/lvuser/deploy/paths/5Ball1.wpilib.json"); //This is a temporary fix
-        m_trajectoryStates = m_trajectory.States();  //Creates a vector of all the states or "waypoints" the robot needs to get to
-        
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePath - Loaded = "), path);
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: TrajectoryTotalTime", m_trajectory.TotalTime().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, string("DrivePath - Loaded = "), path);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: TrajectoryTotalTime", m_trajectory->TotalTime().to<double>());
     }
 
 }
@@ -354,17 +355,16 @@ void DrivePath::CalcCurrentAndDesiredStates()
     m_currentChassisPosition = m_chassis.get()->GetPose(); //Grabs current pose / position
     auto sampleTime = units::time::second_t(m_timer.get()->Get()); //+ 0.02  //Grabs the time that we should sample a state from
 
-    m_desiredState = m_trajectory.Sample(sampleTime); //Gets the target state based on the current time
-
-    // May need to do our own sampling based on position and time     
-
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseX", m_desiredState.pose.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseY", m_desiredState.pose.Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseOmega", m_desiredState.pose.Rotation().Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosX", m_currentChassisPosition.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosY", m_currentChassisPosition.Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosOmega", m_currentChassisPosition.Rotation().Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DeltaX", m_desiredState.pose.X().to<double>() - m_currentChassisPosition.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DeltaY", m_desiredState.pose.Y().to<double>() - m_currentChassisPosition.Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentTime", m_timer.get()->Get().to<double>());
+    m_desiredState = m_sampler.Sample(sampleTime); //Gets the target state based on the current time (plus the actuation latency)
+    m_sampler.RecordTracking(sampleTime, m_currentChassisPosition);
+
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseX", m_desiredState.pose.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseY", m_desiredState.pose.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DesiredPoseOmega", m_desiredState.pose.Rotation().Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosX", m_currentChassisPosition.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosY", m_currentChassisPosition.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentPosOmega", m_currentChassisPosition.Rotation().Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DeltaX", m_desiredState.pose.X().to<double>() - m_currentChassisPosition.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: DeltaY", m_desiredState.pose.Y().to<double>() - m_currentChassisPosition.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_ntName, "DrivePathValues: CurrentTime", m_timer.get()->Get().to<double>());
 }
\ No newline at end of file
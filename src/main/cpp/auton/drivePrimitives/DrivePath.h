@@ -20,6 +20,7 @@
 //Team302 Includes
 #include <auton/PrimitiveParams.h>
 #include <auton/drivePrimitives/IPrimitive.h>
+#include <auton/drivePrimitives/TrajectorySampler.h>
 #include <chassis/ChassisFactory.h>
 #include <chassis/DragonTargetFinder.h>
 #include <chassis/IChassis.h>
@@ -57,6 +58,7 @@ public:
 private:
     bool IsSamePose(frc::Pose2d, frc::Pose2d, double tolerance); // routine to check for motion
     void GetTrajectory(std::string  path);
+    bool HasStates() const { return m_trajectory.get() != nullptr && !m_trajectory->States().empty(); }
     void CalcCurrentAndDesiredStates();
 
 
@@ -65,7 +67,8 @@ private:
     std::unique_ptr<frc::Timer>             m_timer;
 
     frc::Pose2d                             m_currentChassisPosition;
-    frc::Trajectory                         m_trajectory;
+    std::shared_ptr<const frc::Trajectory>  m_trajectory;               // shared with TrajectoryCache, never modified
+    TrajectorySampler                       m_sampler;
     bool                                    m_runHoloController;
     bool                                    m_wasMoving;
     frc::RamseteController                  m_ramseteController;
@@ -77,7 +80,6 @@ private:
     std::string                             m_pathname;
     double                                  m_deltaX;
     double                                  m_deltaY;
-    std::vector<frc::Trajectory::State>     m_trajectoryStates;
     frc::Trajectory::State                  m_desiredState;
     IChassis::HEADING_OPTION                m_headingOption;
     double                                  m_heading;
@@ -31,6 +31,7 @@
 #include <hw/factories/PigeonFactory.h>
 #include <mechanisms/controllers/ControlData.h>
 #include <mechanisms/controllers/ControlModes.h>
+#include <RobotState.h>
 
 // Third Party Includes
 
@@ -139,7 +140,7 @@ void SuperDrive::Run()
 	auto pigeon = PigeonFactory::GetFactory()->GetPigeon(DragonPigeon::PIGEON_USAGE::CENTER_OF_ROBOT);
 	if ( pigeon != nullptr )
 	{
-		m_currentHeading = pigeon->GetYaw() - m_startHeading;
+		m_currentHeading = RobotStateMgr::GetInstance()->GetYaw().to<double>() - m_startHeading;
 	}
 	//m_currentHeading = m_chassis->GetHeading() - m_chassis->GetTargetHeading(); //Calculate target heading
 
@@ -0,0 +1,142 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cmath>
+#include <memory>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/trajectory/Trajectory.h>
+#include <units/math.h>
+
+// Team 302 includes
+#include <auton/drivePrimitives/TrajectorySampler.h>
+
+// Third Party Includes
+
+using namespace std;
+
+TrajectorySampler::TrajectorySampler() : m_trajectory(nullptr),
+                                         m_cursor(0),
+                                         m_lookAhead(units::time::second_t(0.0)),
+                                         m_samples(0),
+                                         m_sumSquaredError(0.0),
+                                         m_maxError(units::length::meter_t(0.0)),
+                                         m_lastError(units::length::meter_t(0.0)),
+                                         m_maxHeadingError(units::angle::degree_t(0.0))
+{
+}
+
+void TrajectorySampler::Reset
+(
+    shared_ptr<const frc::Trajectory>   trajectory
+)
+{
+    m_trajectory = trajectory;
+    m_cursor = 0;
+    m_samples = 0;
+    m_sumSquaredError = 0.0;
+    m_maxError = units::length::meter_t(0.0);
+    m_lastError = units::length::meter_t(0.0);
+    m_maxHeadingError = units::angle::degree_t(0.0);
+}
+
+frc::Trajectory::State TrajectorySampler::Sample
+(
+    units::time::second_t   time
+)
+{
+    return SampleAt(time + m_lookAhead);
+}
+
+/// @brief Walk the cursor to the state at or before the time and interpolate to the next one.  Time 
+///        normally moves forward a fraction of a state per call; RecordTracking samples slightly behind
+///        Sample, so the cursor also walks back, but only by the look ahead.
+frc::Trajectory::State TrajectorySampler::SampleAt
+(
+    units::time::second_t   time
+)
+{
+    if (m_trajectory.get() == nullptr || m_trajectory->States().empty())
+    {
+        return frc::Trajectory::State();
+    }
+
+    auto& states = m_trajectory->States();
+    if (time <= states.front().t)
+    {
+        m_cursor = 0;
+        return states.front();
+    }
+    if (time >= states.back().t)
+    {
+        m_cursor = states.size() - 1;
+        return states.back();
+    }
+
+    while (m_cursor > 0 && states[m_cursor].t > time)
+    {
+        --m_cursor;
+    }
+    while (m_cursor + 1 < states.size() && states[m_cursor + 1].t <= time)
+    {
+        ++m_cursor;
+    }
+
+    auto& prev = states[m_cursor];
+    auto& next = states[m_cursor + 1];
+    auto span = next.t - prev.t;
+    if (span <= units::time::second_t(0.0))
+    {
+        return next;
+    }
+    // same interpolation frc::Trajectory::Sample uses
+    return prev.Interpolate(next, ((time - prev.t) / span).to<double>());
+}
+
+void TrajectorySampler::RecordTracking
+(
+    units::time::second_t   time,
+    const frc::Pose2d&      actual
+)
+{
+    if (m_trajectory.get() == nullptr || m_trajectory->States().empty())
+    {
+        return;
+    }
+
+    auto desired = SampleAt(time).pose;
+    auto error = desired.Translation().Distance(actual.Translation());
+    auto headingError = units::math::abs((desired.Rotation() - actual.Rotation()).Degrees());
+
+    m_samples++;
+    m_sumSquaredError += error.to<double>() * error.to<double>();
+    m_maxError = units::math::max(m_maxError, error);
+    m_lastError = error;
+    m_maxHeadingError = units::math::max(m_maxHeadingError, headingError);
+}
+
+TrajectorySampler::TrackingStats TrajectorySampler::GetTrackingStats() const
+{
+    TrackingStats stats;
+    stats.samples = m_samples;
+    stats.rmsError = units::length::meter_t(m_samples > 0 ? sqrt(m_sumSquaredError / m_samples) : 0.0);
+    stats.maxError = m_maxError;
+    stats.finalError = m_lastError;
+    stats.maxHeadingError = m_maxHeadingError;
+    return stats;
+}
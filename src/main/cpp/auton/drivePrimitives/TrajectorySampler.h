@@ -0,0 +1,97 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstddef>
+#include <memory>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/trajectory/Trajectory.h>
+#include <units/angle.h>
+#include <units/length.h>
+#include <units/time.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+
+/// @brief Samples a trajectory whose sample time only moves forward.  Instead of binary searching all 
+///        of the states on every call (frc::Trajectory::Sample), it keeps a cursor on the last state 
+///        used and walks it, so a sample is amortized O(1).  It also accumulates how far the robot was 
+///        from the path while it was followed.
+class TrajectorySampler
+{
+    public:
+        struct TrackingStats
+        {
+            size_t                  samples;
+            units::length::meter_t  rmsError;           // position error
+            units::length::meter_t  maxError;
+            units::length::meter_t  finalError;
+            units::angle::degree_t  maxHeadingError;
+        };
+
+        TrajectorySampler();
+        ~TrajectorySampler() = default;
+
+        /// @brief start over on a new trajectory (nullptr clears it)
+        void Reset
+        (
+            std::shared_ptr<const frc::Trajectory>  trajectory
+        );
+
+        /// @brief how far ahead of the requested time to sample, so the controller aims at where the 
+        ///        path will be when the command actually reaches the wheels
+        void SetLookAhead
+        (
+            units::time::second_t   lookAhead
+        ) { m_lookAhead = lookAhead; }
+        units::time::second_t GetLookAhead() const { return m_lookAhead; }
+
+        /// @brief interpolated state at time + look ahead (clamped to the ends of the trajectory)
+        frc::Trajectory::State Sample
+        (
+            units::time::second_t   time
+        );
+
+        /// @brief compare where the robot is with where the path says it should be at this time 
+        ///        (no look ahead)
+        void RecordTracking
+        (
+            units::time::second_t   time,
+            const frc::Pose2d&      actual
+        );
+        TrackingStats GetTrackingStats() const;
+
+    private:
+        frc::Trajectory::State SampleAt
+        (
+            units::time::second_t   time
+        );
+
+        std::shared_ptr<const frc::Trajectory>  m_trajectory;
+        size_t                                  m_cursor;           // index of the state at or before the last sample time
+        units::time::second_t                   m_lookAhead;
+        size_t                                  m_samples;
+        double                                  m_sumSquaredError;  // meters squared
+        units::length::meter_t                  m_maxError;
+        units::length::meter_t                  m_lastError;
+        units::angle::degree_t                  m_maxHeadingError;
+};
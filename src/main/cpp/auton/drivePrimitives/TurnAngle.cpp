@@ -33,6 +33,7 @@
 #include <mechanisms/controllers/ControlModes.h>
 #include <hw/DragonPigeon.h>
 #include <hw/factories/PigeonFactory.h>
+#include <RobotState.h>
 
 // Third Party Includes
 
@@ -87,7 +88,7 @@ void TurnAngle::Run() //best method ever. Does nothing, and should do nothing...
 {
 	if ( m_pigeon != nullptr )
 	{
-		m_heading = m_pigeon->GetYaw();
+		m_heading = RobotStateMgr::GetInstance()->GetYaw().to<double>();
 	}
 
 	bool sign = (m_targetAngle - m_heading) > 0.0;
@@ -105,7 +106,7 @@ bool TurnAngle::IsDone()
 	{
 		if ( m_pigeon != nullptr )
 		{
-			m_heading = m_pigeon->GetYaw();
+			m_heading = RobotStateMgr::GetInstance()->GetYaw().to<double>();
 		}
 		if (abs(m_targetAngle - m_heading) < ANGLE_THRESH) 
 		{
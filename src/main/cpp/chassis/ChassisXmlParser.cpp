@@ -30,7 +30,9 @@
 #include <units/acceleration.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
+#include <units/frequency.h>
 #include <units/length.h>
+#include <units/time.h>
 #include <units/velocity.h>
 
 
@@ -45,6 +47,7 @@
 #include <chassis/ChassisXmlParser.h>
 #include <hw/xml/MotorXmlParser.h>
 #include <chassis/swerve/SwerveModuleXmlParser.h>
+#include <chassis/swerve/SwerveChassis.h>
 
 // Third Party includes
 #include <pugixml/pugixml.hpp>
@@ -73,6 +76,8 @@ IChassis* ChassisXmlParser::ParseXML
     units::length::inch_t wheelBase(0.0);
     units::length::inch_t track(0.0);
     double odometryComplianceCoefficient = 1.0;
+    units::frequency::hertz_t odometryRate(0.0);
+    units::time::millisecond_t actuationLatency(0.0);
     units::velocity::meters_per_second_t maxVelocity(0.0);
     units::radians_per_second_t maxAngularSpeed(0.0);
     units::acceleration::meters_per_second_squared_t maxAcceleration(0.0);
@@ -145,6 +150,14 @@ IChassis* ChassisXmlParser::ParseXML
         {
             odometryComplianceCoefficient = attr.as_double();
         }
+        else if ( attrName.compare("odometryRate") == 0 )
+        {
+            odometryRate = units::frequency::hertz_t(attr.as_double());
+        }
+        else if ( attrName.compare("actuationLatency") == 0 )
+        {
+            actuationLatency = units::time::millisecond_t(attr.as_double());
+        }
         else if (attrName.compare("networkTable") == 0)
         {
             networkTableName = attr.as_string();
@@ -301,6 +314,17 @@ IChassis* ChassisXmlParser::ParseXML
                                               //speedCalcOption,
                                               poseEstOption, 
                                               odometryComplianceCoefficient );
+            if ( chassis != nullptr && 
+                 type == ChassisFactory::CHASSIS_TYPE::SWERVE_CHASSIS && 
+                 odometryRate > units::frequency::hertz_t(0.0) )
+            {
+                factory->GetSwerveChassis()->SetOdometryRate( odometryRate );
+            }
+            if ( chassis != nullptr && 
+                 type == ChassisFactory::CHASSIS_TYPE::SWERVE_CHASSIS )
+            {
+                factory->GetSwerveChassis()->SetActuationLatency( actuationLatency );
+            }
         }
         else  // log errors
         {
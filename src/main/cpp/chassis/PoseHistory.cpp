@@ -0,0 +1,97 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
+#include <frc/geometry/Translation2d.h>
+#include <units/time.h>
+
+// Team 302 includes
+#include <chassis/PoseHistory.h>
+
+// Third Party Includes
+
+using namespace std;
+using namespace frc;
+
+PoseHistory::PoseHistory() : m_poses(),
+                             m_newest(HISTORY_SIZE - 1),
+                             m_count(0)
+{
+}
+
+/// @brief  Record the pose at a time; timestamps must be increasing
+/// @param [in] units::time::second_t   timestamp:  FPGA time of the pose
+/// @param [in] const frc::Pose2d&      pose:       robot pose
+void PoseHistory::Add
+(
+    units::time::second_t   timestamp,
+    const Pose2d&           pose
+)
+{
+    if ( m_count > 0 && timestamp <= Get(0).timestamp )
+    {
+        return;
+    }
+    m_newest = (m_newest + 1) % HISTORY_SIZE;
+    m_poses[m_newest] = {timestamp, pose};
+    if ( m_count < HISTORY_SIZE )
+    {
+        m_count++;
+    }
+}
+
+/// @brief  Interpolate the pose at a past time
+/// @param [in]  units::time::second_t  timestamp:  FPGA time to look up
+/// @param [out] frc::Pose2d&           pose:       pose at that time
+/// @return bool    false if the time is older than the history
+bool PoseHistory::GetPose
+(
+    units::time::second_t   timestamp,
+    Pose2d&                 pose
+) const
+{
+    if ( m_count == 0 || timestamp < Get(m_count-1).timestamp )
+    {
+        return false;
+    }
+
+    if ( timestamp >= Get(0).timestamp )
+    {
+        pose = Get(0).pose;
+        return true;
+    }
+
+    // walk back from the newest entry to the pair that brackets the timestamp
+    for ( int age=1; age<m_count; ++age )
+    {
+        const auto& before = Get(age);
+        if ( before.timestamp <= timestamp )
+        {
+            const auto& after = Get(age-1);
+            double t = ((timestamp - before.timestamp) / (after.timestamp - before.timestamp)).to<double>();
+
+            auto translation = before.pose.Translation() + (after.pose.Translation() - before.pose.Translation()) * t;
+            auto rotation = before.pose.Rotation() + (after.pose.Rotation() - before.pose.Rotation()) * t;
+            pose = Pose2d(translation, rotation);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,75 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+
+// FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <units/time.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+/// @class PoseHistory
+/// @brief Fixed size ring of timestamped poses so latent measurements (e.g. vision frames) can be
+///        compared against where the robot was when they were captured.
+class PoseHistory
+{
+    public:
+        PoseHistory();
+        ~PoseHistory() = default;
+
+        /// @brief  Record the pose at a time; timestamps must be increasing
+        /// @param [in] units::time::second_t   timestamp:  FPGA time of the pose
+        /// @param [in] const frc::Pose2d&      pose:       robot pose
+        void Add
+        (
+            units::time::second_t   timestamp,
+            const frc::Pose2d&      pose
+        );
+
+        /// @brief  Interpolate the pose at a past time
+        /// @param [in]  units::time::second_t  timestamp:  FPGA time to look up
+        /// @param [out] frc::Pose2d&           pose:       pose at that time
+        /// @return bool    false if the time is older than the history
+        bool GetPose
+        (
+            units::time::second_t   timestamp,
+            frc::Pose2d&            pose
+        ) const;
+
+        /// @brief  Forget all of the recorded poses (e.g. after the pose is reset)
+        void Clear() { m_count = 0; }
+
+    private:
+        struct TimedPose
+        {
+            units::time::second_t   timestamp;
+            frc::Pose2d             pose;
+        };
+
+        static constexpr int HISTORY_SIZE = 256;    // 5 s at 50 Hz, 1 s at the 250 Hz odometry thread
+
+        const TimedPose& Get(int age) const { return m_poses[(m_newest + HISTORY_SIZE - age) % HISTORY_SIZE]; }
+
+        std::array<TimedPose, HISTORY_SIZE>     m_poses;
+        int                                     m_newest;
+        int                                     m_count;
+};
@@ -126,17 +126,11 @@ void DifferentialChassis::SetEncodersToZero()
 {
     if (m_leftMotor.get() != nullptr)
     {
-        auto motor = m_leftMotor.get()->GetSpeedController();
-        auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-        auto driveMotorSensors = fx->GetSensorCollection();
-        driveMotorSensors.SetIntegratedSensorPosition(0, 0);
+        m_leftMotor.get()->GetIntegratedSensor()->SetIntegratedSensorPosition(0, 0);
     }
     if (m_rightMotor.get() != nullptr)
     {
-        auto motor = m_rightMotor.get()->GetSpeedController();
-        auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-        auto driveMotorSensors = fx->GetSensorCollection();
-        driveMotorSensors.SetIntegratedSensorPosition(0, 0);
+        m_rightMotor.get()->GetIntegratedSensor()->SetIntegratedSensorPosition(0, 0);
     }
 }
 void DifferentialChassis::SetTargetHeading(units::angle::degree_t targetYaw) 
@@ -17,6 +17,7 @@
 // C++ Includes
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <cmath>
 
 // FRC includes
@@ -31,6 +32,8 @@
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
 #include <units/length.h>
+#include <units/math.h>
+#include <units/time.h>
 #include <units/velocity.h>
 #include <wpi/numbers>
 
@@ -42,6 +45,7 @@
 #include <hw/factories/LimelightFactory.h>
 #include <utils/AngleUtils.h>
 #include <utils/Logger.h>
+#include <RobotState.h>
 
 // Third Party Includes
 #include <ctre/phoenix/sensors/CANCoder.h>
@@ -95,6 +99,10 @@ SwerveChassis::SwerveChassis
     m_runWPI(false),
     m_poseOpt(PoseEstimatorEnum::WPI),
     m_pose(),
+    m_cachedPose(),
+    m_poseCycle(0),
+    m_cachedSpeeds(),
+    m_speedsCycle(0),
     m_offsetPoseAngle(0_deg),  //not used at the moment
     m_timer(),
     m_drive(units::velocity::meters_per_second_t(0.0)),
@@ -107,7 +115,18 @@ SwerveChassis::SwerveChassis
     m_storedYaw(m_pigeon->GetYaw()),
     m_yawCorrection(units::angular_velocity::degrees_per_second_t(0.0)),
     m_targetHeading(units::angle::degree_t(0)),
-    m_limelight(LimelightFactory::GetLimelightFactory()->GetLimelight())
+    m_limelight(LimelightFactory::GetLimelightFactory()->GetLimelight()),
+    m_poseHistory(),
+    m_lastVisionFrame(0),
+    m_lastVisionFusion(0.0),
+    m_visionRejects(0),
+    m_visionRejectOffset(),
+    m_actuationLatency(units::time::second_t(0.0)),
+    m_odometryPeriod(units::time::millisecond_t(0.0)),
+    m_estimatorMutex(),
+    m_latestPose(),
+    m_odometryStepped(false),
+    m_odometryNotifier()
 {
     m_timer.Reset();
     m_timer.Start();
@@ -139,9 +158,9 @@ units::angular_velocity::degrees_per_second_t SwerveChassis::CalcHeadingCorrecti
     auto correction = units::angular_velocity::degrees_per_second_t(errorAngle.to<double>()*kP);
 
     //Debugging
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Current Angle (Degrees): ", currentAngle.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Error Angle (Degrees): ", errorAngle.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Yaw Correction (Degrees Per Second): ", m_yawCorrection.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Current Angle (Degrees): ", currentAngle.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Error Angle (Degrees): ", errorAngle.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, "Swerve Chassis", "Heading: Yaw Correction (Degrees Per Second): ", m_yawCorrection.to<double>());
 
     return correction;
 }
@@ -173,20 +192,20 @@ void SwerveChassis::Drive
 
         case HEADING_OPTION::TOWARD_GOAL:
             AdjustRotToPointTowardGoal(currentPose, rot);
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: rot", rot.to<double>() );
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: rot", rot.to<double>() );
             break;
 
         case HEADING_OPTION::TOWARD_GOAL_DRIVE:
              [[fallthrough]]; // intentional fallthrough 
         case HEADING_OPTION::TOWARD_GOAL_LAUNCHPAD:
             DriveToPointTowardGoal(currentPose,goalPose,xSpeed,ySpeed,rot);
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: rot", rot.to<double>() );
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: rot", rot.to<double>() );
             break;
 
         case HEADING_OPTION::SPECIFIED_ANGLE:
             rot -= CalcHeadingCorrection(m_targetHeading, kPAutonSpecifiedHeading);
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: Specified Angle (Degrees): ", m_targetHeading.to<double>());
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading:Heading Correction", rot.to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading: Specified Angle (Degrees): ", m_targetHeading.to<double>());
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Chassis Heading:Heading Correction", rot.to<double>());
             break;
 
         case HEADING_OPTION::LEFT_INTAKE_TOWARD_BALL:
@@ -201,15 +220,15 @@ void SwerveChassis::Drive
             break;
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("XSpeed"), xSpeed.to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("YSpeed"), ySpeed.to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("ZSpeed"), rot.to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("yaw"), m_pigeon->GetYaw() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("angle error Degrees Per Second"), m_yawCorrection.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("XSpeed"), xSpeed.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("YSpeed"), ySpeed.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("ZSpeed"), rot.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("yaw"), GetYaw().to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("angle error Degrees Per Second"), m_yawCorrection.to<double>());
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current X"), GetPose().X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current Y"), GetPose().Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current Rot(Degrees)"), GetPose().Rotation().Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current X"), currentPose.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current Y"), currentPose.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Current Rot(Degrees)"), currentPose.Rotation().Degrees().to<double>());
     
     if ( (abs(xSpeed.to<double>()) < m_deadband) && 
          (abs(ySpeed.to<double>()) < m_deadband) && 
@@ -231,8 +250,7 @@ void SwerveChassis::Drive
 
         if ( m_runWPI )
         {
-            units::degree_t yaw{m_pigeon->GetYaw()};
-            Rotation2d currentOrientation {yaw};
+            Rotation2d currentOrientation {GetYaw()};
             ChassisSpeeds chassisSpeeds = mode==IChassis::CHASSIS_DRIVE_MODE::FIELD_ORIENTED ? 
                                             ChassisSpeeds::FromFieldRelativeSpeeds(xSpeed, ySpeed, rot, currentOrientation) : 
                                             ChassisSpeeds{xSpeed, ySpeed, rot};
@@ -247,18 +265,15 @@ void SwerveChassis::Drive
             // adjust wheel angles
             if (mode == IChassis::CHASSIS_DRIVE_MODE::POLAR_DRIVE)
             {
-                auto currentPose = GetPose();
-                auto goalPose = m_targetFinder.GetPosCenterTarget();
-
                 fr.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_frontRightLocation, fr.angle), chassisSpeeds);
                 bl.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_backLeftLocation, bl.angle), chassisSpeeds);
                 br.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_backRightLocation, br.angle), chassisSpeeds);
                 fl.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_frontLeftLocation, fl.angle), chassisSpeeds);
 
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Front Left Angle", fl.angle.Degrees().to<double>());
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Front Right Angle", fr.angle.Degrees().to<double>());
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Back Left Angle", bl.angle.Degrees().to<double>());
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Back Right Angle", br.angle.Degrees().to<double>());
+                LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Front Left Angle", fl.angle.Degrees().to<double>());
+                LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Front Right Angle", fr.angle.Degrees().to<double>());
+                LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Back Left Angle", bl.angle.Degrees().to<double>());
+                LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Back Right Angle", br.angle.Degrees().to<double>());
            }
         
             m_frontLeft.get()->SetDesiredState(fl);
@@ -279,9 +294,6 @@ void SwerveChassis::Drive
             // adjust wheel angles
             if (mode == IChassis::CHASSIS_DRIVE_MODE::POLAR_DRIVE)
             {
-                auto currentPose = GetPose();
-                auto goalPose = m_targetFinder.GetPosCenterTarget();
-
                 m_flState.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_frontLeftLocation, m_flState.angle), chassisSpeeds);
                 m_frState.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_frontRightLocation, m_frState.angle), chassisSpeeds);
                 m_blState.angle = UpdateForPolarDrive(currentPose, goalPose, Transform2d(m_backLeftLocation, m_blState.angle), chassisSpeeds);
@@ -306,9 +318,9 @@ void SwerveChassis::Drive
             auto ay = m_accel.GetY();
             auto az = m_accel.GetZ();
 
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelX"), ax);
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelY"), ay);
-            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelZ"), az);
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelX"), ax);
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelY"), ay);
+            LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("AccelZ"), az);
         }
     }    
 }
@@ -351,19 +363,19 @@ units::angle::degree_t SwerveChassis::UpdateForPolarDrive
     units::angle::degree_t thetaDeg = triangleThetaRads; //- robotPose.Rotation().Degrees(); Subtract robot pose to "normalize" wheels, zero for the wheels is the robot angle
 
     //Debugging
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelPoseX (Meters)", WheelPose.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelPoseY (Meters)", WheelPose.Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelDeltaX (Meters)", wheelDeltaX.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelDeltaY (Meters)", wheelDeltaY.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Triangle Theta", thetaDeg.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Ninety (Degrees)", ninety.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Field Quadrant", m_targetFinder.GetFieldQuadrant(WheelPose));
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelPoseX (Meters)", WheelPose.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelPoseY (Meters)", WheelPose.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelDeltaX (Meters)", wheelDeltaX.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: WheelDeltaY (Meters)", wheelDeltaY.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Triangle Theta", thetaDeg.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Ninety (Degrees)", ninety.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Field Quadrant", m_targetFinder.GetFieldQuadrant(WheelPose));
 
     auto radialAngle = thetaDeg;
     auto orbitAngle = thetaDeg + ninety.Degrees();
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Orbit Angle (Degrees)", orbitAngle.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Radial Angle (Degrees)", radialAngle.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Orbit Angle (Degrees)", orbitAngle.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Polar Drive: Radial Angle (Degrees)", radialAngle.to<double>());
 
     auto hasRadialComp = (abs(speeds.vx.to<double>()) > 0.1);
     auto hasOrbitComp = (abs(speeds.vy.to<double>()) > 0.1);
@@ -472,16 +484,17 @@ void SwerveChassis::DriveToPointTowardGoal
     auto targetPose = goalPose;
     frc::Pose2d driveToPose;
 
-    auto distanceError = m_shootingDistance - m_limelight->EstimateTargetDistance();
+    const auto& target = RobotStateMgr::GetInstance()->GetState().limelight;
+    auto distanceError = m_shootingDistance - target.targetDistance;
 
     //Finding Target pose on feild based on current position
     double theta = abs(atan((targetPose.X()-myPose.X()).to<double>()/((targetPose.Y()-myPose.Y()).to<double>())));
-    double xComp = sin(theta)*(m_limelight->EstimateTargetDistance().to<double>() + 24.0)*0.0254;//adding 24 inches offset for the center of goal, converting to meters
-    double yComp = cos(theta)*(m_limelight->EstimateTargetDistance().to<double>() + 24.0)*0.0254;//adding 24 inches offset for the center of goal, converting to meters
+    double xComp = sin(theta)*(target.targetDistance.to<double>() + 24.0)*0.0254;//adding 24 inches offset for the center of goal, converting to meters
+    double yComp = cos(theta)*(target.targetDistance.to<double>() + 24.0)*0.0254;//adding 24 inches offset for the center of goal, converting to meters
 
     double speedCorrection = (distanceError.to<double>() < 30.0) ? kPDistance*2.0 : kPDistance;
 
-    if (m_limelight != nullptr && m_limelight->HasTarget())
+    if (target.hasTarget)
     { 
         if (abs(distanceError.to<double>()) > 10.0)
         {
@@ -528,7 +541,7 @@ void SwerveChassis::DriveToPointTowardGoal
     {
         AdjustRotToPointTowardGoal(robotPose, rot);
     }
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Chassis Heading: TurnToGoal New ZSpeed: "), rot.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Chassis Heading: TurnToGoal New ZSpeed: "), rot.to<double>());
 }
 
 void SwerveChassis::AdjustRotToPointTowardGoal
@@ -537,15 +550,53 @@ void SwerveChassis::AdjustRotToPointTowardGoal
     units::radians_per_second_t &rot     
 )
 {
-    if(abs(m_limelight->GetTargetHorizontalOffset().to<double>()) < 1.0 && m_limelight->HasTarget())
+    const auto& state = RobotStateMgr::GetInstance()->GetState();
+    const auto& target = state.limelight;
+    auto poseIsFresh = m_lastVisionFusion > units::time::second_t(0.0) && 
+                       (state.timestamp - m_lastVisionFusion) < kVisionPoseTimeout;
+
+    if (poseIsFresh)
     {
-        m_hold = true;
+        // vision was fused at the frame's capture time, so the pose is current; aim off of it 
+        // instead of a tx that is a frame behind
+        auto toGoal = m_targetFinder.GetPosCenterTarget().Translation() - robotPose.Translation();
+        units::angle::degree_t targetAngle = units::math::atan2(toGoal.Y(), toGoal.X());
+        auto errorAngle = AngleUtils::GetEquivAngle(AngleUtils::GetDeltaAngle(robotPose.Rotation().Degrees(), targetAngle));
+        if (units::math::abs(errorAngle) < units::angle::degree_t(1.0))
+        {
+            m_hold = true;
+        }
+        else
+        {
+            rot -= CalcHeadingCorrection(targetAngle,kPGoalHeadingControl);
+            m_hold = false;
+        }
     }
-    else if (m_limelight != nullptr && m_limelight->HasTarget())
+    else if (target.hasTarget)
     { 
-        double rotCorrection = abs(m_limelight->GetTargetHorizontalOffset().to<double>()) > 10.0 ? kPGoalHeadingControl : kPGoalHeadingControl*2.0;
-        rot += (m_limelight->GetTargetHorizontalOffset())/1_s*rotCorrection;
-        m_hold = false;   
+        // remove the rotation since the frame was captured
+        auto offset = target.horizontalOffset;
+        Pose2d capturePose;
+        bool hasCapturePose = false;
+        {
+            lock_guard<mutex> lock(m_estimatorMutex);
+            hasCapturePose = m_poseHistory.GetPose(target.timestamp, capturePose);
+        }
+        if (hasCapturePose)
+        {
+            offset -= AngleUtils::GetDeltaAngle(capturePose.Rotation().Degrees(), robotPose.Rotation().Degrees());
+        }
+
+        if (abs(offset.to<double>()) < 1.0)
+        {
+            m_hold = true;
+        }
+        else
+        {
+            double rotCorrection = abs(offset.to<double>()) > 10.0 ? kPGoalHeadingControl : kPGoalHeadingControl*2.0;
+            rot += offset/1_s*rotCorrection;
+            m_hold = false;   
+        }
     }
     else
     {
@@ -554,44 +605,78 @@ void SwerveChassis::AdjustRotToPointTowardGoal
         m_hold = false;
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Chassis Heading: TurnToGoal New ZSpeed: "), rot.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), string("Chassis Heading: TurnToGoal New ZSpeed: "), rot.to<double>());
 }
 
+/// @brief Provide the current pose; it is computed once per cycle and reused until odometry is updated
 Pose2d SwerveChassis::GetPose() const
 {
-    if (m_poseOpt==PoseEstimatorEnum::WPI)
+    auto cycle = RobotStateMgr::GetInstance()->GetCycle();
+    if (cycle == 0 || m_poseCycle != cycle)
     {
-        return m_poseEstimator.GetEstimatedPosition();
+        if (m_poseOpt==PoseEstimatorEnum::WPI && IsOdometryThreadRunning())
+        {
+            auto latest = m_latestPose.Load();
+            m_cachedPose = Pose2d(units::length::meter_t(latest.x), 
+                                  units::length::meter_t(latest.y), 
+                                  Rotation2d(units::angle::radian_t(latest.rotation)));
+        }
+        else
+        {
+            m_cachedPose = (m_poseOpt==PoseEstimatorEnum::WPI) ? m_poseEstimator.GetEstimatedPosition() : m_pose;
+        }
+        m_poseCycle = cycle;
     }
-    return m_pose;
+    return m_cachedPose;
+}
+
+/// @brief Copy of the pose estimator
+frc::SwerveDrivePoseEstimator<4> SwerveChassis::GetPoseEst() const
+{
+    lock_guard<mutex> lock(m_estimatorMutex);
+    return m_poseEstimator;
 }
 
 units::angle::degree_t SwerveChassis::GetYaw() const
 {
-    units::degree_t yaw{m_pigeon->GetYaw()};
-    return yaw;
+    return RobotStateMgr::GetInstance()->GetYaw();
 }
 
 /// @brief update the chassis odometry based on current states of the swerve modules and the pigeon
 void SwerveChassis::UpdateOdometry() 
 {
-    units::degree_t yaw{m_pigeon->GetYaw()};
+    const auto& state = RobotStateMgr::GetInstance()->GetState();
+    units::degree_t yaw = GetYaw();
     Rotation2d rot2d {yaw}; 
+    m_poseCycle = 0;
+    auto timestamp = state.cycle != 0 ? state.timestamp : frc::Timer::GetFPGATimestamp();
+
+    if (m_poseOpt == PoseEstimatorEnum::WPI && IsOdometryThreadRunning())
+    {
+        // the odometry thread keeps the estimator and pose history up to date; only vision is applied here
+        lock_guard<mutex> lock(m_estimatorMutex);
+        FuseVisionMeasurement();
+        m_poseCycle = 0;
+        return;
+    }
 
     if (m_poseOpt == PoseEstimatorEnum::WPI)
     {
         auto currentPose = m_poseEstimator.GetEstimatedPosition();
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Current X", currentPose.X().to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Current Y", currentPose.Y().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Current X", currentPose.X().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Current Y", currentPose.Y().to<double>());
 
-        m_poseEstimator.Update(rot2d, m_frontLeft.get()->GetState(),
-                                      m_frontRight.get()->GetState(), 
-                                      m_backLeft.get()->GetState(),
-                                      m_backRight.get()->GetState());
+        m_poseEstimator.UpdateWithTime(timestamp,
+                                       rot2d, 
+                                       m_frontLeft.get()->GetState(),
+                                       m_frontRight.get()->GetState(), 
+                                       m_backLeft.get()->GetState(),
+                                       m_backRight.get()->GetState());
+        FuseVisionMeasurement();
 
         auto updatedPose = m_poseEstimator.GetEstimatedPosition();
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Updated X", updatedPose.X().to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Updated Y", updatedPose.Y().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Updated X", updatedPose.X().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Odometry: Updated Y", updatedPose.Y().to<double>());
     }
     else if (m_poseOpt==PoseEstimatorEnum::EULER_AT_CHASSIS)
     {
@@ -633,6 +718,217 @@ void SwerveChassis::UpdateOdometry()
         auto trans = currPose - m_pose;
         m_pose = m_pose + trans;
     }
+    m_poseCycle = 0;
+    m_poseHistory.Add(timestamp, GetPose());
+}
+
+/// @brief Apply the latest limelight frame to the pose estimator at the time it was captured.  Frames
+///        that are stale, out of range, taken while spinning quickly or too far from where odometry 
+///        says the robot was are dropped.
+void SwerveChassis::FuseVisionMeasurement()
+{
+    const auto& target = RobotStateMgr::GetInstance()->GetState().limelight;
+    if (m_limelight == nullptr || !target.hasTarget || (target.frameId != 0 && target.frameId == m_lastVisionFrame))
+    {
+        return;
+    }
+    m_lastVisionFrame = target.frameId;
+
+    if (target.latency > kVisionMaxLatency ||
+        target.targetDistance < kVisionMinDistance || 
+        target.targetDistance > kVisionMaxDistance ||
+        units::math::abs(GetChassisSpeeds().omega) > kVisionMaxRotationRate)
+    {
+        return;
+    }
+
+    Pose2d capturePose;
+    Pose2d visionPose;
+    if (!m_poseHistory.GetPose(target.timestamp, capturePose) ||
+        !m_limelight->EstimateRobotPose(target, m_targetFinder.GetPosCenterTarget(), capturePose.Rotation(), visionPose))
+    {
+        return;
+    }
+
+    // if odometry has been off for a while (e.g. pose never reset) the gate would reject every frame, so
+    // re-seed from vision once enough consecutive gated frames agree on the same odometry error; a lone 
+    // outlier restarts the count instead of being accepted
+    auto offset = visionPose.Translation() - capturePose.Translation();
+    auto jump = offset.Norm();
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Vision: Pose Jump (Meters)", jump.to<double>());
+    if (jump > kVisionGate)
+    {
+        auto agrees = m_visionRejects > 0 && offset.Distance(m_visionRejectOffset) <= kVisionRejectAgreement;
+        m_visionRejects = agrees ? m_visionRejects + 1 : 1;
+        m_visionRejectOffset = offset;
+        if (m_visionRejects < kVisionMaxRejects)
+        {
+            return;
+        }
+    }
+    m_visionRejects = 0;
+
+    // trust the measurement less the further away the target is; heading comes from the gyro
+    double range = units::length::meter_t(target.targetDistance).to<double>();
+    double xyStdDev = 0.1 * (1.0 + range*range/9.0);
+    m_poseEstimator.SetVisionMeasurementStdDevs({xyStdDev, xyStdDev, 10.0});
+    m_poseEstimator.AddVisionMeasurement(visionPose, target.timestamp);
+    if (IsOdometryThreadRunning())
+    {
+        PublishPose(frc::Timer::GetFPGATimestamp());
+    }
+
+    m_lastVisionFusion = RobotStateMgr::GetInstance()->GetState().timestamp;
+    m_poseCycle = 0;
+
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Vision: X", visionPose.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Vision: Y", visionPose.Y().to<double>());
+}
+
+/// @brief Run the WPI pose estimator on its own notifier instead of once per robot loop.  The drive
+///        motor feedback, CANCoder and pigeon yaw frames are sped up to match so each update sees
+///        new sensor values.
+/// @param [in] units::frequency::hertz_t   rate:   how often to update odometry (0 stops the thread)
+void SwerveChassis::SetOdometryRate
+(
+    units::frequency::hertz_t   rate
+)
+{
+    m_odometryNotifier.reset();
+    m_odometryPeriod = units::time::millisecond_t(0.0);
+    if (rate <= units::frequency::hertz_t(0.0))
+    {
+        return;
+    }
+
+    if (m_poseOpt != PoseEstimatorEnum::WPI)
+    {
+        string msg = "odometry thread requires the WPI pose estimator; updating odometry from the robot loop";
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("SwerveChassis"), string("SetOdometryRate"), msg);
+        return;
+    }
+
+    if (rate > kMaxOdometryRate)
+    {
+        string msg = "odometry rate limited to " + to_string(kMaxOdometryRate.to<double>()) + " Hz";
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("SwerveChassis"), string("SetOdometryRate"), msg);
+        rate = kMaxOdometryRate;
+    }
+
+    units::time::millisecond_t period = 1.0 / rate;
+    auto frameMs = static_cast<uint8_t>(lround(period.to<double>()));
+    m_frontLeft.get()->SetOdometryFramePeriod(frameMs);
+    m_frontRight.get()->SetOdometryFramePeriod(frameMs);
+    m_backLeft.get()->SetOdometryFramePeriod(frameMs);
+    m_backRight.get()->SetOdometryFramePeriod(frameMs);
+    if (m_pigeon != nullptr)
+    {
+        m_pigeon->SetYawFramePeriod(frameMs);
+    }
+    m_odometryPeriod = period;
+}
+
+/// @brief Start the odometry thread requested by SetOdometryRate (robot init calls this after the CAN 
+///        frames are planned and the drive motors are configured)
+void SwerveChassis::StartOdometryThread()
+{
+    if (m_odometryPeriod <= units::time::millisecond_t(0.0) || m_odometryNotifier.get() != nullptr || m_odometryStepped)
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_estimatorMutex);
+        PublishPose(frc::Timer::GetFPGATimestamp());
+    }
+    m_odometryNotifier = make_unique<frc::Notifier>([this] { RunOdometry(); });
+    m_odometryNotifier->StartPeriodic(m_odometryPeriod);
+}
+
+/// @brief Run odometry only from StepOdometry (the replay tool steps it with the simulated clock so 
+///        the replay is deterministic)
+void SwerveChassis::SetOdometryStepped()
+{
+    m_odometryNotifier.reset();
+    if (!m_odometryStepped)
+    {
+        m_odometryStepped = true;
+        lock_guard<mutex> lock(m_estimatorMutex);
+        PublishPose(frc::Timer::GetFPGATimestamp());
+    }
+}
+
+/// @brief One odometry thread cycle on the calling thread (see SetOdometryStepped)
+void SwerveChassis::StepOdometry()
+{
+    if (m_odometryStepped && m_odometryPeriod > units::time::millisecond_t(0.0))
+    {
+        RunOdometry();
+    }
+}
+
+/// @brief Odometry thread callback:  sample the modules and gyro and update the pose estimator.  The
+///        Phoenix getters are thread safe; the robot loop only re-zeros the pigeon or moves the simulated 
+///        sensors while holding m_estimatorMutex, so a sample never straddles one of those.
+void SwerveChassis::RunOdometry()
+{
+    lock_guard<mutex> lock(m_estimatorMutex);
+
+    SwerveModuleSample fl;
+    SwerveModuleSample fr;
+    SwerveModuleSample bl;
+    SwerveModuleSample br;
+    m_frontLeft.get()->Sample(fl);
+    m_frontRight.get()->Sample(fr);
+    m_backLeft.get()->Sample(bl);
+    m_backRight.get()->Sample(br);
+    Rotation2d rot2d {units::angle::degree_t(m_pigeon->GetYaw())};
+    auto timestamp = frc::Timer::GetFPGATimestamp();
+
+    m_poseEstimator.UpdateWithTime(timestamp,
+                                   rot2d,
+                                   m_frontLeft.get()->CalcState(fl),
+                                   m_frontRight.get()->CalcState(fr),
+                                   m_backLeft.get()->CalcState(bl),
+                                   m_backRight.get()->CalcState(br));
+    PublishPose(timestamp);
+    m_poseHistory.Add(timestamp, m_poseEstimator.GetEstimatedPosition());
+}
+
+/// @brief Make the estimator's pose visible to GetPose() (m_estimatorMutex must be held, so the
+///        odometry thread and the robot loop never store at the same time)
+/// @param [in] units::time::second_t   timestamp:  FPGA time of the pose
+void SwerveChassis::PublishPose
+(
+    units::time::second_t   timestamp
+)
+{
+    auto pose = m_poseEstimator.GetEstimatedPosition();
+    m_latestPose.Store({timestamp.to<double>(), 
+                        pose.X().to<double>(), 
+                        pose.Y().to<double>(), 
+                        pose.Rotation().Radians().to<double>()});
+}
+
+/// @brief Turn the modeled module motion into CANCoder and pigeon readings (simulation only).  The motor
+///        models have already been stepped by the DragonSimulation; the heading comes from the module
+///        states through the kinematics since nothing else models the chassis.
+/// @param [in] units::time::second_t   dt:     time since the last update
+void SwerveChassis::UpdateSimulation
+(
+    units::time::second_t   dt
+)
+{
+    lock_guard<mutex> lock(m_estimatorMutex);
+    auto speeds = m_kinematics.ToChassisSpeeds({ m_frontLeft.get()->UpdateSimulation(), 
+                                                 m_frontRight.get()->UpdateSimulation(),
+                                                 m_backLeft.get()->UpdateSimulation(),
+                                                 m_backRight.get()->UpdateSimulation() });
+    if (m_pigeon != nullptr)
+    {
+        units::angle::degree_t delta = speeds.omega * dt;
+        m_pigeon->AddSimYaw(delta.to<double>());
+    }
 }
 
 /// @brief set all of the encoders to zero
@@ -653,10 +949,16 @@ double SwerveChassis::GetEncoderValues(std::shared_ptr<SwerveModule> motor)
 /// @brief Provide the current chassis speed information
 ChassisSpeeds SwerveChassis::GetChassisSpeeds() const
 {
-    return m_kinematics.ToChassisSpeeds({ m_frontLeft.get()->GetState(), 
-                                          m_frontRight.get()->GetState(),
-                                          m_backLeft.get()->GetState(),
-                                          m_backRight.get()->GetState() });
+    auto cycle = RobotStateMgr::GetInstance()->GetCycle();
+    if (cycle == 0 || m_speedsCycle != cycle)
+    {
+        m_cachedSpeeds = m_kinematics.ToChassisSpeeds({ m_frontLeft.get()->GetState(), 
+                                                        m_frontRight.get()->GetState(),
+                                                        m_backLeft.get()->GetState(),
+                                                        m_backRight.get()->GetState() });
+        m_speedsCycle = cycle;
+    }
+    return m_cachedSpeeds;
 }
 
 /// @brief Reset the current chassis pose based on the provided pose and rotation
@@ -668,13 +970,21 @@ void SwerveChassis::ResetPose
     const Rotation2d&   angle
 )
 {
-    m_poseEstimator.ResetPosition(pose, angle);
-    SetEncodersToZero();
-    m_pose = pose;
+    {
+        // re-zero the pigeon while holding the lock so the odometry thread doesn't pair the new pose with the old yaw
+        lock_guard<mutex> lock(m_estimatorMutex);
+        m_poseEstimator.ResetPosition(pose, angle);
+        m_poseHistory.Clear();
 
-    auto pigeon = PigeonFactory::GetFactory()->GetPigeon(DragonPigeon::PIGEON_USAGE::CENTER_OF_ROBOT);
+        auto pigeon = PigeonFactory::GetFactory()->GetPigeon(DragonPigeon::PIGEON_USAGE::CENTER_OF_ROBOT);
+        pigeon->ReZeroPigeon(angle.Degrees().to<double>(), 0);
 
-    pigeon->ReZeroPigeon(angle.Degrees().to<double>(), 0);
+        PublishPose(frc::Timer::GetFPGATimestamp());
+    }
+    SetEncodersToZero();
+    m_pose = pose;
+    m_poseCycle = 0;
+    m_visionRejects = 0;
 
     m_storedYaw = angle.Degrees();
 
@@ -715,20 +1025,20 @@ ChassisSpeeds SwerveChassis::GetFieldRelativeSpeeds
     units::radians_per_second_t rot        
 )
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: xSpeed (mps)", xSpeed.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: ySpeed (mps)", ySpeed.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: rot (radians per sec)", rot.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: xSpeed (mps)", xSpeed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: ySpeed (mps)", ySpeed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: rot (radians per sec)", rot.to<double>());
 
-    units::angle::radian_t yaw{m_pigeon->GetYaw()*wpi::numbers::pi/180.0};
+    units::angle::radian_t yaw = GetYaw();
     auto temp = xSpeed*cos(yaw.to<double>()) + ySpeed*sin(yaw.to<double>());
     auto strafe = -1.0*xSpeed*sin(yaw.to<double>()) + ySpeed*cos(yaw.to<double>());
     auto forward = temp;
 
     ChassisSpeeds output{forward, strafe, rot};
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: yaw (radians)", yaw.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: forward (mps)", forward.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: stafe (mps)", strafe.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: yaw (radians)", yaw.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: forward (mps)", forward.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Field Oriented Calcs: stafe (mps)", strafe.to<double>());
 
     return output;
 }
@@ -758,9 +1068,9 @@ void SwerveChassis::CalcSwerveModuleStates
     // We will use these variable names in the code to help tie back to the document.
     // Variable names, though, will follow C++ standards and start with a lower case letter.
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Drive", speeds.vx.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs:Strafe", speeds.vy.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs:Rotate", speeds.omega.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Drive", speeds.vx.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs:Strafe", speeds.vy.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs:Rotate", speeds.omega.to<double>());
 
     auto l = GetWheelBase();
     auto w = GetTrack();
@@ -783,8 +1093,8 @@ void SwerveChassis::CalcSwerveModuleStates
     m_flState.speed = units::velocity::meters_per_second_t(sqrt( pow(b.to<double>(),2) + pow(d.to<double>(),2) ));
     auto maxCalcSpeed = abs(m_flState.speed.to<double>());
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Angle", m_flState.angle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Speed", m_flState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Angle", m_flState.angle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Speed", m_flState.speed.to<double>());
 
     m_frState.angle = units::angle::radian_t(atan2(b.to<double>(), c.to<double>()));
     m_frState.angle = -1.0 * m_frState.angle.Degrees();
@@ -794,8 +1104,8 @@ void SwerveChassis::CalcSwerveModuleStates
         maxCalcSpeed = abs(m_frState.speed.to<double>());
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Angle", m_frState.angle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Speed - raw", m_frState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Angle", m_frState.angle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Speed - raw", m_frState.speed.to<double>());
 
     m_blState.angle = units::angle::radian_t(atan2(a.to<double>(), d.to<double>()));
     m_blState.angle = -1.0 * m_blState.angle.Degrees();
@@ -805,8 +1115,8 @@ void SwerveChassis::CalcSwerveModuleStates
         maxCalcSpeed = abs(m_blState.speed.to<double>());
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Angle", m_blState.angle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Speed - raw", m_blState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Angle", m_blState.angle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Speed - raw", m_blState.speed.to<double>());
 
     m_brState.angle = units::angle::radian_t(atan2(a.to<double>(), c.to<double>()));
     m_brState.angle = -1.0 * m_brState.angle.Degrees();
@@ -816,8 +1126,8 @@ void SwerveChassis::CalcSwerveModuleStates
         maxCalcSpeed = abs(m_brState.speed.to<double>());
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Angle", m_brState.angle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Speed - raw", m_brState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Angle", m_brState.angle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Speed - raw", m_brState.speed.to<double>());
 
 
     // normalize speeds if necessary (maxCalcSpeed > max attainable speed)
@@ -830,10 +1140,10 @@ void SwerveChassis::CalcSwerveModuleStates
         m_brState.speed *= ratio;
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Speed - normalized", m_flState.speed.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Speed - normalized", m_frState.speed.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Speed - normalized", m_blState.speed.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Speed - normalized", m_brState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Left Speed - normalized", m_flState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Front Right Speed - normalized", m_frState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Left Speed - normalized", m_blState.speed.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("Swerve Chassis"), "Swerve Calcs: Back Right Speed - normalized", m_brState.speed.to<double>());
 }
 
 void SwerveChassis::SetTargetHeading(units::angle::degree_t targetYaw) 
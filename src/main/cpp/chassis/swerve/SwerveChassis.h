@@ -16,6 +16,7 @@
 
 #pragma once
 #include <memory>
+#include <mutex>
 
 #include <frc/AnalogGyro.h>
 #include <frc/BuiltInAccelerometer.h>
@@ -25,12 +26,14 @@
 #include <frc/geometry/Translation2d.h>
 #include <frc/kinematics/SwerveDriveKinematics.h>
 #include <frc/kinematics/SwerveDriveOdometry.h>
+#include <frc/Notifier.h>
 #include <frc/Timer.h>
 
 #include <units/acceleration.h>
 #include <units/angle.h>
 #include <units/angular_acceleration.h>
 #include <units/angular_velocity.h>
+#include <units/frequency.h>
 #include <units/length.h>
 #include <units/velocity.h>
 
@@ -38,10 +41,12 @@
 #include <chassis/DragonTargetFinder.h>
 #include <chassis/IChassis.h>
 #include <chassis/PoseEstimatorEnum.h>
+#include <chassis/PoseHistory.h>
 #include <chassis/swerve/SwerveModule.h>
 #include <hw/DragonLimelight.h>
 #include <hw/DragonPigeon.h>
 #include <hw/factories/PigeonFactory.h>
+#include <utils/SeqLock.h>
 
 class SwerveChassis : public IChassis
 {
@@ -110,6 +115,40 @@ class SwerveChassis : public IChassis
         /// @brief update the chassis odometry based on current states of the swerve modules and the pigeon
         void UpdateOdometry();
 
+        /// @brief Run the WPI pose estimator on its own notifier instead of once per robot loop.  This requests 
+        ///        the sensor frame rates; the thread starts in StartOdometryThread.
+        /// @param [in] units::frequency::hertz_t   rate:   how often to update odometry (0 stops the thread)
+        void SetOdometryRate
+        (
+            units::frequency::hertz_t   rate
+        );
+
+        /// @brief Start the odometry thread requested by SetOdometryRate.  Call once robot init has planned the 
+        ///        CAN frames and the drive motors are configured, so the thread never samples a device mid-config.
+        void StartOdometryThread();
+        bool IsOdometryThreadRunning() const { return m_odometryNotifier.get() != nullptr || (m_odometryStepped && m_odometryPeriod > units::time::millisecond_t(0.0)); }
+
+        /// @brief Stop the odometry thread; odometry then only updates when StepOdometry is called (replay 
+        ///        steps it against its own clock at GetOdometryPeriod)
+        void SetOdometryStepped();
+        void StepOdometry();
+        units::time::millisecond_t GetOdometryPeriod() const { return m_odometryPeriod; }
+
+        /// @brief measured time from a drive command until the modules respond; path following 
+        ///        samples its trajectory this far ahead
+        void SetActuationLatency
+        (
+            units::time::second_t       latency
+        ) { m_actuationLatency = latency; }
+        units::time::second_t GetActuationLatency() const { return m_actuationLatency; }
+
+        /// @brief Turn the modeled module motion into CANCoder and pigeon readings (simulation only)
+        /// @param [in] units::time::second_t   dt:     time since the last update
+        void UpdateSimulation
+        (
+            units::time::second_t   dt
+        );
+
         /// @brief Provide the current chassis speed information
         frc::ChassisSpeeds GetChassisSpeeds() const;
 
@@ -149,7 +188,7 @@ class SwerveChassis : public IChassis
         std::shared_ptr<SwerveModule> GetFrontRight() const { return m_frontRight;}
         std::shared_ptr<SwerveModule> GetBackLeft() const { return m_backLeft;}
         std::shared_ptr<SwerveModule> GetBackRight() const { return m_backRight;}
-        frc::SwerveDrivePoseEstimator<4> GetPoseEst() const { return m_poseEstimator; }  
+        frc::SwerveDrivePoseEstimator<4> GetPoseEst() const;
         frc::Pose2d GetPose() const;
         units::angle::degree_t GetYaw() const override;
 
@@ -207,6 +246,18 @@ class SwerveChassis : public IChassis
             units::radians_per_second_t& rot
             
         );
+        /// @brief Apply the latest limelight frame to the pose estimator at the time it was captured
+        void FuseVisionMeasurement();
+
+        /// @brief Odometry thread callback:  sample the modules and gyro and update the pose estimator
+        void RunOdometry();
+
+        /// @brief Make the estimator's pose visible to GetPose() (m_estimatorMutex must be held)
+        void PublishPose
+        (
+            units::time::second_t   timestamp
+        );
+
         units::angle::degree_t UpdateForPolarDrive
         (
             frc::Pose2d              robotPose,
@@ -239,6 +290,10 @@ class SwerveChassis : public IChassis
         bool                                                        m_runWPI;
         PoseEstimatorEnum                                           m_poseOpt;
         frc::Pose2d                                                 m_pose;
+        mutable frc::Pose2d                                         m_cachedPose;       // GetPose() memoized for the current cycle
+        mutable unsigned int                                        m_poseCycle;
+        mutable frc::ChassisSpeeds                                  m_cachedSpeeds;     // GetChassisSpeeds() memoized for the current cycle
+        mutable unsigned int                                        m_speedsCycle;
         units::angle::degree_t                                      m_offsetPoseAngle;
         frc::Timer                                                  m_timer;
         units::velocity::meters_per_second_t                        m_drive;
@@ -282,7 +337,38 @@ class SwerveChassis : public IChassis
         units::angle::degree_t m_targetHeading;
         DragonLimelight*        m_limelight;
 
+        PoseHistory             m_poseHistory;
+        uint64_t                m_lastVisionFrame;
+        units::time::second_t   m_lastVisionFusion;
+        int                     m_visionRejects;            // consecutive gated frames that agreed with each other
+        frc::Translation2d      m_visionRejectOffset;       // vision - odometry of the last gated frame
+        units::time::second_t   m_actuationLatency;
+
+        const units::time::second_t                         kVisionMaxLatency = units::time::second_t(0.25);
+        const units::time::second_t                         kVisionPoseTimeout = units::time::second_t(0.5);    // aim off of the pose while vision was fused this recently
+        const units::length::inch_t                         kVisionMinDistance = units::length::inch_t(24.0);
+        const units::length::inch_t                         kVisionMaxDistance = units::length::inch_t(300.0);
+        const units::length::meter_t                        kVisionGate = units::length::meter_t(1.0);          // max jump from where odometry says we were
+        const units::angular_velocity::degrees_per_second_t kVisionMaxRotationRate = units::angular_velocity::degrees_per_second_t(180.0);
+        const int                                           kVisionMaxRejects = 25;                             // consecutive agreeing gated frames before trusting vision again
+        const units::length::meter_t                        kVisionRejectAgreement = units::length::meter_t(0.25); // max change in the gated offset between frames
+
         const units::length::inch_t m_shootingDistance = units::length::inch_t(105.0); // was 105.0
 
+        struct OdometryPose
+        {
+            double  timestamp;
+            double  x;              // meters
+            double  y;              // meters
+            double  rotation;       // radians
+        };
+
+        const units::frequency::hertz_t kMaxOdometryRate = units::frequency::hertz_t(250.0);
+        units::time::millisecond_t      m_odometryPeriod;       // 0 when odometry runs from the robot loop
+
+        mutable std::mutex                                          m_estimatorMutex;   // guards m_poseEstimator and m_poseHistory while the odometry thread runs
+        SeqLock<OdometryPose>                                       m_latestPose;
+        bool                                                        m_odometryStepped;
+        std::unique_ptr<frc::Notifier>                              m_odometryNotifier; // last so it stops before anything it uses is destroyed
 
 };
\ No newline at end of file
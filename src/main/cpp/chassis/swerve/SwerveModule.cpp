@@ -34,11 +34,14 @@
 #include <chassis/PoseEstimatorEnum.h>
 #include <chassis/swerve/SwerveChassis.h>
 #include <chassis/swerve/SwerveModule.h>
+#include <hw/DeviceConfigQueue.h>
 #include <hw/DragonCanCoder.h>
+#include <hw/sim/DragonSimulation.h>
 #include <mechanisms/controllers/ControlData.h>
 #include <mechanisms/controllers/ControlModes.h>
 #include <utils/AngleUtils.h>
 #include <utils/Logger.h>
+#include <RobotState.h>
 
 // Third Party Includes
 #include <ctre/phoenix/motorcontrol/can/WPI_TalonFX.h>
@@ -75,6 +78,10 @@ SwerveModule::SwerveModule
     m_driveMotor(driveMotor), 
     m_turnMotor(turnMotor), 
     m_turnSensor(canCoder), 
+    m_driveTalon(driveMotor.get()->GetTalonFX()),
+    m_turnTalon(turnMotor.get()->GetTalonFX()),
+    m_driveSensors(driveMotor.get()->GetIntegratedSensor()),
+    m_turnSensors(turnMotor.get()->GetIntegratedSensor()),
     m_driveVelocityControlData(new ControlData()),
     m_drivePercentControlData(new ControlData()),
     m_turnPositionControlData(new ControlData(  ControlModes::CONTROL_TYPE::POSITION_ABSOLUTE,
@@ -99,6 +106,12 @@ SwerveModule::SwerveModule
     m_maxVelocity(1_mps),
     m_runClosedLoopDrive(false)
 {
+    // the falcons may still be getting configured on a DeviceConfigQueue worker and the code below 
+    // writes to them directly
+    auto configQueue = DeviceConfigQueue::GetInstance();
+    configQueue->WaitFor(driveMotor.get());
+    configQueue->WaitFor(turnMotor.get());
+
     driveMotor.get()->SetFramePeriodPriority(IDragonMotorController::MOTOR_PRIORITY::HIGH);
     turnMotor.get()->SetFramePeriodPriority(IDragonMotorController::MOTOR_PRIORITY::HIGH);
 
@@ -107,16 +120,12 @@ SwerveModule::SwerveModule
     m_activeState.speed = 0_mps;
     
     // Set up the Drive Motor
-    auto motor = m_driveMotor.get()->GetSpeedController();
-    auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-
-    //fx->ConfigOpenloopRamp(0.4, 0);
-    //fx->ConfigClosedloopRamp(0.4, 0);
+    //m_driveTalon->ConfigOpenloopRamp(0.4, 0);
+    //m_driveTalon->ConfigClosedloopRamp(0.4, 0);
 
-    fx->ConfigSelectedFeedbackSensor( ctre::phoenix::motorcontrol::FeedbackDevice::IntegratedSensor, 0, 10 );
-    fx->ConfigIntegratedSensorInitializationStrategy(BootToZero);
-    auto driveMotorSensors = fx->GetSensorCollection();
-    driveMotorSensors.SetIntegratedSensorPosition(0, 0);
+    // the feedback sensor and boot strategy are part of the falcon's queued configuration (see
+    // DragonMotorControllerFactory); the position isn't a configuration setting
+    m_driveSensors->SetIntegratedSensorPosition(0, 0);
 
 
     // Set up the Absolute Turn Sensor
@@ -125,15 +134,16 @@ SwerveModule::SwerveModule
     
     
     // Set up the Turn Motor
-    motor = m_turnMotor.get()->GetSpeedController();
-    fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-    fx->ConfigSelectedFeedbackSensor( ctre::phoenix::motorcontrol::FeedbackDevice::IntegratedSensor, 0, 10 );
-    fx->ConfigIntegratedSensorInitializationStrategy(BootToZero);
-    auto turnMotorSensors = fx->GetSensorCollection();
-    turnMotorSensors.SetIntegratedSensorPosition(0, 0);
+    m_turnSensors->SetIntegratedSensorPosition(0, 0);
 
     m_turnMotor.get()->SetControlConstants(0, m_turnPositionControlData);
 
+    auto turnRatio = kTurnCountsPerDegree * 360.0 / kTurnCountsPerRev;
+    if ( abs(m_turnMotor.get()->GetGearRatio() - turnRatio) > 0.05 * turnRatio )
+    {
+        Logger::GetLogger()->LogData( LOGGER_LEVEL::ERROR_ONCE, m_nt, string("turn gearRatio"), string("SWERVE_TURN gearRatio in robot.xml does not match the turn gearing; the simulation will be off"));
+    }
+
     switch ( GetType() )
     {
         case ModuleID::LEFT_FRONT:
@@ -158,8 +168,8 @@ SwerveModule::SwerveModule
             break;
     }
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "CurrentPoseX", to_string(m_currentPose.X().to<double>()));
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "CurrentPoseY", to_string(m_currentPose.Y().to<double>()));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "CurrentPoseX", to_string(m_currentPose.X().to<double>()));
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "CurrentPoseY", to_string(m_currentPose.Y().to<double>()));
 }
 
 /// @brief initialize the swerve module with information that the swerve chassis knows about
@@ -207,20 +217,14 @@ void SwerveModule::Init
 /// @brief void
 void SwerveModule::SetEncodersToZero()
 {
-    auto motor = m_driveMotor.get()->GetSpeedController();
-    auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-    auto driveMotorSensors = fx->GetSensorCollection();
-    driveMotorSensors.SetIntegratedSensorPosition(0, 0);
+    m_driveSensors->SetIntegratedSensorPosition(0, 0);
 } 
 
 /// @brief Get the encoder values
 /// @returns double - the integrated sensor position
 double SwerveModule::GetEncoderValues()
 {
-    auto motor = m_driveMotor.get()->GetSpeedController();
-    auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-    auto driveMotorSensors = fx->GetSensorCollection();
-    return driveMotorSensors.GetIntegratedSensorPosition();
+    return m_driveSensors->GetIntegratedSensorPosition();
 }
 
 /// @brief Turn all of the wheel to zero degrees yaw according to the pigeon
@@ -235,19 +239,95 @@ void SwerveModule::ZeroAlignModule()
 /// @brief Get the current state of the module (speed of the wheel and angle of the wheel)
 /// @returns SwerveModuleState
 SwerveModuleState SwerveModule::GetState() const 
+{
+    return CalcState(GetSample());
+}
+
+/// @brief Convert a set of sensor values into a module state (speed of the wheel and angle of the wheel)
+/// @param [in] const SwerveModuleSample& sample:   sensor values for this module
+/// @returns SwerveModuleState
+SwerveModuleState SwerveModule::CalcState
+(
+    const SwerveModuleSample&   sample
+) const
 {
     // Get the Module Drive Motor Speed
     auto mpr = units::length::meter_t(GetWheelDiameter() * wpi::numbers::pi );               
-    auto mps = units::velocity::meters_per_second_t(mpr.to<double>() * m_driveMotor.get()->GetRPS());
+    auto mps = units::velocity::meters_per_second_t(mpr.to<double>() * sample.driveRPS);
 
     // Get the Module Current Rotation Angle
-    Rotation2d angle {units::angle::degree_t(m_turnSensor->GetAbsolutePosition())};
+    Rotation2d angle {sample.absoluteAngle};
 
     // Create the state and return it
     SwerveModuleState state{mps,angle};
     return state;
 }
 
+/// @brief Read the module sensors (called once per cycle by the RobotStateMgr)
+/// @param [out] SwerveModuleSample& sample:   sensor values for this module
+/// @returns void
+void SwerveModule::Sample
+(
+    SwerveModuleSample&     sample
+) const
+{
+    sample.driveRPS       = m_driveMotor.get()->GetRPS();
+    sample.driveRotations = m_driveMotor.get()->GetRotations();
+    sample.absoluteAngle  = units::angle::degree_t(m_turnSensor->GetAbsolutePosition());
+    sample.angle          = units::angle::degree_t(m_turnSensor->GetPosition());
+
+    sample.turnTicks      = m_turnSensors != nullptr ? m_turnSensors->GetIntegratedSensorPosition() : 0.0;
+    sample.valid          = true;
+}
+
+/// @brief Send the sensors the odometry uses at the odometry rate
+/// @param [in] uint8_t milliseconds:   status frame period
+/// @returns void
+void SwerveModule::SetOdometryFramePeriod
+(
+    uint8_t     milliseconds
+)
+{
+    m_driveMotor.get()->UpdateFramePeriods(motorcontrol::StatusFrameEnhanced::Status_2_Feedback0, milliseconds);
+    m_turnSensor->SetSensorDataFramePeriod(milliseconds);
+}
+
+/// @brief Move the CANCoder to the modeled steering angle (simulation only)
+/// @returns SwerveModuleState  modeled wheel speed and angle
+SwerveModuleState SwerveModule::UpdateSimulation()
+{
+    auto sim = DragonSimulation::GetInstance();
+    auto driveSim = sim->GetMotorSim(m_driveMotor.get());
+    auto turnSim  = sim->GetMotorSim(m_turnMotor.get());
+    if ( driveSim == nullptr || turnSim == nullptr )
+    {
+        return SwerveModuleState();
+    }
+
+    units::angle::degree_t angle = turnSim->GetAngle();
+    units::angular_velocity::degrees_per_second_t turnRate = turnSim->GetVelocity();
+    m_turnSensor->SetSimAngle(angle, turnRate);
+
+    units::length::meter_t radius = GetWheelDiameter() / 2.0;
+    auto mps = units::velocity::meters_per_second_t(driveSim->GetVelocity().to<double>() * radius.to<double>());
+    return SwerveModuleState{mps, Rotation2d(angle)};
+}
+
+/// @brief This cycle's sensor values; read directly if no snapshot has been taken yet
+/// @returns SwerveModuleSample
+SwerveModuleSample SwerveModule::GetSample() const
+{
+    const auto& sample = RobotStateMgr::GetInstance()->GetState().modules[m_type];
+    if ( sample.valid )
+    {
+        return sample;
+    }
+
+    SwerveModuleSample current;
+    Sample(current);
+    return current;
+}
+
 
 /// @brief Set the current state of the module (speed of the wheel and angle of the wheel)
 /// @param [in] const SwerveModuleState& targetState:   state to set the module to
@@ -261,7 +341,7 @@ void SwerveModule::SetDesiredState
     // If the desired angle is less than 90 degrees from the target angle (e.g., -90 to 90 is the amount of turn), just use the angle and speed values
     // if it is more than 90 degrees (90 to 270), the can turn the opposite direction -- increase the angle by 180 degrees -- and negate the wheel speed
     // finally, get the value between -90 and 90
-    Rotation2d currAngle = Rotation2d(units::angle::degree_t(m_turnSensor->GetAbsolutePosition()));
+    Rotation2d currAngle = Rotation2d(GetSample().absoluteAngle);
    auto optimizedState = Optimize(targetState, currAngle);
    // auto optimizedState = SwerveModuleState::Optimize(targetState, currAngle);
    // auto optimizedState = targetState;
@@ -294,9 +374,9 @@ SwerveModuleState SwerveModule::Optimize
 
     auto delta = AngleUtils::GetDeltaAngle(currentAngle.Degrees(), optimizedState.angle.Degrees());
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "Optimize current", currentAngle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "Optimize target", optimizedState.angle.Degrees().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "Optimize delta", delta.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "Optimize current", currentAngle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "Optimize target", optimizedState.angle.Degrees().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "Optimize delta", delta.to<double>());
     
     // deal with roll over issues (e.g. want to go from -180 degrees to 180 degrees or vice versa)
     // keep the current angle
@@ -311,18 +391,18 @@ SwerveModuleState SwerveModule::Optimize
     {
         optimizedState.speed *= -1.0;
         optimizedState.angle = optimizedState.angle + Rotation2d{180_deg};
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "Optimize reversing", delta.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "Optimize reversing", delta.to<double>());
     }
 
     // if the delta is > 90 degrees, rotate the opposite way and reverse the wheel
     if ((units::math::abs(delta) - 90_deg) > 0.1_deg) 
     {
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "optimized", (desiredState.angle + Rotation2d{180_deg}).Degrees().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "optimized", (desiredState.angle + Rotation2d{180_deg}).Degrees().to<double>());
         return {-desiredState.speed, desiredState.angle + Rotation2d{180_deg}};
     } 
     else 
     {
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "optimized", desiredState.angle.Degrees().to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "optimized", desiredState.angle.Degrees().to<double>());
         return {desiredState.speed, desiredState.angle};
     }
 }
@@ -333,9 +413,7 @@ void SwerveModule::RunCurrentState()
 {
     SetDriveSpeed(m_activeState.speed);
 
-    auto motor = m_turnMotor.get()->GetSpeedController();
-    auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-    fx->StopMotor();  
+    m_turnTalon->StopMotor();  
 }
 
 /// @brief run the drive motor at a specified speed
@@ -345,9 +423,9 @@ void SwerveModule::SetDriveSpeed( units::velocity::meters_per_second_t speed )
 {
     m_activeState.speed = ( abs(speed.to<double>()/m_maxVelocity.to<double>()) < 0.05 ) ? 0_mps : speed;
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("State Speed - mps"), m_activeState.speed.to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("Wheel Diameter - meters"), units::length::meter_t(m_wheelDiameter).to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("drive motor id"), m_driveMotor.get()->GetID() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("State Speed - mps"), m_activeState.speed.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("Wheel Diameter - meters"), units::length::meter_t(m_wheelDiameter).to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("drive motor id"), m_driveMotor.get()->GetID() );
 
     if (m_runClosedLoopDrive)
     {
@@ -370,30 +448,25 @@ void SwerveModule::SetTurnAngle( units::angle::degree_t targetAngle )
 {
     m_activeState.angle = targetAngle;
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("turn motor id"), m_turnMotor.get()->GetID() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("target angle"), targetAngle.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("turn motor id"), m_turnMotor.get()->GetID() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("target angle"), targetAngle.to<double>() );
 
-    auto currAngle  = units::angle::degree_t(m_turnSensor->GetAbsolutePosition());
+    auto sample     = GetSample();
+    auto currAngle  = sample.absoluteAngle;
     auto deltaAngle = AngleUtils::GetDeltaAngle(currAngle, targetAngle);
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("current angle"), currAngle.to<double>() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("delta angle"), deltaAngle.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("current angle"), currAngle.to<double>() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("delta angle"), deltaAngle.to<double>() );
 
     if ( abs(deltaAngle.to<double>()) > 1.0 )
     {
-        auto motor = m_turnMotor.get()->GetSpeedController();
-        auto fx = dynamic_cast<WPI_TalonFX*>(motor.get());
-        auto sensors = fx->GetSensorCollection();
-        //=============================================================================
-        // 5592 counts on the falcon for 76.729 degree change on the CANCoder (wheel)
-        //=============================================================================
-        double deltaTicks = (deltaAngle.to<double>() * 5592 / 76.729); 
-        double currentTicks = sensors.GetIntegratedSensorPosition();
+        double deltaTicks = deltaAngle.to<double>() * kTurnCountsPerDegree;
+        double currentTicks = sample.turnTicks;
         double desiredTicks = currentTicks + deltaTicks;
 
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("currentTicks"), currentTicks );
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("deltaTicks"), deltaTicks );
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, string("desiredTicks"), desiredTicks );
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("currentTicks"), currentTicks );
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("deltaTicks"), deltaTicks );
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, string("desiredTicks"), desiredTicks );
 
         m_turnMotor.get()->SetControlConstants(0, m_turnPositionControlData);
         m_turnMotor.get()->Set(desiredTicks);
@@ -410,8 +483,8 @@ void SwerveModule::SetTurnAngle( units::angle::degree_t targetAngle )
 /// @return void
 void SwerveModule::StopMotors()
 {
-    m_turnMotor.get()->GetSpeedController()->StopMotor();
-    m_driveMotor.get()->GetSpeedController()->StopMotor();
+    m_turnTalon->StopMotor();
+    m_driveTalon->StopMotor();
 }
 
 frc::Pose2d SwerveModule::GetCurrentPose(PoseEstimatorEnum opt)
@@ -424,8 +497,9 @@ frc::Pose2d SwerveModule::GetCurrentPose(PoseEstimatorEnum opt)
 
     // read sensor info (cancoder, encoders) for current speed and angle of the module
     // calculate the average from the last 
-    auto currentAngle   = units::angle::radian_t(units::angle::degree_t(m_turnSensor->GetPosition()));
-    auto currentRotations = m_driveMotor.get()->GetRotations();
+    auto sample         = GetSample();
+    auto currentAngle   = units::angle::radian_t(sample.angle);
+    auto currentRotations = sample.driveRotations;
 
     units::length::meter_t currentX {units::length::meter_t(0)};
     units::length::meter_t currentY {units::length::meter_t(0)};
@@ -444,16 +518,16 @@ frc::Pose2d SwerveModule::GetCurrentPose(PoseEstimatorEnum opt)
         currentX = startX + cos(startAngle.to<double>()) * circum;
         currentY = startY + sin(startAngle.to<double>()) * circum;
 
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "start rotations",startRotations);
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "current rotations",currentRotations);
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "delta", delta);
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "circumference", circum.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "start rotations",startRotations);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "current rotations",currentRotations);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "delta", delta);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "circumference", circum.to<double>());
 
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "WheelDiameter", m_wheelDiameter.to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "CurrentX", currentX.to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "CurrentY", currentY.to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "startX", startX.to<double>());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "startY", startY.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "WheelDiameter", m_wheelDiameter.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "CurrentX", currentX.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "CurrentY", currentY.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "startX", startX.to<double>());
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "startY", startY.to<double>());
     }
     else if (opt == PoseEstimatorEnum::POSE_EST_USING_MODULES)
     {
@@ -495,10 +569,10 @@ frc::Pose2d SwerveModule::GetCurrentPose(PoseEstimatorEnum opt)
     auto trans   = newpose - m_currentPose;
     m_currentPose = m_currentPose + trans;
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "NewPoseX", newpose.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "NewPoseY", newpose.Y().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "TransX", trans.X().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_nt, "TransY", trans.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "NewPoseX", newpose.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "NewPoseY", newpose.Y().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "TransX", trans.X().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, m_nt, "TransY", trans.Y().to<double>());
 
     m_currentRotations = currentRotations;
     return m_currentPose;
@@ -41,6 +41,7 @@
 #include <hw/DragonFalcon.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <mechanisms/controllers/ControlData.h>
+#include <RobotState.h>
 
 // Third Party Includes
 
@@ -101,6 +102,25 @@ class SwerveModule
         /// @returns SwerveModuleState
         frc::SwerveModuleState GetState() const;
 
+        /// @brief Read the module sensors (called once per cycle by the RobotStateMgr)
+        /// @param [out] SwerveModuleSample& sample:   sensor values for this module
+        /// @returns void
+        void Sample(SwerveModuleSample& sample) const;
+
+        /// @brief Convert a set of sensor values into a module state (speed of the wheel and angle of the wheel)
+        /// @param [in] const SwerveModuleSample& sample:   sensor values for this module
+        /// @returns SwerveModuleState
+        frc::SwerveModuleState CalcState(const SwerveModuleSample& sample) const;
+
+        /// @brief Send the sensors the odometry uses at the odometry rate
+        /// @param [in] uint8_t milliseconds:   status frame period
+        /// @returns void
+        void SetOdometryFramePeriod(uint8_t milliseconds);
+
+        /// @brief Move the CANCoder to the modeled steering angle (simulation only)
+        /// @returns SwerveModuleState  modeled wheel speed and angle
+        frc::SwerveModuleState UpdateSimulation();
+
         /// @brief Set the current state of the module (speed of the wheel and angle of the wheel)
         /// @param [in] const SwerveModuleState& referenceState:   state to set the module to
         /// @returns void
@@ -124,6 +144,9 @@ class SwerveModule
         );
         
     private:
+        // the desktop benchmarks (src/tools/cpp/benchmark) time Optimize directly
+        friend struct SwerveModuleBenchmark;
+
         // Note:  the following was taken from the WPI code and tweaked because we were seeing some weird 
         //        reversals that we believe was due to not using a tolerance
         frc::SwerveModuleState Optimize
@@ -132,6 +155,8 @@ class SwerveModule
             const frc::Rotation2d& currentAngle
         );
 
+        /// @brief This cycle's sensor values; read directly if no snapshot has been taken yet
+        SwerveModuleSample GetSample() const;
 
         void SetDriveSpeed( units::velocity::meters_per_second_t speed );
         void SetTurnAngle( units::angle::degree_t angle );
@@ -143,6 +168,12 @@ class SwerveModule
         std::shared_ptr<IDragonMotorController>             m_turnMotor;
         DragonCanCoder*                                     m_turnSensor;
 
+        // resolved once from the motors so the periodic code doesn't cast or copy shared_ptrs
+        ctre::phoenix::motorcontrol::can::WPI_TalonFX*          m_driveTalon;
+        ctre::phoenix::motorcontrol::can::WPI_TalonFX*          m_turnTalon;
+        ctre::phoenix::motorcontrol::TalonFXSensorCollection*   m_driveSensors;
+        ctre::phoenix::motorcontrol::TalonFXSensorCollection*   m_turnSensors;
+
         ControlData*                                        m_driveVelocityControlData;
         ControlData*                                        m_drivePercentControlData;
         ControlData*                                        m_turnPositionControlData;
@@ -160,4 +191,9 @@ class SwerveModule
 
         units::velocity::meters_per_second_t                m_maxVelocity;
         bool                                                m_runClosedLoopDrive;
+
+        // 5592 counts on the falcon for 76.729 degree change on the CANCoder (wheel); the SWERVE_TURN
+        // gearRatio in robot.xml must match (kTurnCountsPerDegree * 360 / 2048 = 12.8) so the simulation agrees
+        static constexpr double                             kTurnCountsPerDegree = 5592.0 / 76.729;
+        static constexpr double                             kTurnCountsPerRev = 2048.0;
 };
\ No newline at end of file
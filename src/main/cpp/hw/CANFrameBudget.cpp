@@ -0,0 +1,306 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/CANFrameBudget.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <ctre/phoenix/motorcontrol/StatusFrame.h>
+
+using namespace std;
+using namespace ctre::phoenix::motorcontrol;
+
+CANFrameBudget* CANFrameBudget::m_instance = nullptr;
+CANFrameBudget* CANFrameBudget::GetInstance()
+{
+    if ( CANFrameBudget::m_instance == nullptr )
+    {
+        CANFrameBudget::m_instance = new CANFrameBudget();
+    }
+    return CANFrameBudget::m_instance;
+}
+
+CANFrameBudget::CANFrameBudget() : m_buses(),
+                                   m_planned(false),
+                                   m_batchDepth(0),
+                                   m_changedBuses(),
+                                   m_mutex()
+{
+}
+
+void CANFrameBudget::Request
+(
+    const string&               canBusName,
+    const string&               device,
+    const string&               frame,
+    uint8_t                     milliseconds,
+    FRAME_PRIORITY              priority,
+    function<void(uint8_t)>     apply
+)
+{
+    Add(canBusName, FrameRequest{device, frame, milliseconds, milliseconds, 0, priority, apply});
+}
+
+void CANFrameBudget::AddDefault
+(
+    const string&               canBusName,
+    const string&               device,
+    const string&               frame,
+    uint8_t                     milliseconds,
+    FRAME_PRIORITY              priority,
+    function<void(uint8_t)>     apply
+)
+{
+    Add(canBusName, FrameRequest{device, frame, milliseconds, milliseconds, milliseconds, priority, apply});
+}
+
+void CANFrameBudget::Add
+(
+    const string&               canBusName,
+    FrameRequest                request
+)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    auto busName = canBusName.empty() ? string("rio") : canBusName;
+    auto& frames = m_buses[busName];
+    auto itr = find_if(frames.begin(), frames.end(), [&request](const FrameRequest& existing)
+                       { return existing.device == request.device && existing.frame == request.frame; });
+    if (itr != frames.end())
+    {
+        // an explicit (CRITICAL) request, like the odometry rate, stands until another explicit request
+        // replaces it; priority tables and mode profiles don't override it
+        if (itr->priority == CRITICAL && request.priority != CRITICAL)
+        {
+            return;
+        }
+
+        // a repeated request (e.g. the same profile applied again) doesn't need a new plan
+        if (itr->requested == request.requested && itr->priority == request.priority)
+        {
+            return;
+        }
+
+        // keep what the device has so only a real change is written
+        request.written = itr->written;
+        *itr = request;
+    }
+    else
+    {
+        frames.emplace_back(request);
+    }
+
+    m_changedBuses.insert(busName);
+    if (m_planned && m_batchDepth == 0)
+    {
+        Replan();
+    }
+}
+
+void CANFrameBudget::BeginBatch()
+{
+    lock_guard<mutex> lock(m_mutex);
+    ++m_batchDepth;
+}
+
+void CANFrameBudget::CommitBatch()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_batchDepth = max(m_batchDepth - 1, 0);
+    if (m_planned && m_batchDepth == 0)
+    {
+        Replan();
+    }
+}
+
+/// @brief  Re-plan the buses with changed requests (m_mutex must be held)
+void CANFrameBudget::Replan()
+{
+    for (auto& busName : m_changedBuses)
+    {
+        auto& frames = m_buses[busName];
+        for (auto& entry : frames)
+        {
+            entry.period = entry.requested;
+        }
+        auto relaxed = Relax(frames);
+        Write(frames);
+        if (relaxed > 0)
+        {
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::WARNING, string("CANFrameBudget"), busName, 
+                                         string("over budget after a frame period changed; relaxed ") + 
+                                         to_string(relaxed) + string(" frames"));
+        }
+    }
+    m_changedBuses.clear();
+}
+
+void CANFrameBudget::Plan()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    for (auto& [canBusName, frames] : m_buses)
+    {
+        Relax(frames);
+        Write(frames);
+        Report(canBusName, frames);
+    }
+    m_changedBuses.clear();
+    m_planned = true;
+}
+
+double CANFrameBudget::GetUtilization
+(
+    const string&               canBusName
+)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    auto itr = m_buses.find(canBusName.empty() ? string("rio") : canBusName);
+    return itr != m_buses.end() ? Utilization(itr->second, false) : 0.0;
+}
+
+double CANFrameBudget::Utilization
+(
+    const vector<FrameRequest>&     frames,
+    bool                            requested
+)
+{
+    double bits = 0.0;
+    for (auto& frame : frames)
+    {
+        auto period = requested ? frame.requested : frame.period;
+        if (period > 0)
+        {
+            bits += kBitsPerFrame * 1000.0 / period;
+        }
+    }
+    return bits / kBitsPerSecond;
+}
+
+/// @brief  Slow frames down, lowest priority first and the busiest frame of that priority first, until the
+///         bus is under the target or nothing else can be slowed down
+/// @returns int - number of frames that don't get their requested period
+int CANFrameBudget::Relax
+(
+    vector<FrameRequest>&       frames
+)
+{
+    for (auto priority : {LOW, MEDIUM, HIGH})
+    {
+        while (Utilization(frames, false) > kTargetUtilization)
+        {
+            FrameRequest* busiest = nullptr;
+            for (auto& frame : frames)
+            {
+                if (frame.priority == priority && frame.apply && frame.period > 0 && frame.period < kMaxPeriodMs &&
+                    (busiest == nullptr || frame.period < busiest->period))
+                {
+                    busiest = &frame;
+                }
+            }
+            if (busiest == nullptr)
+            {
+                break;
+            }
+            busiest->period = static_cast<uint8_t>(min(2 * static_cast<int>(busiest->period), static_cast<int>(kMaxPeriodMs)));
+        }
+    }
+
+    return static_cast<int>(count_if(frames.begin(), frames.end(), [](const FrameRequest& frame) { return frame.period != frame.requested; }));
+}
+
+void CANFrameBudget::Write
+(
+    vector<FrameRequest>&       frames
+)
+{
+    for (auto& frame : frames)
+    {
+        if (frame.apply && frame.period != frame.written)
+        {
+            frame.apply(frame.period);
+            frame.written = frame.period;
+        }
+    }
+}
+
+void CANFrameBudget::Report
+(
+    const string&                   canBusName,
+    const vector<FrameRequest>&     frames
+)
+{
+    auto logger = Logger::GetLogger();
+
+    char summary[96];
+    snprintf(summary, sizeof(summary), "requested %.0f%%, planned %.0f%% (target %.0f%%), %zu frames", 
+             100.0 * Utilization(frames, true), 100.0 * Utilization(frames, false), 100.0 * kTargetUtilization, frames.size());
+    auto planned = Utilization(frames, false);
+    logger->LogData(planned > kTargetUtilization ? LOGGER_LEVEL::WARNING : LOGGER_LEVEL::PRINT, string("CANFrameBudget"), canBusName, string(summary));
+
+    // one line per device: frame period (requested period if it was relaxed)
+    map<string, string> allocation;
+    for (auto& frame : frames)
+    {
+        auto& line = allocation[frame.device];
+        line += line.empty() ? string() : string(", ");
+        line += frame.frame + string(" ") + to_string(frame.period);
+        if (frame.period != frame.requested)
+        {
+            line += string(" (") + to_string(frame.requested) + string(")");
+        }
+    }
+    for (auto& [device, line] : allocation)
+    {
+        logger->LogData(LOGGER_LEVEL::PRINT, canBusName, device, line);
+    }
+}
+
+string CANFrameBudget::GetFrameName
+(
+    StatusFrameEnhanced     frame
+)
+{
+    switch (frame)
+    {
+        case StatusFrameEnhanced::Status_1_General:             return string("General");
+        case StatusFrameEnhanced::Status_2_Feedback0:           return string("Feedback0");
+        case StatusFrameEnhanced::Status_3_Quadrature:          return string("Quadrature");
+        case StatusFrameEnhanced::Status_4_AinTempVbat:         return string("AinTempVbat");
+        case StatusFrameEnhanced::Status_8_PulseWidth:          return string("PulseWidth");
+        case StatusFrameEnhanced::Status_10_Targets:            return string("Targets");
+        case StatusFrameEnhanced::Status_11_UartGadgeteer:      return string("UartGadgeteer");
+        case StatusFrameEnhanced::Status_12_Feedback1:          return string("Feedback1");
+        case StatusFrameEnhanced::Status_13_Base_PIDF0:         return string("PIDF0");
+        case StatusFrameEnhanced::Status_14_Turn_PIDF1:         return string("PIDF1");
+        case StatusFrameEnhanced::Status_15_FirmareApiStatus:   return string("FirmwareApi");
+        case StatusFrameEnhanced::Status_Brushless_Current:     return string("BrushlessCurrent");
+        default:                                                return to_string(static_cast<int>(frame));
+    }
+}
@@ -0,0 +1,164 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+#include <ctre/phoenix/motorcontrol/StatusFrame.h>
+
+/// @brief  Collects the status frame periods every CAN device asks for and plans them per CAN bus.
+///         While robot.xml is parsed the devices only register their frames here; Plan() then estimates
+///         each bus's utilization and, if a bus is over the target, stretches its lowest priority frames
+///         until it fits before anything is written.  The final allocation is logged at boot.
+///
+///         Frames requested after Plan() (e.g. the odometry rate changing) are written right away and
+///         their bus is re-planned.  A device that changes several frames at once wraps them in
+///         BeginBatch/CommitBatch so its bus is re-planned once; either way only the frames whose period
+///         changed are written.
+class CANFrameBudget
+{
+    public:
+        /// @brief  Order frames are relaxed in: LOW first, CRITICAL never
+        enum FRAME_PRIORITY
+        {
+            CRITICAL,
+            HIGH,
+            MEDIUM,
+            LOW
+        };
+
+        static CANFrameBudget* GetInstance();
+
+        /// @brief  Ask for a frame period.  A second request for the same device and frame replaces the first,
+        ///         except that only another CRITICAL request can replace a CRITICAL one.
+        /// @param [in] std::string                 canBusName - CAN bus the device is on ("" is the roboRIO bus)
+        /// @param [in] std::string                 device - name of the device in the report
+        /// @param [in] std::string                 frame - name of the frame in the report
+        /// @param [in] uint8_t                     milliseconds - requested period
+        /// @param [in] FRAME_PRIORITY              priority - how readily the frame can be slowed down
+        /// @param [in] std::function<void(uint8_t)> apply - writes a period to the device
+        void Request
+        (
+            const std::string&              canBusName,
+            const std::string&              device,
+            const std::string&              frame,
+            uint8_t                         milliseconds,
+            FRAME_PRIORITY                  priority,
+            std::function<void(uint8_t)>    apply
+        );
+
+        /// @brief  Count a frame the device already sends at this period (its factory default), so it is
+        ///         part of the estimate.  It is only written if the plan relaxes it.  apply may be empty
+        ///         for traffic that can't be changed (e.g. the control frames the roboRIO sends).
+        void AddDefault
+        (
+            const std::string&              canBusName,
+            const std::string&              device,
+            const std::string&              frame,
+            uint8_t                         milliseconds,
+            FRAME_PRIORITY                  priority,
+            std::function<void(uint8_t)>    apply
+        );
+
+        /// @brief  Relax any bus that is over the target, write every frame and log the allocation
+        void Plan();
+
+        /// @brief  Hold the re-planning of requests made after Plan() until CommitBatch (batches can nest)
+        void BeginBatch();
+
+        /// @brief  Re-plan the buses whose requests changed since BeginBatch and write the frames whose
+        ///         period changed
+        void CommitBatch();
+
+        /// @brief  Estimated utilization (0.0 to 1.0) of a bus with the planned periods
+        double GetUtilization
+        (
+            const std::string&              canBusName
+        );
+
+        static std::string GetFrameName
+        (
+            ctre::phoenix::motorcontrol::StatusFrameEnhanced    frame
+        );
+
+    private:
+        CANFrameBudget();
+        ~CANFrameBudget() = default;
+
+        struct FrameRequest
+        {
+            std::string                     device;
+            std::string                     frame;
+            uint8_t                         requested;  // what the device asked for
+            uint8_t                         period;     // what the plan gives it
+            uint8_t                         written;    // what the device has (0 if it hasn't been written)
+            FRAME_PRIORITY                  priority;
+            std::function<void(uint8_t)>    apply;
+        };
+
+        void Add
+        (
+            const std::string&              canBusName,
+            FrameRequest                    request
+        );
+        void Replan();
+        static double Utilization
+        (
+            const std::vector<FrameRequest>&    frames,
+            bool                                requested
+        );
+        static int Relax
+        (
+            std::vector<FrameRequest>&      frames
+        );
+        static void Write
+        (
+            std::vector<FrameRequest>&      frames
+        );
+        static void Report
+        (
+            const std::string&                  canBusName,
+            const std::vector<FrameRequest>&    frames
+        );
+
+        // Extended frame with 8 data bytes is 131 bits on the wire, plus a few for bit stuffing.  CANivore
+        // buses running CAN FD have more room than this assumes, so their estimate is conservative.
+        static constexpr double     kBitsPerFrame = 140.0;
+        static constexpr double     kBitsPerSecond = 1000000.0;
+        static constexpr double     kTargetUtilization = 0.70;
+        static constexpr uint8_t    kMaxPeriodMs = 255;
+
+        std::map<std::string, std::vector<FrameRequest>>   m_buses;
+        bool                                                m_planned;
+        int                                                 m_batchDepth;
+        std::set<std::string>                               m_changedBuses;     // waiting to be re-planned
+        std::mutex                                          m_mutex;
+
+        static CANFrameBudget*   m_instance;
+};
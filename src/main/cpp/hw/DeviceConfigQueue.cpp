@@ -0,0 +1,159 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// FRC includes
+#include <frc/Timer.h>
+
+// Team 302 includes
+#include <hw/DeviceConfigQueue.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+DeviceConfigQueue* DeviceConfigQueue::m_instance = nullptr;
+DeviceConfigQueue* DeviceConfigQueue::GetInstance()
+{
+    if ( DeviceConfigQueue::m_instance == nullptr )
+    {
+        DeviceConfigQueue::m_instance = new DeviceConfigQueue();
+    }
+    return DeviceConfigQueue::m_instance;
+}
+
+DeviceConfigQueue::DeviceConfigQueue() : m_buses(),
+                                         m_pending(),
+                                         m_requiredPending(0),
+                                         m_startTime(0.0),
+                                         m_mutex(),
+                                         m_done()
+{
+}
+
+void DeviceConfigQueue::Add
+(
+    IDragonMotorController*     device,
+    const string&               canBusName,
+    bool                        required,
+    function<void()>            apply
+)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if ( m_pending.empty() )
+    {
+        m_startTime = frc::Timer::GetFPGATimestamp().to<double>();
+    }
+    m_pending.insert(device);
+    if ( required )
+    {
+        ++m_requiredPending;
+    }
+
+    auto& bus = m_buses[canBusName];
+    auto& jobs = required ? bus.required : bus.optional;
+    jobs.push_back(Job{device, required, apply});
+
+    // workers exit when their bus runs dry, so start one if the bus is below its limit
+    if ( bus.workers < kWorkersPerBus )
+    {
+        ++bus.workers;
+        thread(&DeviceConfigQueue::RunWorker, this, canBusName).detach();
+    }
+}
+
+void DeviceConfigQueue::RunWorker
+(
+    string      canBusName
+)
+{
+    while ( true )
+    {
+        Job job;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            auto& bus = m_buses[canBusName];
+            auto& jobs = !bus.required.empty() ? bus.required : bus.optional;
+            if ( jobs.empty() )
+            {
+                --bus.workers;
+                return;
+            }
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        job.apply();
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_pending.erase(job.device);
+            if ( job.required )
+            {
+                --m_requiredPending;
+            }
+            if ( m_pending.empty() )
+            {
+                auto elapsed = frc::Timer::GetFPGATimestamp().to<double>() - m_startTime;
+                Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DeviceConfigQueue"), string("config time (s)"), elapsed);
+            }
+        }
+        m_done.notify_all();
+    }
+}
+
+void DeviceConfigQueue::WaitFor
+(
+    const IDragonMotorController*   device
+)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [this, device] { return m_pending.find(device) == m_pending.end(); });
+}
+
+void DeviceConfigQueue::WaitForRequired()
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_requiredPending == 0; });
+}
+
+void DeviceConfigQueue::WaitForAll()
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending.empty(); });
+}
+
+bool DeviceConfigQueue::IsComplete() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_pending.empty();
+}
+
+bool DeviceConfigQueue::IsConfigured
+(
+    const IDragonMotorController*   device
+) const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_pending.find(device) == m_pending.end();
+}
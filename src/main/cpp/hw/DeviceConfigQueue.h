@@ -0,0 +1,115 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+class IDragonMotorController;
+
+/// @brief  Writes motor controller configurations on worker threads while the rest of robot.xml is
+///         parsed.  Each CAN bus gets its own small pool of workers, so devices on different buses never
+///         wait on each other and one bus isn't flooded with config frames.  Jobs flagged required (the
+///         drive motors) run ahead of the others.
+///
+///         Code that writes to a queued device directly (instead of through its Dragon class, which
+///         waits on its own) must call WaitFor first.
+class DeviceConfigQueue
+{
+    public:
+        static DeviceConfigQueue* GetInstance();
+
+        /// @brief  Queue a device's configuration; a worker for its CAN bus starts on it right away
+        /// @param [in] IDragonMotorController*    device - the device being configured
+        /// @param [in] std::string                canBusName - CAN bus the device is on
+        /// @param [in] bool                       required - RobotInit can't finish without it
+        /// @param [in] std::function<void()>      apply - writes the configuration
+        void Add
+        (
+            IDragonMotorController*     device,
+            const std::string&          canBusName,
+            bool                        required,
+            std::function<void()>       apply
+        );
+
+        /// @brief  Block until the device's configuration is written (returns right away if it isn't queued)
+        void WaitFor
+        (
+            const IDragonMotorController*   device
+        );
+
+        /// @brief  Block until every required configuration is written
+        void WaitForRequired();
+
+        /// @brief  Block until every configuration is written
+        void WaitForAll();
+
+        /// @brief  true when nothing is queued or being written
+        bool IsComplete() const;
+
+        /// @brief  true when the device's configuration is written (or it was never queued); doesn't block
+        bool IsConfigured
+        (
+            const IDragonMotorController*   device
+        ) const;
+
+    private:
+        DeviceConfigQueue();
+        ~DeviceConfigQueue() = default;
+
+        struct Job
+        {
+            IDragonMotorController*     device;
+            bool                        required;
+            std::function<void()>       apply;
+        };
+
+        struct Bus
+        {
+            std::deque<Job>     required;
+            std::deque<Job>     optional;
+            int                 workers = 0;
+        };
+
+        void RunWorker
+        (
+            std::string     canBusName
+        );
+
+        static DeviceConfigQueue*   m_instance;
+
+        static constexpr int        kWorkersPerBus = 3;
+
+        std::map<std::string, Bus>                          m_buses;
+        std::unordered_set<const IDragonMotorController*>   m_pending;          // queued or being written
+        int                                                 m_requiredPending;
+        double                                              m_startTime;        // FPGA time of the first Add since the queue was last empty
+        mutable std::mutex                                  m_mutex;
+        std::condition_variable                             m_done;
+};
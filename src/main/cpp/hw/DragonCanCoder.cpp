@@ -17,6 +17,7 @@
 #include <string>
 
 #include <hw/DragonCanCoder.h>
+#include <hw/CANFrameBudget.h>
 #include <utils/Logger.h>
 
 #include <ctre/phoenix/sensors/WPI_CANCoder.h>
@@ -35,7 +36,10 @@ DragonCanCoder::DragonCanCoder
     bool                        reverse
 ) : WPI_CANCoder(canID, canBusName),
 	m_networkTableName(networkTableName),
-    m_usage(usage)
+    m_usage(usage),
+    m_canBusName(canBusName),
+    m_offset(offset),
+    m_reverse(reverse)
 {
     auto error = ConfigFactoryDefault(50);
     if ( error != ErrorCode::OKAY )
@@ -77,4 +81,36 @@ DragonCanCoder::DragonCanCoder
     {
         Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, networkTableName, string("ConfigVelocityMeasurementWindow"), to_string(error));
     }
+
+    auto budget = CANFrameBudget::GetInstance();
+    budget->AddDefault(canBusName, networkTableName, string("SensorData"), 10, CANFrameBudget::MEDIUM, 
+                       [this](uint8_t period) { SetStatusFramePeriod(CANCoderStatusFrame::CANCoderStatusFrame_SensorData, period, 0); });
+    budget->AddDefault(canBusName, networkTableName, string("VbatAndFaults"), 100, CANFrameBudget::LOW, 
+                       [this](uint8_t period) { SetStatusFramePeriod(CANCoderStatusFrame::CANCoderStatusFrame_VbatAndFaults, period, 0); });
+}
+
+void DragonCanCoder::SetSensorDataFramePeriod
+(
+    uint8_t     milliseconds
+)
+{
+    CANFrameBudget::GetInstance()->Request(m_canBusName, m_networkTableName, string("SensorData"), milliseconds, CANFrameBudget::CRITICAL, 
+                                           [this](uint8_t period) { SetStatusFramePeriod(CANCoderStatusFrame::CANCoderStatusFrame_SensorData, period, 0); });
+}
+
+/// @brief  Set the sensor to the modeled mechanism angle (simulation only).  The raw position is 
+///         before the magnet offset and sensor direction are applied, so back them out.
+/// @param [in] units::angle::degree_t                      angle:      mechanism angle
+/// @param [in] units::angular_velocity::degrees_per_second_t velocity: mechanism angular velocity
+void DragonCanCoder::SetSimAngle
+(
+    units::angle::degree_t                          angle,
+    units::angular_velocity::degrees_per_second_t   velocity
+)
+{
+    const double countsPerDegree = 4096.0 / 360.0;
+    double direction = m_reverse ? -1.0 : 1.0;
+    auto& sim = GetSimCollection();
+    sim.SetRawPosition(static_cast<int>(direction * (angle.to<double>() - m_offset) * countsPerDegree));
+    sim.SetVelocity(static_cast<int>(direction * velocity.to<double>() * countsPerDegree / 10.0));
 }
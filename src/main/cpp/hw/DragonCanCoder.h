@@ -17,6 +17,10 @@
 #pragma once
 
 #include <string>
+
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+
 #include <ctre/phoenix/sensors/WPI_CANCoder.h>
 
 class DragonCanCoder : public ctre::phoenix::sensors::WPI_CANCoder
@@ -34,9 +38,28 @@ class DragonCanCoder : public ctre::phoenix::sensors::WPI_CANCoder
 		virtual ~DragonCanCoder() = default;
         std::string GetUsage() const {return m_usage;};
 
+        /// @brief  Ask the CAN frame budget for a sensor data (position and velocity) period
+        /// @param [in] uint8_t milliseconds:   status frame period
+        void SetSensorDataFramePeriod
+        (
+            uint8_t     milliseconds
+        );
+
+        /// @brief  Set the sensor to the modeled mechanism angle (simulation only)
+        /// @param [in] units::angle::degree_t                      angle:      mechanism angle
+        /// @param [in] units::angular_velocity::degrees_per_second_t velocity: mechanism angular velocity
+        void SetSimAngle
+        (
+            units::angle::degree_t                          angle,
+            units::angular_velocity::degrees_per_second_t   velocity
+        );
+
 	private:
 		std::string						m_networkTableName;
 		std::string  				    m_usage;
+        std::string                     m_canBusName;
+        double                          m_offset;
+        bool                            m_reverse;
 };
 
 
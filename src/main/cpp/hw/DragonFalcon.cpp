@@ -26,15 +26,19 @@
 #include <frc/motorcontrol/MotorController.h>
 
 // Team 302 includes
+#include <hw/CANFrameBudget.h>
 #include <hw/DistanceAngleCalcStruc.h>
 #include <hw/interfaces/IDragonMotorController.h>
+#include <hw/DeviceConfigQueue.h>
 #include <hw/DragonFalcon.h>
 #include <hw/factories/PDPFactory.h>
 #include <hw/factories/DragonControlToCTREAdapterFactory.h>
 #include <hw/usages/MotorControllerUsage.h>
+#include <utils/InputRecorder.h>
 #include <utils/Logger.h>
 #include <utils/ConversionUtils.h>
 #include <hw/ctreadapters/DragonControlToCTREAdapter.h>
+#include <mechanisms/controllers/ControlData.h>
 
 // Third Party Includes
 #include <ctre/phoenix/motorcontrol/can/WPI_TalonFX.h>
@@ -58,192 +62,280 @@ DragonFalcon::DragonFalcon
 	MOTOR_TYPE 										motorType 
 ) : m_networkTableName(networkTableName),
 	m_talon( make_shared<WPI_TalonFX>(deviceID, canBusName)),
+	m_canBusName(canBusName),
+	m_sensors(&m_talon.get()->GetSensorCollection()),
 	m_controller(),
+	m_controlData(),
+	m_adapters(),
+	m_appliedConstants(),
 	m_type(deviceType),
 	m_id(deviceID),
 	m_pdp( pdpID ),
 	m_calcStruc(calcStruc),
-	m_motorType(motorType)
+	m_motorType(motorType),
+	m_config(),
+	m_configApplied(false),
+	m_neutralMode(NeutralMode::Brake)
 {
 	m_networkTableName += string(" - motor ");
 	m_networkTableName += to_string(deviceID);
 
-	m_controller[0] = DragonControlToCTREAdapterFactory::GetFactory()->CreatePercentOuptutAdapter(networkTableName, m_talon.get());
-	m_controller[0]->InitializeDefaults();
+	// the percent output adapter's peak and nominal outputs are part of m_config (ApplyConfig writes them
+	// with the rest); marking them applied keeps the adapter from writing them to the device now
+	ControlData percentOutput;
+	m_config.peakOutputForward = percentOutput.GetPeakValue();
+	m_config.peakOutputReverse = -1.0 * percentOutput.GetPeakValue();
+	m_config.nominalOutputForward = percentOutput.GetNominalValue();
+	m_config.nominalOutputReverse = -1.0 * percentOutput.GetNominalValue();
+	m_appliedConstants.peakNominalValid = true;
+	m_appliedConstants.peakValue = percentOutput.GetPeakValue();
+	m_appliedConstants.nominalValue = percentOutput.GetNominalValue();
+
+	m_controller[0] = DragonControlToCTREAdapterFactory::GetFactory()->CreatePercentOuptutAdapter(networkTableName, m_talon.get(), &m_appliedConstants);
 	for (auto i=1; i<4; ++i)
 	{
 		m_controller[i] = m_controller[0];
 	}
-	auto prompt = string("CTRE CAN motor controller ");
-	prompt += to_string(deviceID);
 
+	// count what the controller sends before anything is requested: the roboRIO's control frame and the 
+	// factory default general and feedback frames
+	auto budget = CANFrameBudget::GetInstance();
+	auto talon = m_talon;
+	budget->AddDefault( m_canBusName, m_networkTableName, string("Control"), 10, CANFrameBudget::CRITICAL, nullptr );
+	budget->AddDefault( m_canBusName, m_networkTableName, CANFrameBudget::GetFrameName(StatusFrameEnhanced::Status_1_General), 10, CANFrameBudget::MEDIUM, 
+						[talon](uint8_t period) { talon.get()->SetStatusFramePeriod( StatusFrameEnhanced::Status_1_General, period, 0 ); } );
+	budget->AddDefault( m_canBusName, m_networkTableName, CANFrameBudget::GetFrameName(StatusFrameEnhanced::Status_2_Feedback0), 20, CANFrameBudget::MEDIUM, 
+						[talon](uint8_t period) { talon.get()->SetStatusFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, period, 0 ); } );
+
+	// Nothing is sent to the device here.  The settings are collected in m_config (anything not set 
+	// here stays at its factory default), the factory adds the robot.xml settings and then ApplyConfig
+	// writes only what differs from the factory defaults.
+	m_config.neutralDeadband = 0.01;
+	m_config.voltageCompSaturation = 12.0;
+
+	m_config.supplyCurrLimit.enable = false;
+	m_config.supplyCurrLimit.currentLimit = 1.0;
+	m_config.supplyCurrLimit.triggerThresholdCurrent = 1.0;
+	m_config.supplyCurrLimit.triggerThresholdTime = 0.001;
+	m_config.statorCurrLimit.enable = false;
+	m_config.statorCurrLimit.currentLimit = 1.0;
+	m_config.statorCurrLimit.triggerThresholdCurrent = 1.0;
+	m_config.statorCurrLimit.triggerThresholdTime = 0.001;
+
+	m_config.forwardLimitSwitchSource = LimitSwitchSource::LimitSwitchSource_Deactivated;
+	m_config.forwardLimitSwitchNormal = LimitSwitchNormal::LimitSwitchNormal_Disabled;
+	m_config.reverseLimitSwitchSource = LimitSwitchSource::LimitSwitchSource_Deactivated;
+	m_config.reverseLimitSwitchNormal = LimitSwitchNormal::LimitSwitchNormal_Disabled;
+
+	m_config.forwardSoftLimitEnable = false;
+	m_config.forwardSoftLimitThreshold = 0.0;
+	m_config.reverseSoftLimitEnable = false;
+	m_config.reverseSoftLimitThreshold = 0.0;
+
+	m_config.motionAcceleration = 1500.0;
+	m_config.motionCruiseVelocity = 1500.0;
+	m_config.motionCurveStrength = 0;
+	m_config.motionProfileTrajectoryPeriod = 0;
+	m_config.trajectoryInterpolationEnable = true;
+
+	SlotConfiguration* slots[] = { &m_config.slot0, &m_config.slot1, &m_config.slot2, &m_config.slot3 };
+	for ( auto slot : slots )
+	{
+		slot->closedLoopPeakOutput = 1.0;
+		slot->closedLoopPeriod = 10;
+		slot->kP = 0.01;
+		slot->kI = 0.0;
+		slot->kD = 0.0;
+		slot->kF = 1.0;
+		slot->integralZone = 0.0;
+		slot->allowableClosedloopError = 0.0;
+	}
+
+	// the remote filters stay at their defaults (source off); the device ID doesn't matter while the source is off
+}
+
+/// @brief  Return the device to its factory defaults and write the settings collected in m_config that
+///         differ from them.  The factory queues this once, after applying the robot.xml settings; setters
+///         called after that wait for it and then write to the device right away.
+void DragonFalcon::ApplyConfig()
+{
+	auto talon = m_talon.get();
+	const int timeout = 50;
+	auto prompt = string("Dragon Falcon");
+	prompt += to_string(m_id);
 
-	SupplyCurrentLimitConfiguration climit;
-	climit.enable = false;
-	climit.currentLimit = 1.0;
-	climit.triggerThresholdCurrent = 1.0;
-	climit.triggerThresholdTime = 0.001;
-	auto error = m_talon.get()->ConfigSupplyCurrentLimit(climit, 50);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	StatorCurrentLimitConfiguration climit2;
-	climit2.enable = false;
-	climit2.currentLimit = 1.0;
-	climit2.triggerThresholdCurrent = 1.0;
-	climit2.triggerThresholdTime = 0.001;
-	error = m_talon.get()->ConfigStatorCurrentLimit( climit2, 50);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigStatorCurrentLimit"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-
-	error = m_talon.get()->ConfigVoltageCompSaturation(12.0, 0);
+	auto error = talon->ConfigFactoryDefault(timeout);
 	if ( error != ErrorCode::OKAY )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigVoltageCompSaturation"), string("error"));
-		error = ErrorCode::OKAY;
+		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigFactoryDefault"), string("error"));
 	}
+	talon->SetNeutralMode(m_neutralMode);
 
-	error = m_talon.get()->ConfigForwardLimitSwitchSource(LimitSwitchSource::LimitSwitchSource_Deactivated, LimitSwitchNormal::LimitSwitchNormal_Disabled, 0);
-	if ( error != ErrorCode::OKAY )
+	TalonFXConfiguration defaults;
+	auto written = 0;
+	auto skipped = 0;
+	auto apply = [&]( bool differs, const char* name, auto write )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigForwardLimitSwitchSource"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigReverseLimitSwitchSource(LimitSwitchSource::LimitSwitchSource_Deactivated, LimitSwitchNormal::LimitSwitchNormal_Disabled, 0);
-	if ( error != ErrorCode::OKAY )
+		if ( !differs )
+		{
+			++skipped;
+			return;
+		}
+		++written;
+		if ( write() != ErrorCode::OKAY )
+		{
+			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string(name), string("error"));
+		}
+	};
+
+	auto& cfg = m_config;
+	apply( cfg.neutralDeadband != defaults.neutralDeadband, "ConfigNeutralDeadband", 
+		   [&]() { return talon->ConfigNeutralDeadband(cfg.neutralDeadband, timeout); } );
+	apply( cfg.openloopRamp != defaults.openloopRamp, "ConfigOpenloopRamp", 
+		   [&]() { return talon->ConfigOpenloopRamp(cfg.openloopRamp, timeout); } );
+	apply( cfg.closedloopRamp != defaults.closedloopRamp, "ConfigClosedloopRamp", 
+		   [&]() { return talon->ConfigClosedloopRamp(cfg.closedloopRamp, timeout); } );
+	apply( cfg.peakOutputForward != defaults.peakOutputForward, "ConfigPeakOutputForward", 
+		   [&]() { return talon->ConfigPeakOutputForward(cfg.peakOutputForward, timeout); } );
+	apply( cfg.peakOutputReverse != defaults.peakOutputReverse, "ConfigPeakOutputReverse", 
+		   [&]() { return talon->ConfigPeakOutputReverse(cfg.peakOutputReverse, timeout); } );
+	apply( cfg.nominalOutputForward != defaults.nominalOutputForward, "ConfigNominalOutputForward", 
+		   [&]() { return talon->ConfigNominalOutputForward(cfg.nominalOutputForward, timeout); } );
+	apply( cfg.nominalOutputReverse != defaults.nominalOutputReverse, "ConfigNominalOutputReverse", 
+		   [&]() { return talon->ConfigNominalOutputReverse(cfg.nominalOutputReverse, timeout); } );
+	apply( cfg.voltageCompSaturation != defaults.voltageCompSaturation, "ConfigVoltageCompSaturation", 
+		   [&]() { return talon->ConfigVoltageCompSaturation(cfg.voltageCompSaturation, timeout); } );
+
+	apply( !IsSameLimit(cfg.supplyCurrLimit, defaults.supplyCurrLimit), "ConfigSupplyCurrentLimit", 
+		   [&]() { return talon->ConfigSupplyCurrentLimit(cfg.supplyCurrLimit, timeout); } );
+	apply( !IsSameLimit(cfg.statorCurrLimit, defaults.statorCurrLimit), "ConfigStatorCurrentLimit", 
+		   [&]() { return talon->ConfigStatorCurrentLimit(cfg.statorCurrLimit, timeout); } );
+
+	apply( cfg.forwardLimitSwitchSource != defaults.forwardLimitSwitchSource || cfg.forwardLimitSwitchNormal != defaults.forwardLimitSwitchNormal, 
+		   "ConfigForwardLimitSwitchSource", 
+		   [&]() { return talon->ConfigForwardLimitSwitchSource(cfg.forwardLimitSwitchSource, cfg.forwardLimitSwitchNormal, timeout); } );
+	apply( cfg.reverseLimitSwitchSource != defaults.reverseLimitSwitchSource || cfg.reverseLimitSwitchNormal != defaults.reverseLimitSwitchNormal, 
+		   "ConfigReverseLimitSwitchSource", 
+		   [&]() { return talon->ConfigReverseLimitSwitchSource(cfg.reverseLimitSwitchSource, cfg.reverseLimitSwitchNormal, timeout); } );
+	apply( cfg.forwardSoftLimitEnable != defaults.forwardSoftLimitEnable, "ConfigForwardSoftLimitEnable", 
+		   [&]() { return talon->ConfigForwardSoftLimitEnable(cfg.forwardSoftLimitEnable, timeout); } );
+	apply( cfg.forwardSoftLimitThreshold != defaults.forwardSoftLimitThreshold, "ConfigForwardSoftLimitThreshold", 
+		   [&]() { return talon->ConfigForwardSoftLimitThreshold(cfg.forwardSoftLimitThreshold, timeout); } );
+	apply( cfg.reverseSoftLimitEnable != defaults.reverseSoftLimitEnable, "ConfigReverseSoftLimitEnable", 
+		   [&]() { return talon->ConfigReverseSoftLimitEnable(cfg.reverseSoftLimitEnable, timeout); } );
+	apply( cfg.reverseSoftLimitThreshold != defaults.reverseSoftLimitThreshold, "ConfigReverseSoftLimitThreshold", 
+		   [&]() { return talon->ConfigReverseSoftLimitThreshold(cfg.reverseSoftLimitThreshold, timeout); } );
+
+	apply( cfg.motionAcceleration != defaults.motionAcceleration, "ConfigMotionAcceleration", 
+		   [&]() { return talon->ConfigMotionAcceleration(cfg.motionAcceleration, timeout); } );
+	apply( cfg.motionCruiseVelocity != defaults.motionCruiseVelocity, "ConfigMotionCruiseVelocity", 
+		   [&]() { return talon->ConfigMotionCruiseVelocity(cfg.motionCruiseVelocity, timeout); } );
+	apply( cfg.motionCurveStrength != defaults.motionCurveStrength, "ConfigMotionSCurveStrength", 
+		   [&]() { return talon->ConfigMotionSCurveStrength(cfg.motionCurveStrength, timeout); } );
+	apply( cfg.motionProfileTrajectoryPeriod != defaults.motionProfileTrajectoryPeriod, "ConfigMotionProfileTrajectoryPeriod", 
+		   [&]() { return talon->ConfigMotionProfileTrajectoryPeriod(cfg.motionProfileTrajectoryPeriod, timeout); } );
+	apply( cfg.trajectoryInterpolationEnable != defaults.trajectoryInterpolationEnable, "ConfigMotionProfileTrajectoryInterpolationEnable", 
+		   [&]() { return talon->ConfigMotionProfileTrajectoryInterpolationEnable(cfg.trajectoryInterpolationEnable, timeout); } );
+
+	apply( cfg.primaryPID.selectedFeedbackSensor != defaults.primaryPID.selectedFeedbackSensor, "ConfigSelectedFeedbackSensor", 
+		   [&]() { return talon->ConfigSelectedFeedbackSensor(cfg.primaryPID.selectedFeedbackSensor, 0, timeout); } );
+	apply( cfg.auxiliaryPID.selectedFeedbackSensor != defaults.auxiliaryPID.selectedFeedbackSensor, "ConfigSelectedFeedbackSensor", 
+		   [&]() { return talon->ConfigSelectedFeedbackSensor(cfg.auxiliaryPID.selectedFeedbackSensor, 1, timeout); } );
+	apply( cfg.initializationStrategy != defaults.initializationStrategy, "ConfigIntegratedSensorInitializationStrategy", 
+		   [&]() { return talon->ConfigIntegratedSensorInitializationStrategy(cfg.initializationStrategy, timeout); } );
+
+	const FilterConfiguration* filters[] = { &cfg.remoteFilter0, &cfg.remoteFilter1 };
+	const FilterConfiguration* defaultFilters[] = { &defaults.remoteFilter0, &defaults.remoteFilter1 };
+	for ( auto inx=0; inx<2; ++inx )
+	{
+		auto filter = filters[inx];
+		apply( filter->remoteSensorDeviceID != defaultFilters[inx]->remoteSensorDeviceID || filter->remoteSensorSource != defaultFilters[inx]->remoteSensorSource, 
+			   "ConfigRemoteFeedbackFilter", 
+			   [&]() { return talon->ConfigRemoteFeedbackFilter(filter->remoteSensorDeviceID, filter->remoteSensorSource, inx, timeout); } );
+	}
+
+	const SlotConfiguration* slots[] = { &cfg.slot0, &cfg.slot1, &cfg.slot2, &cfg.slot3 };
+	const SlotConfiguration* defaultSlots[] = { &defaults.slot0, &defaults.slot1, &defaults.slot2, &defaults.slot3 };
+	for ( auto inx=0; inx<4; ++inx )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigReverseLimitSwitchSource"), string("error"));
-		error = ErrorCode::OKAY;
+		auto slot = slots[inx];
+		auto def = defaultSlots[inx];
+		apply( slot->closedLoopPeakOutput != def->closedLoopPeakOutput, "ConfigClosedLoopPeakOutput", 
+			   [&]() { return talon->ConfigClosedLoopPeakOutput(inx, slot->closedLoopPeakOutput, timeout); } );
+		apply( slot->closedLoopPeriod != def->closedLoopPeriod, "ConfigClosedLoopPeriod", 
+			   [&]() { return talon->ConfigClosedLoopPeriod(inx, slot->closedLoopPeriod, timeout); } );
+		apply( slot->kP != def->kP, "Config_kP", [&]() { return talon->Config_kP(inx, slot->kP, timeout); } );
+		apply( slot->kI != def->kI, "Config_kI", [&]() { return talon->Config_kI(inx, slot->kI, timeout); } );
+		apply( slot->kD != def->kD, "Config_kD", [&]() { return talon->Config_kD(inx, slot->kD, timeout); } );
+		apply( slot->kF != def->kF, "Config_kF", [&]() { return talon->Config_kF(inx, slot->kF, timeout); } );
+		apply( slot->integralZone != def->integralZone, "Config_IntegralZone", 
+			   [&]() { return talon->Config_IntegralZone(inx, slot->integralZone, timeout); } );
+		apply( slot->allowableClosedloopError != def->allowableClosedloopError, "ConfigAllowableClosedloopError", 
+			   [&]() { return talon->ConfigAllowableClosedloopError(inx, slot->allowableClosedloopError, timeout); } );
 	}
 
-	error = m_talon.get()->ConfigForwardSoftLimitEnable(false, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigForwardSoftLimitEnable"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigForwardSoftLimitThreshold(0.0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigForwardSoftLimitThreshold"), string("error"));
-		error = ErrorCode::OKAY;
-	}
+	// factory defaults wiped the slots, so the next constants have to be written
+	m_appliedConstants.Invalidate();
+	m_appliedConstants.peakNominalValid = true;
+	m_appliedConstants.peakValue = cfg.peakOutputForward;
+	m_appliedConstants.nominalValue = cfg.nominalOutputForward;
+	m_configApplied = true;
 
-	error = m_talon.get()->ConfigReverseSoftLimitEnable(false, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigReverseSoftLimitEnable"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigReverseSoftLimitThreshold(0.0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigReverseSoftLimitThreshold"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	
-	
-	error = m_talon.get()->ConfigMotionAcceleration(1500.0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigMotionAcceleration"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigMotionCruiseVelocity(1500.0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigMotionCruiseVelocity"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigMotionSCurveStrength(0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigMotionSCurveStrength"), string("error"));
-		error = ErrorCode::OKAY;
-	}
+	Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_networkTableName, string("config writes"), written);
+	Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_networkTableName, string("config writes skipped"), skipped);
+}
 
-	error = m_talon.get()->ConfigMotionProfileTrajectoryPeriod(0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigMotionProfileTrajectoryPeriod"), string("error"));
-		error = ErrorCode::OKAY;
-	}
-	error = m_talon.get()->ConfigMotionProfileTrajectoryInterpolationEnable(true, 0);
-	if ( error != ErrorCode::OKAY )
+/// @brief  The configuration may be written by a DeviceConfigQueue worker; anything that changes it has 
+///         to wait until the worker is done with this falcon.
+void DragonFalcon::WaitForConfig()
+{
+	if ( !m_configApplied )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigMotionProfileTrajectoryInterpolationEnable"), string("error"));
-		error = ErrorCode::OKAY;
+		DeviceConfigQueue::GetInstance()->WaitFor(this);
 	}
+}
 
-	m_talon.get()->ConfigAllowableClosedloopError(0.0, 0);
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigAllowableClosedloopError"), string("error"));
-		error = ErrorCode::OKAY;
-	}
+bool DragonFalcon::IsSameLimit
+(
+	const SupplyCurrentLimitConfiguration&	limit1,
+	const SupplyCurrentLimitConfiguration&	limit2
+)
+{
+	return limit1.enable == limit2.enable && 
+		   limit1.currentLimit == limit2.currentLimit &&
+		   limit1.triggerThresholdCurrent == limit2.triggerThresholdCurrent &&
+		   limit1.triggerThresholdTime == limit2.triggerThresholdTime;
+}
 
-	for ( auto inx=0; inx<4; ++inx )
-	{
-		error = m_talon.get()->ConfigClosedLoopPeakOutput(inx, 1.0, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigClosedLoopPeakOutput"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->ConfigClosedLoopPeriod(inx, 10, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigClosedLoopPeriod"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->Config_kP(inx, 0.01, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("Config_kP"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->Config_kI(inx, 0.0, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("Config_kI"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->Config_kD(inx, 0.0, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("Config_kD"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->Config_kF(inx, 1.0, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("Config_kF"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-		error = m_talon.get()->Config_IntegralZone(inx, 0.0, 0);
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("Config_IntegralZone"), string("error"));
-			error = ErrorCode::OKAY;
-		}
-	}
+bool DragonFalcon::IsSameLimit
+(
+	const StatorCurrentLimitConfiguration&	limit1,
+	const StatorCurrentLimitConfiguration&	limit2
+)
+{
+	return limit1.enable == limit2.enable && 
+		   limit1.currentLimit == limit2.currentLimit &&
+		   limit1.triggerThresholdCurrent == limit2.triggerThresholdCurrent &&
+		   limit1.triggerThresholdTime == limit2.triggerThresholdTime;
+}
 
-	error = m_talon.get()->ConfigRemoteFeedbackFilter(60, RemoteSensorSource::RemoteSensorSource_Off, 0, 0);
-	if ( error != ErrorCode::OKAY )
+int DragonFalcon::WriteSupplyCurrentLimit
+(
+	int		timeoutMs
+)
+{
+	if ( !m_configApplied )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigRemoteFeedbackFilter"), string("error"));
-		error = ErrorCode::OKAY;
+		return ErrorCode::OKAY;		// ApplyConfig sends it
 	}
-	error = m_talon.get()->ConfigRemoteFeedbackFilter(60, RemoteSensorSource::RemoteSensorSource_Off, 1, 0);
+	auto error = m_talon.get()->ConfigSupplyCurrentLimit( m_config.supplyCurrLimit, timeoutMs );
 	if ( error != ErrorCode::OKAY )
 	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigRemoteFeedbackFilter"), string("error"));
+		auto prompt = string("Dragon Falcon");
+		prompt += to_string(m_id);
+		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
 	}
+	return error;
 }
 
 double DragonFalcon::GetRotations() const
@@ -285,7 +377,20 @@ void DragonFalcon::UpdateFramePeriods
 	uint8_t												milliseconds
 )
 {
-	m_talon.get()->SetStatusFramePeriod( frame, milliseconds, 0 );
+	RequestFramePeriod( frame, milliseconds, CANFrameBudget::CRITICAL );
+}
+
+/// @brief  Hand a frame period to the CAN frame budget, which writes it once the bus is planned
+void DragonFalcon::RequestFramePeriod
+(
+	StatusFrameEnhanced				frame,
+	uint8_t							milliseconds,
+	CANFrameBudget::FRAME_PRIORITY	priority
+)
+{
+	auto talon = m_talon;
+	CANFrameBudget::GetInstance()->Request( m_canBusName, m_networkTableName, CANFrameBudget::GetFrameName(frame), milliseconds, priority,
+											[talon, frame](uint8_t period) { talon.get()->SetStatusFramePeriod( frame, period, 0 ); } );
 }
 
 void DragonFalcon::SetFramePeriodPriority
@@ -293,61 +398,72 @@ void DragonFalcon::SetFramePeriodPriority
 	MOTOR_PRIORITY              priority
 )
 {
+	// the general and feedback frames keep the motor's priority; the rest are diagnostics, so they are the
+	// first to be slowed down when the bus is over budget
+	auto controlPriority = priority == HIGH ? CANFrameBudget::HIGH : (priority == MEDIUM ? CANFrameBudget::MEDIUM : CANFrameBudget::LOW);
+
+	// re-plan the bus once for the whole profile instead of once per frame
+	auto budget = CANFrameBudget::GetInstance();
+	budget->BeginBatch();
+
 	switch ( priority )
 	{
 		case HIGH:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 10 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 20 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 100 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 10, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 20, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 100, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		case MEDIUM:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 60 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 60, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 120, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		case LOW:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 120, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 200, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		default:
 		break;
 
 	}
+
+	budget->CommitBatch();
 }
 
 void DragonFalcon::Set(double value)
 {
+	InputRecorder::GetInstance()->RecordOutput(m_id, value);
 	m_controller[0]->Set(value);
 }
 
@@ -359,6 +475,17 @@ void DragonFalcon::SetRotationOffset(double rotations)
 
 void DragonFalcon::SetVoltageRamping(double ramping, double rampingClosedLoop)
 {
+	WaitForConfig();
+	m_config.openloopRamp = ramping;
+	if (rampingClosedLoop >= 0)
+	{
+		m_config.closedloopRamp = rampingClosedLoop;
+	}
+	if ( !m_configApplied )
+	{
+		return;		// ApplyConfig sends them
+	}
+
 	auto prompt = string("Dragon Falcon");
 	prompt += to_string(m_talon.get()->GetDeviceID());
     auto error = m_talon.get()->ConfigOpenloopRamp(ramping);
@@ -379,26 +506,20 @@ void DragonFalcon::SetVoltageRamping(double ramping, double rampingClosedLoop)
 
 void DragonFalcon::EnableCurrentLimiting(bool enabled)
 {
-	SupplyCurrentLimitConfiguration limit;
-	auto prompt = string("Dragon Falcon");
-	prompt += to_string(m_talon.get()->GetDeviceID());
-	int timeout = 50.0;
-	auto error = m_talon.get()->ConfigGetSupplyCurrentLimit( limit, timeout );
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigGetSupplyCurrentLimit"), string("error"));
-	}
-	limit.enable = enabled;
-	error = m_talon.get()->ConfigSupplyCurrentLimit( limit, timeout );
-	if ( error != ErrorCode::OKAY )
-	{
-		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
-	}
+	WaitForConfig();
+	// m_config already holds what the device has, so there is no need to read the limit back first
+	m_config.supplyCurrLimit.enable = enabled;
+	WriteSupplyCurrentLimit(50);
 }
 
 void DragonFalcon::EnableBrakeMode(bool enabled)
 {
-    m_talon.get()->SetNeutralMode(enabled ? ctre::phoenix::motorcontrol::NeutralMode::Brake : ctre::phoenix::motorcontrol::NeutralMode::Coast);
+	WaitForConfig();
+	m_neutralMode = enabled ? NeutralMode::Brake : NeutralMode::Coast;
+	if ( m_configApplied )
+	{
+		m_talon.get()->SetNeutralMode(m_neutralMode);
+	}
 }
 
 void DragonFalcon::Invert(bool inverted)
@@ -432,7 +553,12 @@ void DragonFalcon::SelectClosedLoopProfile
 	int    pidIndex			// <I> - 0 for primary closed loop, 1 for cascaded closed-loop
 )
 {
+	WaitForConfig();
 	auto error = m_talon.get()->SelectProfileSlot( slot, pidIndex );
+	if ( pidIndex == 0 )
+	{
+		m_appliedConstants.selectedSlot = slot;
+	}
 	if ( error != ErrorCode::OKAY )
 	{
 		auto prompt = string("Dragon Falcon");
@@ -448,10 +574,17 @@ int DragonFalcon::ConfigSelectedFeedbackSensor
 	int timeoutMs
 )
 {
+	WaitForConfig();
 	int error = 0;
 	if ( m_talon.get() != nullptr )
 	{
-		error = m_talon.get()->ConfigSelectedFeedbackSensor( feedbackDevice, pidIdx, timeoutMs );
+		auto sensor = static_cast<TalonFXFeedbackDevice>(feedbackDevice);
+		auto& pidSet = pidIdx == 0 ? m_config.primaryPID : m_config.auxiliaryPID;
+		pidSet.selectedFeedbackSensor = sensor;
+		if ( m_configApplied )
+		{
+			error = m_talon.get()->ConfigSelectedFeedbackSensor( feedbackDevice, pidIdx, timeoutMs );
+		}
 	}
 	else
 	{
@@ -462,6 +595,22 @@ int DragonFalcon::ConfigSelectedFeedbackSensor
 	return error;
 }
 
+int DragonFalcon::ConfigIntegratedSensorInitializationStrategy
+(
+	sensors::SensorInitializationStrategy	strategy,
+	int 									timeoutMs
+)
+{
+	WaitForConfig();
+	int error = 0;
+	m_config.initializationStrategy = strategy;
+	if ( m_configApplied )
+	{
+		error = m_talon.get()->ConfigIntegratedSensorInitializationStrategy( strategy, timeoutMs );
+	}
+	return error;
+}
+
 int DragonFalcon::ConfigSelectedFeedbackSensor
 (
 	RemoteFeedbackDevice feedbackDevice,
@@ -469,6 +618,7 @@ int DragonFalcon::ConfigSelectedFeedbackSensor
 	int timeoutMs
 )
 {
+	WaitForConfig();
 	int error = 0;
 	if ( m_talon.get() != nullptr )
 	{
@@ -489,30 +639,17 @@ int DragonFalcon::ConfigPeakCurrentLimit
 	int timeoutMs
 )
 {
-	int ierror = 0;
+	WaitForConfig();
 	if ( m_talon.get() != nullptr )
 	{
-		auto prompt = string("Dragon Falcon");
-		prompt += to_string(m_talon.get()->GetDeviceID());
-		SupplyCurrentLimitConfiguration limit;
-		auto error = m_talon.get()->ConfigGetSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigGetSupplyCurrentLimit"), string("error"));
-		}
-		limit.triggerThresholdCurrent = amps;
-		error = m_talon.get()->ConfigSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
-		}
-		ierror = error;
+		m_config.supplyCurrLimit.triggerThresholdCurrent = amps;
+		return WriteSupplyCurrentLimit(timeoutMs);
 	}
 	else
 	{
         Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonFalcon"), string("DragonFalcon::ConfigPeakCurrentLimit"), string("m_talon is a nullptr"));
 	}
-	return ierror;
+	return 0;
 }
 
 int DragonFalcon::ConfigPeakCurrentDuration
@@ -521,29 +658,17 @@ int DragonFalcon::ConfigPeakCurrentDuration
 	int timeoutMs
 )
 {
-	int error = 0;
+	WaitForConfig();
 	if ( m_talon.get() != nullptr )
 	{
-		auto prompt = string("Dragon Falcon");
-		prompt += to_string(m_talon.get()->GetDeviceID());
-		SupplyCurrentLimitConfiguration limit;
-		auto error = m_talon.get()->ConfigGetSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigGetSupplyCurrentLimit"), string("error"));
-		}
-		limit.triggerThresholdTime = milliseconds;
-		error = m_talon.get()->ConfigSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
-		}
+		m_config.supplyCurrLimit.triggerThresholdTime = milliseconds;
+		return WriteSupplyCurrentLimit(timeoutMs);
 	}
 	else
 	{
         Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonFalcon"), string("ConfigPeakCurrentDuration"), string("m_talon is a nullptr"));
 	}
-	return error;
+	return 0;
 }
 
 int DragonFalcon::ConfigContinuousCurrentLimit
@@ -552,29 +677,17 @@ int DragonFalcon::ConfigContinuousCurrentLimit
 	int timeoutMs
 )
 {
-	int error = 0;
+	WaitForConfig();
 	if ( m_talon.get() != nullptr )
 	{
-		auto prompt = string("Dragon Falcon");
-		prompt += to_string(m_talon.get()->GetDeviceID());
-		SupplyCurrentLimitConfiguration limit;
-		auto error = m_talon.get()->ConfigGetSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigGetSupplyCurrentLimit"), string("error"));
-		}
-		limit.currentLimit = amps;
-		error = m_talon.get()->ConfigSupplyCurrentLimit( limit, timeoutMs );
-		if ( error != ErrorCode::OKAY )
-		{
-			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, prompt, string("ConfigSupplyCurrentLimit"), string("error"));
-		}
+		m_config.supplyCurrLimit.currentLimit = amps;
+		return WriteSupplyCurrentLimit(timeoutMs);
 	}
 	else
 	{
         Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonFalcon"), string("ConfigContinuousCurrentLimit"), string("m_talon is a nullptr"));
 	}
-	return error;
+	return 0;
 }
 
 void DragonFalcon::SetAsFollowerMotor
@@ -592,8 +705,34 @@ void DragonFalcon::SetAsFollowerMotor
 /// @return void
 void DragonFalcon::SetControlConstants(int slot, ControlData* controlInfo)
 {
-	delete m_controller[slot];
-	m_controller[slot] = DragonControlToCTREAdapterFactory::GetFactory()->CreateAdapter(m_networkTableName, slot, controlInfo, m_calcStruc, m_talon.get());
+	WaitForConfig();
+	if ( slot < 0 || slot >= CTREAppliedConstants::NUM_SLOTS || controlInfo == nullptr )
+	{
+		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, m_networkTableName, string("SetControlConstants"), string("invalid slot or control data"));
+		return;
+	}
+
+	// already running with this control data, so there is nothing to send
+	if ( m_controlData[slot] == controlInfo )
+	{
+		return;
+	}
+
+	// adapters are built once per control data; switching back to one only re-sends constants the
+	// device doesn't already have (the adapter checks against m_appliedConstants)
+	auto key = make_pair(slot, controlInfo);
+	auto itr = m_adapters.find(key);
+	if ( itr == m_adapters.end() )
+	{
+		auto adapter = DragonControlToCTREAdapterFactory::GetFactory()->CreateAdapter(m_networkTableName, slot, controlInfo, m_calcStruc, m_talon.get(), &m_appliedConstants);
+		itr = m_adapters.insert(make_pair(key, adapter)).first;
+	}
+	else
+	{
+		itr->second->SetControlConstants(slot, controlInfo);
+	}
+	m_controller[slot] = itr->second;
+	m_controlData[slot] = controlInfo;
 }
 
 
@@ -602,7 +741,14 @@ void DragonFalcon::SetForwardLimitSwitch
 	bool normallyOpen
 )
 {
+	WaitForConfig();
 	LimitSwitchNormal type = normallyOpen ? LimitSwitchNormal::LimitSwitchNormal_NormallyOpen : LimitSwitchNormal::LimitSwitchNormal_NormallyClosed;
+	m_config.forwardLimitSwitchSource = LimitSwitchSource::LimitSwitchSource_FeedbackConnector;
+	m_config.forwardLimitSwitchNormal = type;
+	if ( !m_configApplied )
+	{
+		return;		// ApplyConfig sends it
+	}
 	auto error = m_talon.get()->ConfigForwardLimitSwitchSource( LimitSwitchSource::LimitSwitchSource_FeedbackConnector, type, 0  );
 	if ( error != ErrorCode::OKAY )
 	{
@@ -619,7 +765,14 @@ void DragonFalcon::SetReverseLimitSwitch
 	bool normallyOpen
 )
 {
+	WaitForConfig();
 	LimitSwitchNormal type = normallyOpen ? LimitSwitchNormal::LimitSwitchNormal_NormallyOpen : LimitSwitchNormal::LimitSwitchNormal_NormallyClosed;
+	m_config.reverseLimitSwitchSource = LimitSwitchSource::LimitSwitchSource_FeedbackConnector;
+	m_config.reverseLimitSwitchNormal = type;
+	if ( !m_configApplied )
+	{
+		return;		// ApplyConfig sends it
+	}
 	auto error = m_talon.get()->ConfigReverseLimitSwitchSource( LimitSwitchSource::LimitSwitchSource_FeedbackConnector, type, 0  );
 	if ( error != ErrorCode::OKAY )
 	{
@@ -633,6 +786,7 @@ void DragonFalcon::SetRemoteSensor
     ctre::phoenix::motorcontrol::RemoteSensorSource deviceType
 )
 {
+	WaitForConfig();
 	auto error = m_talon.get()->ConfigRemoteFeedbackFilter( canID, deviceType, 0, 0.0 );
 	if ( error != ErrorCode::OKAY )
 	{
@@ -663,15 +817,13 @@ void DragonFalcon::SetVoltage
 
 bool DragonFalcon::IsForwardLimitSwitchClosed() const
 {
-	auto sensors = m_talon.get()->GetSensorCollection();
-	auto closed = sensors.IsFwdLimitSwitchClosed();
+	auto closed = m_sensors->IsFwdLimitSwitchClosed();
 	return closed == 1;
 }
 
 bool DragonFalcon::IsReverseLimitSwitchClosed() const
 {
-	auto sensors = m_talon.get()->GetSensorCollection();
-	auto closed = sensors.IsRevLimitSwitchClosed();
+	auto closed = m_sensors->IsRevLimitSwitchClosed();
 	return closed == 1;
 }
 
@@ -685,7 +837,12 @@ void DragonFalcon::EnableDisableLimitSwitches
 
 void DragonFalcon::EnableVoltageCompensation( double fullvoltage) 
 {
-	m_talon.get()->ConfigVoltageCompSaturation(fullvoltage);
+	WaitForConfig();
+	m_config.voltageCompSaturation = fullvoltage;
+	if ( m_configApplied )
+	{
+		m_talon.get()->ConfigVoltageCompSaturation(fullvoltage);
+	}
 	m_talon.get()->EnableVoltageCompensation(true);
 }
 
@@ -725,3 +882,32 @@ IDragonMotorController::MOTOR_TYPE DragonFalcon::GetMotorType() const
 {
 	return m_motorType;
 }
+
+/// @brief  Return the voltage the controller is driving the motor with (simulation only)
+/// @return units::volt_t - motor output voltage
+units::volt_t DragonFalcon::GetSimOutputVoltage() const
+{
+	return units::volt_t(m_talon.get()->GetSimCollection().GetMotorOutputLeadVoltage());
+}
+
+/// @brief  Feed the modeled motor state back into the controller's sensors (simulation only).
+///         The sim collection works in the motor's frame, so inversion is still applied by the talon.
+/// @param [in] units::volt_t       busVoltage - battery voltage at the controller
+/// @param [in] double              motorRotations - motor shaft revolutions (before the gear ratio)
+/// @param [in] double              motorRPS - motor shaft revolutions per second (before the gear ratio)
+/// @param [in] units::ampere_t     current - current the motor is drawing
+/// @return void
+void DragonFalcon::SetSimState
+(
+	units::volt_t       busVoltage,
+	double              motorRotations,
+	double              motorRPS,
+	units::ampere_t     current
+)
+{
+	auto& sim = m_talon.get()->GetSimCollection();
+	sim.SetBusVoltage(busVoltage.to<double>());
+	sim.SetIntegratedSensorRawPosition(static_cast<int>(ConversionUtils::RevolutionsToCounts(motorRotations, m_calcStruc.countsPerRev)));
+	sim.SetIntegratedSensorVelocity(static_cast<int>(ConversionUtils::RPSToCounts100ms(motorRPS, m_calcStruc.countsPerRev)));
+	sim.SetSupplyCurrent(current.to<double>());
+}
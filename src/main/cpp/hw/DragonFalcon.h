@@ -19,14 +19,19 @@
 #pragma once
 
 // C++ Includes
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 // FRC includes
 #include <frc/motorcontrol/MotorController.h>
 
 // Team 302 includes
+#include <hw/CANFrameBudget.h>
 #include <hw/DistanceAngleCalcStruc.h>
+#include <hw/ctreadapters/CTREAppliedConstants.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <hw/usages/MotorControllerUsage.h>
 
@@ -34,6 +39,8 @@
 // Third Party Includes
 #include <ctre/phoenix/motorcontrol/can/WPI_TalonFX.h>
 #include <ctre/phoenix/motorcontrol/RemoteSensorSource.h>
+#include <ctre/phoenix/motorcontrol/StatorCurrentLimitConfiguration.h>
+#include <ctre/phoenix/motorcontrol/SupplyCurrentLimitConfiguration.h>
 
 class IDragonControlToVendorControlAdapter;
 
@@ -54,6 +61,12 @@ class DragonFalcon : public IDragonMotorController
         );
         virtual ~DragonFalcon() = default;
 
+        /// @brief  Write the configuration collected since construction to the device in one pass, 
+        ///         skipping settings that are already at their factory default.  The factory calls it 
+        ///         once after applying the robot.xml settings; setters called before it only update 
+        ///         the configuration.
+        void ApplyConfig();
+
 
         // Getters (override)
         double GetRotations() const override;
@@ -61,6 +74,8 @@ class DragonFalcon : public IDragonMotorController
         MotorControllerUsage::MOTOR_CONTROLLER_USAGE GetType() const override;
         int GetID() const override;
         std::shared_ptr<frc::MotorController> GetSpeedController() const override;
+        ctre::phoenix::motorcontrol::can::WPI_TalonFX* GetTalonFX() const override { return m_talon.get(); }
+        ctre::phoenix::motorcontrol::TalonFXSensorCollection* GetIntegratedSensor() const override { return m_sensors; }
         double GetCurrent() const override;
         IDragonMotorController::MOTOR_TYPE GetMotorType() const override;
 
@@ -97,6 +112,14 @@ class DragonFalcon : public IDragonMotorController
             int pidIdx, 
             int timeoutMs
         ); 
+
+        /// @brief  How the integrated sensor position is set when the falcon boots.  Like the other Config 
+        ///         methods this is part of the configuration ApplyConfig writes after the factory defaults.
+        int ConfigIntegratedSensorInitializationStrategy
+        (
+            ctre::phoenix::sensors::SensorInitializationStrategy    strategy,
+            int                                                     timeoutMs
+        );
         int ConfigPeakCurrentLimit(int amps, int timeoutMs); 
         int ConfigPeakCurrentDuration(int milliseconds, int timeoutMs); 
         int ConfigContinuousCurrentLimit(int amps, int timeoutMs); 
@@ -149,14 +172,53 @@ class DragonFalcon : public IDragonMotorController
         (
             bool enable
         ) override;
+
+        units::volt_t GetSimOutputVoltage() const override;
+        void SetSimState
+        (
+            units::volt_t       busVoltage,
+            double              motorRotations,
+            double              motorRPS,
+            units::ampere_t     current
+        ) override;
     private:
+        static bool IsSameLimit
+        (
+            const ctre::phoenix::motorcontrol::SupplyCurrentLimitConfiguration&    limit1,
+            const ctre::phoenix::motorcontrol::SupplyCurrentLimitConfiguration&    limit2
+        );
+        static bool IsSameLimit
+        (
+            const ctre::phoenix::motorcontrol::StatorCurrentLimitConfiguration&    limit1,
+            const ctre::phoenix::motorcontrol::StatorCurrentLimitConfiguration&    limit2
+        );
+        int WriteSupplyCurrentLimit
+        (
+            int     timeoutMs
+        );
+        void WaitForConfig();
+        void RequestFramePeriod
+        (
+            ctre::phoenix::motorcontrol::StatusFrameEnhanced    frame,
+            uint8_t                                             milliseconds,
+            CANFrameBudget::FRAME_PRIORITY                      priority
+        );
+
         std::string                                                         m_networkTableName;
         std::shared_ptr<ctre::phoenix::motorcontrol::can::WPI_TalonFX>      m_talon;
+        std::string                                                         m_canBusName;
+        ctre::phoenix::motorcontrol::TalonFXSensorCollection*               m_sensors;
         IDragonControlToVendorControlAdapter*                               m_controller[4];
+        ControlData*                                                        m_controlData[4];
+        std::map<std::pair<int, ControlData*>, IDragonControlToVendorControlAdapter*> m_adapters;
+        CTREAppliedConstants                                                m_appliedConstants;
         MotorControllerUsage::MOTOR_CONTROLLER_USAGE                        m_type;
         int                                                                 m_id;
         int                                                                 m_pdp;
         DistanceAngleCalcStruc                                              m_calcStruc;
         IDragonMotorController::MOTOR_TYPE                                  m_motorType;
+        ctre::phoenix::motorcontrol::can::TalonFXConfiguration              m_config;           // what the device should have (and has once m_configApplied)
+        std::atomic<bool>                                                   m_configApplied;
+        ctre::phoenix::motorcontrol::NeutralMode                            m_neutralMode;      // not part of the configuration, so ApplyConfig sends it separately
 };
 
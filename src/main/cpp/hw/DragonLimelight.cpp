@@ -20,6 +20,10 @@
 #include <cmath>
 
 // FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
+#include <frc/geometry/Translation2d.h>
+#include <frc/Timer.h>
 #include <networktables/NetworkTableInstance.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
@@ -57,9 +61,57 @@ DragonLimelight::DragonLimelight
     m_rotation(rotation),
     m_mountingAngle( mountingAngle ),
     m_targetHeight( targetHeight ),
-    m_targetHeight2( targetHeight2 )
+    m_targetHeight2( targetHeight2 ),
+    m_tv( m_networktable.get()->GetEntry("tv") ),
+    m_tx( m_networktable.get()->GetEntry("tx") ),
+    m_ty( m_networktable.get()->GetEntry("ty") ),
+    m_ta( m_networktable.get()->GetEntry("ta") ),
+    m_ts( m_networktable.get()->GetEntry("ts") ),
+    m_tl( m_networktable.get()->GetEntry("tl") ),
+    m_listener( 0 ),
+    m_frameCount( 0 ),
+    m_observation()
 {
     //SetLEDMode( DragonLimelight::LED_MODE::LED_OFF);
+
+    // the limelight updates tl every frame, so use it as the "new frame" event
+    m_listener = m_tl.AddListener( [this](const EntryNotification& event) { OnFrame(event); }, 
+                                   NT_NOTIFY_NEW | NT_NOTIFY_UPDATE );
+}
+
+///-----------------------------------------------------------------------------------
+/// Method:         ~DragonLimelight (destructor)
+/// Description:    Stop listening for frames
+///-----------------------------------------------------------------------------------
+DragonLimelight::~DragonLimelight()
+{
+    m_tl.RemoveListener( m_listener );
+}
+
+/// @brief  Network table listener callback; runs on the network table thread each time tl updates
+void DragonLimelight::OnFrame
+(
+    const EntryNotification&    event
+)
+{
+    auto tx = units::angle::degree_t(m_tx.GetDouble(0.0));
+    auto ty = units::angle::degree_t(m_ty.GetDouble(0.0));
+    units::time::second_t latency = units::time::millisecond_t(m_tl.GetDouble(0.0)) + m_imageCaptureLatency;
+
+    // network table timestamps are FPGA time on the roboRIO
+    units::time::second_t received = event.value.get() != nullptr ? units::time::microsecond_t(static_cast<double>(event.value->last_change())) :
+                                                                    frc::Timer::GetFPGATimestamp();
+
+    TargetObservation observation;
+    observation.valid            = true;
+    observation.hasTarget        = m_tv.GetDouble(0.0) > 0.1;
+    observation.horizontalOffset = CalcHorizontalOffset(tx, ty);
+    observation.verticalOffset   = CalcVerticalOffset(tx, ty);
+    observation.area             = m_ta.GetDouble(0.0);
+    observation.latency          = latency;
+    observation.timestamp        = received - latency;
+    observation.frameId          = ++m_frameCount;
+    m_observation.Store(observation);
 }
 
 std::vector<double> DragonLimelight::Get3DSolve() const
@@ -70,106 +122,133 @@ std::vector<double> DragonLimelight::Get3DSolve() const
 
 bool DragonLimelight::HasTarget() const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
-    {
-        return ( nt->GetNumber("tv", 0.0) > 0.1 );
-    }
-    return false;
+    return GetObservation().hasTarget;
 }
 
-units::angle::degree_t DragonLimelight::GetTx() const
+units::angle::degree_t DragonLimelight::GetTargetHorizontalOffset() const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
-    {
-        return units::angle::degree_t(nt->GetNumber("tx", 0.0));
-    }
-    return units::angle::degree_t(0.0);
+    return GetObservation().horizontalOffset;
 }
- 
-units::angle::degree_t DragonLimelight::GetTy() const
+
+units::angle::degree_t DragonLimelight::GetTargetVerticalOffset() const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
-    {
-        return units::angle::degree_t(nt->GetNumber("ty", 0.0));
-    }
-    return units::angle::degree_t(0.0);
+    return GetObservation().verticalOffset;
 }
 
-units::angle::degree_t DragonLimelight::GetTargetHorizontalOffset() const
+units::angle::degree_t DragonLimelight::CalcHorizontalOffset
+(
+    units::angle::degree_t  tx,
+    units::angle::degree_t  ty
+) const
 {
     if ( abs(m_rotation.to<double>()) < 1.0 )
     {
-        return GetTx();
+        return tx;
     }
     else if ( abs(m_rotation.to<double>()-90.0) < 1.0 )
     {
-        return -1.0 * GetTy();
+        return -1.0 * ty;
     }
     else if ( abs(m_rotation.to<double>()-180.0) < 1.0 )
     {
-        return -1.0 * GetTx();
+        return -1.0 * tx;
     }
     else if ( abs(m_rotation.to<double>()-270.0) < 1.0 )
     {
-        return GetTy();
+        return ty;
     }
     Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonLimelight"), string("GetTargetVerticalOffset"), string("Invalid limelight rotation"));
-    return GetTx();
+    return tx;
 }
 
-units::angle::degree_t DragonLimelight::GetTargetVerticalOffset() const
+units::angle::degree_t DragonLimelight::CalcVerticalOffset
+(
+    units::angle::degree_t  tx,
+    units::angle::degree_t  ty
+) const
 {
     if ( abs(m_rotation.to<double>()) < 1.0 )
     {
-        return GetTy();
+        return ty;
     }
     else if ( abs(m_rotation.to<double>()-90.0) < 1.0 )
     {
-        return GetTx();
+        return tx;
     }
     else if ( abs(m_rotation.to<double>()-180.0) < 1.0 )
     {
-        return -1.0 * GetTy();
+        return -1.0 * ty;
     }
     else if ( abs(m_rotation.to<double>()-270.0) < 1.0 )
     {
-        return -1.0 * GetTx();
+        return -1.0 * tx;
     }
     Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonLimelight"), string("GetTargetVerticalOffset"), string("Invalid limelight rotation"));
-    return GetTy();   
+    return ty;   
 }
 
 double DragonLimelight::GetTargetArea() const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
-    {
-        return nt->GetNumber("ta", 0.0);
-    }
-    return 0.0;
+    return GetObservation().area;
 }
 
 units::angle::degree_t DragonLimelight::GetTargetSkew() const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
+    return units::angle::degree_t(m_ts.GetDouble(0.0));
+}
+
+units::time::microsecond_t DragonLimelight::GetPipelineLatency() const
+{
+    return GetObservation().latency - m_imageCaptureLatency;
+}
+
+/// @brief  Pipeline latency plus the image capture latency
+units::time::microsecond_t DragonLimelight::GetTotalLatency() const
+{
+    return GetPipelineLatency() + m_imageCaptureLatency;
+}
+
+/// @brief  Latest frame published by the network table listener (tv, tx, ty, ta and tl from the same
+///         update).  Frames that haven't been refreshed in a while report no target.
+/// @return TargetObservation   the frame
+TargetObservation DragonLimelight::GetObservation() const
+{
+    auto observation = m_observation.Load();
+    if ( observation.valid && (frc::Timer::GetFPGATimestamp() - observation.timestamp) > m_staleTimeout )
     {
-        return units::angle::degree_t(nt->GetNumber("ts", 0.0));
+        observation.hasTarget = false;
     }
-    return units::angle::degree_t(0.0);
+    observation.targetDistance = CalcTargetDistance(observation.verticalOffset);
+    return observation;
 }
 
-units::time::microsecond_t DragonLimelight::GetPipelineLatency() const
+/// @brief  Estimate where the robot was when a frame was captured from the range and bearing to the target
+/// @param [in]  const TargetObservation&   observation:    limelight frame
+/// @param [in]  const frc::Pose2d&         targetCenter:   field position of the center of the goal
+/// @param [in]  const frc::Rotation2d&     heading:        robot heading at the capture time
+/// @param [out] frc::Pose2d&               robotPose:      estimated robot pose
+/// @return bool    true if the frame had a usable target
+bool DragonLimelight::EstimateRobotPose
+(
+    const TargetObservation&    observation,
+    const frc::Pose2d&          targetCenter,
+    const frc::Rotation2d&      heading,
+    frc::Pose2d&                robotPose
+) const
 {
-    auto nt = m_networktable.get();
-    if (nt != nullptr)
+    if ( !observation.hasTarget || observation.targetDistance <= units::length::inch_t(0.0) )
     {
-        return units::time::second_t(nt->GetNumber("tl", 0.0));
+        return false;
     }
-    return units::time::second_t(0.0);
+
+    // positive horizontal offsets are counter clockwise (see SwerveChassis::AdjustRotToPointTowardGoal)
+    units::length::meter_t range = observation.targetDistance + m_targetCenterOffset;
+    frc::Rotation2d bearing = heading + frc::Rotation2d(observation.horizontalOffset);
+    frc::Translation2d camera = targetCenter.Translation() - frc::Translation2d(range, bearing);
+
+    frc::Translation2d mount{units::length::meter_t(0.0), units::length::meter_t(m_mountingHorizontalOffset)};
+    robotPose = frc::Pose2d(camera - mount.RotateBy(heading), heading);
+    return true;
 }
 
 
@@ -249,28 +328,36 @@ void DragonLimelight::ToggleSnapshot(DragonLimelight::SNAPSHOT_MODE toggle)
 
 void DragonLimelight::PrintValues()
 {
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues HasTarget"), to_string( HasTarget() ) );    
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues XOffset"), to_string( GetTargetHorizontalOffset().to<double>() ) ); 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues YOffset"), to_string( GetTargetVerticalOffset().to<double>() ) ); 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues Area"), to_string( GetTargetArea() ) ); 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues Skew"), to_string( GetTargetSkew().to<double>() ) ); 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string(":PrintValues Latency"), to_string( GetPipelineLatency().to<double>() ) ); 
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues HasTarget"), to_string( HasTarget() ) );    
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues XOffset"), to_string( GetTargetHorizontalOffset().to<double>() ) ); 
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues YOffset"), to_string( GetTargetVerticalOffset().to<double>() ) ); 
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues Area"), to_string( GetTargetArea() ) ); 
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("PrintValues Skew"), to_string( GetTargetSkew().to<double>() ) ); 
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string(":PrintValues Latency"), to_string( GetPipelineLatency().to<double>() ) ); 
 }
 
 units::length::inch_t DragonLimelight::EstimateTargetDistance() const
 {
-    units::angle::degree_t angleFromHorizon = (GetMountingAngle() + GetTargetVerticalOffset());
+    return GetObservation().targetDistance;
+}
+
+units::length::inch_t DragonLimelight::CalcTargetDistance
+(
+    units::angle::degree_t  verticalOffset
+) const
+{
+    units::angle::degree_t angleFromHorizon = (GetMountingAngle() + verticalOffset);
     units::angle::radian_t angleRad = angleFromHorizon;
     double tanAngle = tan(angleRad.to<double>());
 
     auto deltaHgt = GetTargetHeight()-GetMountingHeight();
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("mounting angle "), GetMountingAngle().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("target vertical angle "), GetTargetVerticalOffset().to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("angle radians "), angleRad.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("deltaH "), deltaHgt.to<double>());
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("tan angle "), tanAngle);
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("distance "), ((GetTargetHeight()-GetMountingHeight()) / tanAngle).to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("mounting angle "), GetMountingAngle().to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("target vertical angle "), verticalOffset.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("angle radians "), angleRad.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("deltaH "), deltaHgt.to<double>());
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("tan angle "), tanAngle);
+    LOG_DATA(LOGGER_LEVEL::PRINT, string("DragonLimelight"), string("distance "), ((GetTargetHeight()-GetMountingHeight()) / tanAngle).to<double>());
 
     return (GetTargetHeight()-GetMountingHeight()) / tanAngle;
 }
@@ -23,7 +23,10 @@
 #include <vector>
 
 // FRC includes
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
 #include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
 #include <units/angle.h>
 #include <units/length.h>
 #include <units/time.h>
@@ -31,6 +34,8 @@
 // Team 302 includes
 #include <hw/interfaces/IDragonSensor.h>
 #include <hw/interfaces/IDragonDistanceSensor.h>
+#include <hw/TargetObservation.h>
+#include <utils/SeqLock.h>
 
 // Third Party Includes
 
@@ -86,7 +91,7 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
         /// Method:         ~DragonLimelight (destructor)
         /// Description:    Delete the object
         ///-----------------------------------------------------------------------------------
-        ~DragonLimelight() = default;
+        ~DragonLimelight();
 
 
         // Getters
@@ -96,9 +101,29 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
         double GetTargetArea() const;
         units::angle::degree_t GetTargetSkew() const;
         units::time::microsecond_t GetPipelineLatency() const;
+        units::time::microsecond_t GetTotalLatency() const;
         units::length::inch_t EstimateTargetDistance() const;
         std::vector<double> Get3DSolve() const;
 
+        /// @brief  Latest frame published by the network table listener (tv, tx, ty, ta and tl from the same
+        ///         update).  Frames that haven't been refreshed in a while report no target.
+        /// @return TargetObservation   the frame
+        TargetObservation GetObservation() const;
+
+        /// @brief  Estimate where the robot was when a frame was captured from the range and bearing to the target
+        /// @param [in]  const TargetObservation&   observation:    limelight frame
+        /// @param [in]  const frc::Pose2d&         targetCenter:   field position of the center of the goal
+        /// @param [in]  const frc::Rotation2d&     heading:        robot heading at the capture time
+        /// @param [out] frc::Pose2d&               robotPose:      estimated robot pose
+        /// @return bool    true if the frame had a usable target
+        bool EstimateRobotPose
+        (
+            const TargetObservation&    observation,
+            const frc::Pose2d&          targetCenter,
+            const frc::Rotation2d&      heading,
+            frc::Pose2d&                robotPose
+        ) const;
+
         // Setters
         void SetTargetHeight
         (
@@ -147,10 +172,18 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
         units::angle::degree_t GetMountingAngle() const {return m_mountingAngle;}
         units::length::inch_t  GetMountingHeight() const {return m_mountHeight;}
         units::length::inch_t  GetTargetHeight() const {return m_targetHeight;}
+        units::length::inch_t  GetMountingHorizontalOffset() const {return m_mountingHorizontalOffset;}
 
     private:
-        units::angle::degree_t GetTx() const;
-        units::angle::degree_t GetTy() const;
+        /// @brief  Network table listener callback; runs on the network table thread each time tl updates
+        void OnFrame
+        (
+            const nt::EntryNotification&    event
+        );
+
+        units::angle::degree_t CalcHorizontalOffset(units::angle::degree_t tx, units::angle::degree_t ty) const;
+        units::angle::degree_t CalcVerticalOffset(units::angle::degree_t tx, units::angle::degree_t ty) const;
+        units::length::inch_t CalcTargetDistance(units::angle::degree_t verticalOffset) const;
         
         std::shared_ptr<nt::NetworkTable> m_networktable;
         units::length::inch_t m_mountHeight;
@@ -160,7 +193,21 @@ class DragonLimelight //: public IDragonSensor, public IDragonDistanceSensor
         units::length::inch_t m_targetHeight;
         units::length::inch_t m_targetHeight2;
 
+        nt::NetworkTableEntry               m_tv;
+        nt::NetworkTableEntry               m_tx;
+        nt::NetworkTableEntry               m_ty;
+        nt::NetworkTableEntry               m_ta;
+        nt::NetworkTableEntry               m_ts;
+        nt::NetworkTableEntry               m_tl;
+        NT_EntryListener                    m_listener;
+        uint64_t                            m_frameCount;
+        SeqLock<TargetObservation>          m_observation;
+
         double PI = 3.14159265;
 
+        const units::time::millisecond_t    m_imageCaptureLatency = units::time::millisecond_t(11.0);  // per the limelight docs
+        const units::length::inch_t         m_targetCenterOffset = units::length::inch_t(24.0);         // vision tape to center of goal
+        const units::time::second_t         m_staleTimeout = units::time::second_t(0.5);                // no frames for this long means no target
+
 
 };
@@ -15,6 +15,7 @@
 //====================================================================================================================================================
 
 #include <ctre/phoenix/Sensors/PigeonIMU.h>
+#include <hw/CANFrameBudget.h>
 #include <hw/DragonPigeon.h>
 #include <memory>
 
@@ -32,7 +33,9 @@ DragonPigeon::DragonPigeon
     m_pigeon2(nullptr),
     m_initialYaw(rotation),
     m_initialPitch(0.0),
-    m_initialRoll(0.0)
+    m_initialRoll(0.0),
+    m_canBusName(type == DragonPigeon::PIGEON_TYPE::PIGEON1 ? string("rio") : canBusName),
+    m_name(string("Pigeon ") + to_string(canID))
 {
     if (type == DragonPigeon::PIGEON_TYPE::PIGEON1)
     {
@@ -40,23 +43,74 @@ DragonPigeon::DragonPigeon
         m_pigeon->ConfigFactoryDefault();
         m_pigeon->SetYaw(rotation, 0);
         m_pigeon->SetFusedHeading( rotation, 0);
-
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_4_Mag, 120, 0);
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_11_GyroAccum, 120, 0);
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, 120, 0); // using fused heading not yaw
     }
     else
     {
         m_pigeon2 = new WPI_Pigeon2(canID, canBusName);
         m_pigeon2->ConfigFactoryDefault();
         m_pigeon2->SetYaw(rotation);
+    }
+
+    // the yaw goes out every 10 ms by default; odometry asks for its own rate through SetYawFramePeriod
+    auto pigeon = m_pigeon;
+    auto pigeon2 = m_pigeon2;
+    CANFrameBudget::GetInstance()->AddDefault( m_canBusName, m_name, string("YawPitchRoll"), 10, CANFrameBudget::MEDIUM, 
+                                               [pigeon, pigeon2](uint8_t period)
+                                               {
+                                                   if (pigeon != nullptr) pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_9_SixDeg_YPR, period, 0);
+                                                   else pigeon2->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_9_SixDeg_YPR, period, 0);
+                                               } );
+
+    RequestFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_4_Mag, string("Mag"), 120, CANFrameBudget::LOW );
+    RequestFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_11_GyroAccum, string("GyroAccum"), 120, CANFrameBudget::LOW );
+    RequestFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, string("Accel"), 120, CANFrameBudget::LOW ); // using fused heading not yaw
+}
+
+void DragonPigeon::RequestFramePeriod
+(
+    PigeonIMU_StatusFrame           frame,
+    const string&                   frameName,
+    uint8_t                         milliseconds,
+    CANFrameBudget::FRAME_PRIORITY  priority
+)
+{
+    auto pigeon = m_pigeon;
+    auto pigeon2 = m_pigeon2;
+    CANFrameBudget::GetInstance()->Request( m_canBusName, m_name, frameName, milliseconds, priority, 
+                                            [pigeon, pigeon2, frame](uint8_t period)
+                                            {
+                                                if (pigeon != nullptr) pigeon->SetStatusFramePeriod( frame, period, 0);
+                                                else pigeon2->SetStatusFramePeriod( frame, period, 0);
+                                            } );
+}
 
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_4_Mag, 120, 0);
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_11_GyroAccum, 120, 0);
-        m_pigeon->SetStatusFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_BiasedStatus_6_Accel, 120, 0); // using fused heading not yaw
+/// @brief  Turn the simulated pigeon (simulation only)
+/// @param [in] double deltaDeg:    change in yaw since the last update (degrees, counter clockwise positive)
+void DragonPigeon::AddSimYaw
+(
+    double      deltaDeg
+)
+{
+    if (m_pigeon != nullptr)
+    {
+        m_pigeon->GetSimCollection().AddHeading(deltaDeg);
+    }
+    else if (m_pigeon2 != nullptr)
+    {
+        m_pigeon2->GetSimCollection().AddHeading(deltaDeg);
     }
 }
 
+/// @brief  Set how often the yaw is sent over CAN (match the rate odometry runs at)
+/// @param [in] uint8_t milliseconds:   status frame period
+void DragonPigeon::SetYawFramePeriod
+(
+    uint8_t     milliseconds
+)
+{
+    RequestFramePeriod( PigeonIMU_StatusFrame::PigeonIMU_CondStatus_9_SixDeg_YPR, string("YawPitchRoll"), milliseconds, CANFrameBudget::CRITICAL );
+}
+
 
 double DragonPigeon::GetPitch()
 {
@@ -124,7 +178,7 @@ double DragonPigeon::GetRawYaw()
     }
     else if (m_pigeon2 != nullptr)
     {
-        m_pigeon2->GetYaw();
+        yaw = m_pigeon2->GetYaw();
     }
     yaw = remainder(yaw,360.0);
 
@@ -16,6 +16,8 @@
 
 #pragma once
 #include <memory>
+#include <string>
+#include <hw/CANFrameBudget.h>
 #include <ctre/phoenix/sensors/WPI_PigeonIMU.h>
 #include <ctre/phoenix/sensors/WPI_Pigeon2.h>
 #include <ctre/Phoenix.h>
@@ -52,6 +54,14 @@ class DragonPigeon
         double GetYaw();
         void ReZeroPigeon( double angleDeg, int timeoutMs = 0);
 
+        /// @brief  Set how often the yaw is sent over CAN (match the rate odometry runs at)
+        /// @param [in] uint8_t milliseconds:   status frame period
+        void SetYawFramePeriod( uint8_t milliseconds );
+
+        /// @brief  Turn the simulated pigeon (simulation only)
+        /// @param [in] double deltaDeg:    change in yaw since the last update (degrees, counter clockwise positive)
+        void AddSimYaw( double deltaDeg );
+
     private:
 
         ctre::phoenix::sensors::WPI_PigeonIMU* m_pigeon;
@@ -61,6 +71,18 @@ class DragonPigeon
         double m_initialPitch;
         double m_initialRoll;
 
+        std::string m_canBusName;
+        std::string m_name;
+
+        /// @brief  Hand a frame period to the CAN frame budget, which writes it once the bus is planned
+        void RequestFramePeriod
+        (
+            ctre::phoenix::sensors::PigeonIMU_StatusFrame   frame,
+            const std::string&                              frameName,
+            uint8_t                                         milliseconds,
+            CANFrameBudget::FRAME_PRIORITY                  priority
+        );
+
         // these methods correct orientation, but do not apply the initial offsets
         double GetRawYaw();
         double GetRawRoll();
@@ -34,7 +34,9 @@
 //#include <hw/DragonPDP.h>
 #include <hw/usages/MotorControllerUsage.h>
 #include <hw/DistanceAngleCalcStruc.h>
+#include <hw/CANFrameBudget.h>
 #include <utils/ConversionUtils.h>
+#include <utils/InputRecorder.h>
 #include <utils/Logger.h>
 
 // Third Party Includes
@@ -61,6 +63,9 @@ DragonTalonSRX::DragonTalonSRX
 ) : m_networkTableName(networkTableName),
 	m_talon( make_shared<WPI_TalonSRX>(deviceID)),
 	m_controller(),
+	m_controlData(),
+	m_adapters(),
+	m_appliedConstants(),
 	m_type(deviceType),
 	m_id(deviceID),
 	m_pdp( pdpID ),
@@ -70,12 +75,23 @@ DragonTalonSRX::DragonTalonSRX
 	m_networkTableName += string(" - motor ");
 	m_networkTableName += to_string(deviceID);
 
-	m_controller[0] = DragonControlToCTREAdapterFactory::GetFactory()->CreatePercentOuptutAdapter(networkTableName, m_talon.get());
+	m_controller[0] = DragonControlToCTREAdapterFactory::GetFactory()->CreatePercentOuptutAdapter(networkTableName, m_talon.get(), &m_appliedConstants);
 	m_controller[0]->InitializeDefaults();
 	for (auto i=1; i<4; ++i)
 	{
 		m_controller[i] = m_controller[0];
 	}
+
+	// count what the controller sends before anything is requested: the roboRIO's control frame and the 
+	// factory default general and feedback frames
+	auto budget = CANFrameBudget::GetInstance();
+	auto talon = m_talon;
+	budget->AddDefault( string("rio"), m_networkTableName, string("Control"), 10, CANFrameBudget::CRITICAL, nullptr );
+	budget->AddDefault( string("rio"), m_networkTableName, CANFrameBudget::GetFrameName(StatusFrameEnhanced::Status_1_General), 10, CANFrameBudget::MEDIUM, 
+						[talon](uint8_t period) { talon.get()->SetStatusFramePeriod( StatusFrameEnhanced::Status_1_General, period, 0 ); } );
+	budget->AddDefault( string("rio"), m_networkTableName, CANFrameBudget::GetFrameName(StatusFrameEnhanced::Status_2_Feedback0), 20, CANFrameBudget::MEDIUM, 
+						[talon](uint8_t period) { talon.get()->SetStatusFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, period, 0 ); } );
+
 	auto prompt = string("CTRE CAN motor controller ");
 	prompt += to_string(deviceID);
 
@@ -217,70 +233,94 @@ void DragonTalonSRX::UpdateFramePeriods
 	uint8_t												milliseconds
 )
 {
-	m_talon.get()->SetStatusFramePeriod( frame, milliseconds, 0 );
+	RequestFramePeriod( frame, milliseconds, CANFrameBudget::CRITICAL );
+}
+
+/// @brief  Hand a frame period to the CAN frame budget, which writes it once the bus is planned
+void DragonTalonSRX::RequestFramePeriod
+(
+	StatusFrameEnhanced				frame,
+	uint8_t							milliseconds,
+	CANFrameBudget::FRAME_PRIORITY	priority
+)
+{
+	auto talon = m_talon;
+	CANFrameBudget::GetInstance()->Request( string("rio"), m_networkTableName, CANFrameBudget::GetFrameName(frame), milliseconds, priority,
+											[talon, frame](uint8_t period) { talon.get()->SetStatusFramePeriod( frame, period, 0 ); } );
 }
 void DragonTalonSRX::SetFramePeriodPriority
 (
 	MOTOR_PRIORITY              priority
 )
 {
+	// the general and feedback frames keep the motor's priority; the rest are diagnostics, so they are the
+	// first to be slowed down when the bus is over budget
+	auto controlPriority = priority == HIGH ? CANFrameBudget::HIGH : (priority == MEDIUM ? CANFrameBudget::MEDIUM : CANFrameBudget::LOW);
+
+	// re-plan the bus once for the whole profile instead of once per frame
+	auto budget = CANFrameBudget::GetInstance();
+	budget->BeginBatch();
+
 	switch ( priority )
 	{
 		case HIGH:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 10 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 20 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 100 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 120 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 10, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 20, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 100, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 120, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		case MEDIUM:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 20 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 30 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 150 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 20, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 30, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 150, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		case LOW:
-			UpdateFramePeriods( StatusFrameEnhanced::Status_1_General, 30 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_2_Feedback0, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_3_Quadrature, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_4_AinTempVbat, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_8_PulseWidth, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_10_Targets, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_11_UartGadgeteer, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_12_Feedback1, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_13_Base_PIDF0, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_14_Turn_PIDF1, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200 );
-			UpdateFramePeriods( StatusFrameEnhanced::Status_Brushless_Current, 200 );
+			RequestFramePeriod( StatusFrameEnhanced::Status_1_General, 30, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_2_Feedback0, 200, controlPriority );
+			RequestFramePeriod( StatusFrameEnhanced::Status_3_Quadrature, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_4_AinTempVbat, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_8_PulseWidth, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_10_Targets, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_11_UartGadgeteer, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_12_Feedback1, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_13_Base_PIDF0, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_14_Turn_PIDF1, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_15_FirmareApiStatus, 200, CANFrameBudget::LOW );
+			RequestFramePeriod( StatusFrameEnhanced::Status_Brushless_Current, 200, CANFrameBudget::LOW );
 			break;
 
 		default:
 		break;
 
 	}
+
+	budget->CommitBatch();
 }
 
 
 
 void DragonTalonSRX::Set(double value)
 {
+	InputRecorder::GetInstance()->RecordOutput(m_id, value);
 	m_controller[0]->Set(value);
 }
 void DragonTalonSRX::SetRotationOffset(double rotations)
@@ -342,6 +382,10 @@ void DragonTalonSRX::SelectClosedLoopProfile
 )
 {
 	auto error = m_talon.get()->SelectProfileSlot( slot, pidIndex );
+	if ( pidIndex == 0 )
+	{
+		m_appliedConstants.selectedSlot = slot;
+	}
 	if ( error != ErrorCode::OKAY )
 	{
 		auto prompt = string("Dragon Talon");
@@ -438,8 +482,33 @@ void DragonTalonSRX::SetAsFollowerMotor
 /// @return void
 void DragonTalonSRX::SetControlConstants(int slot, ControlData* controlInfo)
 {
-	delete m_controller[slot];
-	m_controller[slot] = DragonControlToCTREAdapterFactory::GetFactory()->CreateAdapter(m_networkTableName, slot, controlInfo, m_calcStruc, m_talon.get());
+	if ( slot < 0 || slot >= CTREAppliedConstants::NUM_SLOTS || controlInfo == nullptr )
+	{
+		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, m_networkTableName, string("SetControlConstants"), string("invalid slot or control data"));
+		return;
+	}
+
+	// already running with this control data, so there is nothing to send
+	if ( m_controlData[slot] == controlInfo )
+	{
+		return;
+	}
+
+	// adapters are built once per control data; switching back to one only re-sends constants the
+	// device doesn't already have (the adapter checks against m_appliedConstants)
+	auto key = make_pair(slot, controlInfo);
+	auto itr = m_adapters.find(key);
+	if ( itr == m_adapters.end() )
+	{
+		auto adapter = DragonControlToCTREAdapterFactory::GetFactory()->CreateAdapter(m_networkTableName, slot, controlInfo, m_calcStruc, m_talon.get(), &m_appliedConstants);
+		itr = m_adapters.insert(make_pair(key, adapter)).first;
+	}
+	else
+	{
+		itr->second->SetControlConstants(slot, controlInfo);
+	}
+	m_controller[slot] = itr->second;
+	m_controlData[slot] = controlInfo;
 }
 
 void DragonTalonSRX::SetForwardLimitSwitch
@@ -550,4 +619,33 @@ void DragonTalonSRX::EnableDisableLimitSwitches
 )
 {
 	m_talon.get()->OverrideLimitSwitchesEnable(enable);
-}
\ No newline at end of file
+}
+
+/// @brief  Return the voltage the controller is driving the motor with (simulation only)
+/// @return units::volt_t - motor output voltage
+units::volt_t DragonTalonSRX::GetSimOutputVoltage() const
+{
+	return units::volt_t(m_talon.get()->GetSimCollection().GetMotorOutputLeadVoltage());
+}
+
+/// @brief  Feed the modeled motor state back into the controller's sensors (simulation only).
+///         The sim collection works in the motor's frame, so inversion is still applied by the talon.
+/// @param [in] units::volt_t       busVoltage - battery voltage at the controller
+/// @param [in] double              motorRotations - motor shaft revolutions (before the gear ratio)
+/// @param [in] double              motorRPS - motor shaft revolutions per second (before the gear ratio)
+/// @param [in] units::ampere_t     current - current the motor is drawing
+/// @return void
+void DragonTalonSRX::SetSimState
+(
+	units::volt_t       busVoltage,
+	double              motorRotations,
+	double              motorRPS,
+	units::ampere_t     current
+)
+{
+	auto& sim = m_talon.get()->GetSimCollection();
+	sim.SetBusVoltage(busVoltage.to<double>());
+	sim.SetQuadratureRawPosition(static_cast<int>(ConversionUtils::RevolutionsToCounts(motorRotations, m_calcStruc.countsPerRev)));
+	sim.SetQuadratureVelocity(static_cast<int>(ConversionUtils::RPSToCounts100ms(motorRPS, m_calcStruc.countsPerRev)));
+	sim.SetSupplyCurrent(current.to<double>());
+}
@@ -17,13 +17,17 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <frc/motorcontrol/MotorController.h>
 
+#include <hw/CANFrameBudget.h>
 #include <hw/DistanceAngleCalcStruc.h>
+#include <hw/ctreadapters/CTREAppliedConstants.h>
 #include <hw/interfaces/IDragonControlToVendorControlAdapter.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <hw/usages/MotorControllerUsage.h>
@@ -60,6 +64,7 @@ class DragonTalonSRX : public IDragonMotorController
         MotorControllerUsage::MOTOR_CONTROLLER_USAGE GetType() const override;
         int GetID() const override;
         std::shared_ptr<frc::MotorController> GetSpeedController() const override;
+        ctre::phoenix::motorcontrol::can::WPI_TalonSRX* GetTalonSRX() const override { return m_talon.get(); }
         double GetCurrent() const override;
         IDragonMotorController::MOTOR_TYPE GetMotorType() const override;
 
@@ -152,11 +157,30 @@ class DragonTalonSRX : public IDragonMotorController
             bool enable
         ) override;
 
+        units::volt_t GetSimOutputVoltage() const override;
+        void SetSimState
+        (
+            units::volt_t       busVoltage,
+            double              motorRotations,
+            double              motorRPS,
+            units::ampere_t     current
+        ) override;
+
 
     private:
+        void RequestFramePeriod
+        (
+            ctre::phoenix::motorcontrol::StatusFrameEnhanced    frame,
+            uint8_t                                             milliseconds,
+            CANFrameBudget::FRAME_PRIORITY                      priority
+        );
+
         std::string                                                         m_networkTableName;
         std::shared_ptr<ctre::phoenix::motorcontrol::can::WPI_TalonSRX>     m_talon;
         IDragonControlToVendorControlAdapter*                               m_controller[4];
+        ControlData*                                                        m_controlData[4];
+        std::map<std::pair<int, ControlData*>, IDragonControlToVendorControlAdapter*> m_adapters;
+        CTREAppliedConstants                                                m_appliedConstants;
         MotorControllerUsage::MOTOR_CONTROLLER_USAGE                        m_type;
 
         int                                                                 m_id;
@@ -0,0 +1,185 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// FRC includes
+#include <frc/Timer.h>
+
+// Team 302 includes
+#include <hw/FrameRateProfiles.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+FrameRateProfiles* FrameRateProfiles::m_instance = nullptr;
+FrameRateProfiles* FrameRateProfiles::GetInstance()
+{
+    if ( FrameRateProfiles::m_instance == nullptr )
+    {
+        FrameRateProfiles::m_instance = new FrameRateProfiles();
+    }
+    return FrameRateProfiles::m_instance;
+}
+
+FrameRateProfiles::FrameRateProfiles() : m_devices(),
+                                         m_mode(DISABLED),
+                                         m_generation(0),
+                                         m_appliedGeneration(0),
+                                         m_workerStarted(false),
+                                         m_mutex(),
+                                         m_changed()
+{
+}
+
+unsigned int FrameRateProfiles::ParseModes
+(
+    const string&           modes
+)
+{
+    unsigned int mask = 0;
+
+    auto list = modes;
+    for ( auto& c : list )
+    {
+        c = ( c == ',' ) ? ' ' : c;
+    }
+
+    istringstream words(list);
+    string word;
+    while ( words >> word )
+    {
+        if ( word == "disabled" )
+        {
+            mask |= 1U << DISABLED;
+        }
+        else if ( word == "auton" )
+        {
+            mask |= 1U << AUTON;
+        }
+        else if ( word == "teleop" )
+        {
+            mask |= 1U << TELEOP;
+        }
+        else if ( word == "test" )
+        {
+            mask |= 1U << TEST;
+        }
+        else
+        {
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("FrameRateProfiles"), string("unknown mode"), word);
+        }
+    }
+    return mask;
+}
+
+void FrameRateProfiles::Add
+(
+    IDragonMotorController*     motor,
+    unsigned int                fastModes,
+    unsigned int                mediumModes
+)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_devices.emplace_back(Device{motor, fastModes, mediumModes, IDragonMotorController::MOTOR_PRIORITY::LOW, false});
+}
+
+void FrameRateProfiles::SetMode
+(
+    ROBOT_MODE                  mode
+)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if ( m_devices.empty() )
+        {
+            return;
+        }
+
+        m_mode = mode;
+        ++m_generation;
+        if ( !m_workerStarted )
+        {
+            m_workerStarted = true;
+            thread(&FrameRateProfiles::RunWorker, this).detach();
+        }
+    }
+    m_changed.notify_one();
+}
+
+void FrameRateProfiles::RunWorker()
+{
+    unique_lock<mutex> lock(m_mutex);
+    while ( true )
+    {
+        m_changed.wait(lock, [this] { return m_appliedGeneration != m_generation; });
+
+        auto generation = m_generation;
+        auto modeBit = 1U << m_mode;
+        auto start = frc::Timer::GetFPGATimestamp().to<double>();
+        auto changed = 0;
+
+        // speed up the devices the new mode needs before slowing down the ones it doesn't;
+        // start over if the mode changes again part way through
+        for ( auto raise : { true, false } )
+        {
+            for ( size_t inx = 0; inx < m_devices.size() && generation == m_generation; ++inx )
+            {
+                auto& device = m_devices[inx];
+                auto priority = ( device.fastModes & modeBit ) != 0 ? IDragonMotorController::MOTOR_PRIORITY::HIGH : 
+                                ( ( device.mediumModes & modeBit ) != 0 ? IDragonMotorController::MOTOR_PRIORITY::MEDIUM : 
+                                                                          IDragonMotorController::MOTOR_PRIORITY::LOW );
+
+                // HIGH is the fastest priority; a device that was never written is treated as LOW
+                auto current = device.hasApplied ? device.applied : IDragonMotorController::MOTOR_PRIORITY::LOW;
+                auto faster = priority < current;
+                if ( faster != raise || ( device.hasApplied && device.applied == priority ) )
+                {
+                    continue;
+                }
+
+                auto motor = m_devices[inx].motor;
+                lock.unlock();
+                motor->SetFramePeriodPriority(priority);
+                this_thread::sleep_for(chrono::milliseconds(kDeviceSpacingMs));
+                lock.lock();
+
+                m_devices[inx].applied = priority;
+                m_devices[inx].hasApplied = true;
+                ++changed;
+            }
+        }
+
+        if ( generation == m_generation )
+        {
+            m_appliedGeneration = generation;
+
+            static const string modeNames[MAX_ROBOT_MODES] = { string("disabled"), string("auton"), string("teleop"), string("test") };
+            auto elapsed = frc::Timer::GetFPGATimestamp().to<double>() - start;
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("FrameRateProfiles"), 
+                                         modeNames[m_mode] + string(" devices changed"), to_string(changed) + 
+                                         string(" in ") + to_string(elapsed) + string(" s"));
+        }
+    }
+}
@@ -0,0 +1,109 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+
+// Third Party Includes
+
+/// @brief  Switches motor controllers between fast (HIGH), medium (MEDIUM) and slow (LOW) status frames when the
+///         robot mode changes.  A motor is managed only if robot.xml lists the modes it needs fast feedback in
+///         (fastFrameModes="auton teleop") or the modes it only needs some feedback in (mediumFrameModes="disabled");
+///         in every other mode it is dropped to LOW.
+///
+///         The frames are written on a worker thread one device at a time, so a mode change doesn't add
+///         CAN traffic or latency to the first loop of the new mode.  The devices being sped up go first.
+///         Devices that must be fast the moment auton starts should also list "disabled".
+///
+///         The swerve odometry frames are only held as CRITICAL requests in CANFrameBudget when the chassis
+///         has an odometryRate; without one the swerve motors rely on their frame modes.  robot.xml runs them
+///         at MEDIUM while disabled: the pose estimator keeps getting positions before the match, at a rate
+///         that is plenty for a robot that isn't driving, and they are raised first when auton starts.
+class FrameRateProfiles
+{
+    public:
+        enum ROBOT_MODE
+        {
+            DISABLED,
+            AUTON,
+            TELEOP,
+            TEST,
+            MAX_ROBOT_MODES
+        };
+
+        static FrameRateProfiles* GetInstance();
+
+        /// @brief  Convert a list of modes ("disabled auton teleop test", separated by spaces or commas)
+        ///         into the mask Add takes.  Unknown names are logged and ignored.
+        static unsigned int ParseModes
+        (
+            const std::string&          modes
+        );
+
+        /// @brief  Manage a motor's frame rates
+        /// @param [in] IDragonMotorController*    motor - the motor controller
+        /// @param [in] unsigned int               fastModes - mask of modes (from ParseModes) that need fast frames
+        /// @param [in] unsigned int               mediumModes - mask of modes that need medium frames
+        void Add
+        (
+            IDragonMotorController*     motor,
+            unsigned int                fastModes,
+            unsigned int                mediumModes
+        );
+
+        /// @brief  Start moving the managed motors to the profile for this mode (returns right away)
+        void SetMode
+        (
+            ROBOT_MODE                  mode
+        );
+
+    private:
+        FrameRateProfiles();
+        ~FrameRateProfiles() = default;
+
+        struct Device
+        {
+            IDragonMotorController*                     motor;
+            unsigned int                                fastModes;
+            unsigned int                                mediumModes;
+            IDragonMotorController::MOTOR_PRIORITY      applied;
+            bool                                        hasApplied;
+        };
+
+        void RunWorker();
+
+        static FrameRateProfiles*   m_instance;
+
+        static constexpr int        kDeviceSpacingMs = 5;   // pause between devices to spread the frame writes
+
+        std::vector<Device>         m_devices;
+        ROBOT_MODE                  m_mode;
+        unsigned int                m_generation;           // bumped by every SetMode
+        unsigned int                m_appliedGeneration;
+        bool                        m_workerStarted;
+        std::mutex                  m_mutex;
+        std::condition_variable     m_changed;
+};
@@ -0,0 +1,45 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+
+// FRC includes
+#include <units/angle.h>
+#include <units/length.h>
+#include <units/time.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+/// @struct TargetObservation
+/// @brief  One limelight frame.  The timestamp is when the frame was captured (FPGA seconds), i.e. the
+///         time the robot was at the pose the target values describe, not the time they were read.
+struct TargetObservation
+{
+    bool                                valid = false;              // limelight exists and was read
+    bool                                hasTarget = false;
+    units::angle::degree_t              horizontalOffset{0.0};      // corrected for the camera rotation
+    units::angle::degree_t              verticalOffset{0.0};        // corrected for the camera rotation
+    double                              area = 0.0;
+    units::length::inch_t               targetDistance{0.0};        // camera to vision target
+    units::time::second_t               latency{0.0};               // pipeline + image capture latency
+    units::time::second_t               timestamp{0.0};             // capture time
+    uint64_t                            frameId = 0;                // changes every time the limelight publishes
+};
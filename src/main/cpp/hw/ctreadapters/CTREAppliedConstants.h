@@ -0,0 +1,51 @@
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+/// @brief  Shadow of the control constants last written to a CTRE motor controller.  It is shared by all
+///         of the adapters for one device so a constant is only sent over CAN when its value changes.
+struct CTREAppliedConstants
+{
+    static constexpr int NUM_SLOTS = 4;
+
+    bool        peakNominalValid = false;
+    double      peakValue = 0.0;
+    double      nominalValue = 0.0;
+
+    bool        motionValid = false;
+    double      maxAcceleration = 0.0;
+    double      cruiseVelocity = 0.0;
+
+    bool        slotValid[NUM_SLOTS] = {false, false, false, false};
+    double      proportional[NUM_SLOTS] = {0.0, 0.0, 0.0, 0.0};
+    double      integral[NUM_SLOTS] = {0.0, 0.0, 0.0, 0.0};
+    double      derivative[NUM_SLOTS] = {0.0, 0.0, 0.0, 0.0};
+    double      feedforward[NUM_SLOTS] = {0.0, 0.0, 0.0, 0.0};
+
+    int         selectedSlot = -1;
+
+    /// @brief  Forget everything that was written (e.g. after a ConfigFactoryDefault)
+    void Invalidate()
+    {
+        peakNominalValid = false;
+        motionValid = false;
+        for ( auto inx=0; inx<NUM_SLOTS; ++inx )
+        {
+            slotValid[inx] = false;
+        }
+        selectedSlot = -1;
+    }
+};
@@ -22,6 +22,7 @@
 
 // Team 302 includes
 #include <hw/interfaces/IDragonControlToVendorControlAdapter.h>
+#include <hw/ctreadapters/CTREAppliedConstants.h>
 #include <hw/ctreadapters/DragonControlToCTREAdapter.h>
 #include <hw/ctreadapters/DragonPercentOutputToCTREAdapter.h>
 #include <mechanisms/controllers/ControlData.h>
@@ -44,13 +45,15 @@ DragonControlToCTREAdapter::DragonControlToCTREAdapter
     int                                                             controllerSlot, 
     ControlData*                                                    controlInfo,          
     DistanceAngleCalcStruc                                          calcStruc,
-    WPI_BaseMotorController*                                        controller   
+    WPI_BaseMotorController*                                        controller,
+    CTREAppliedConstants*                                           appliedConstants
 ) : IDragonControlToVendorControlAdapter(),
 	m_networkTableName(networkTableName),
     m_controllerSlot(controllerSlot),
     m_controlData(controlInfo),
     m_calcStruc(calcStruc),
-    m_controller(controller)
+    m_controller(controller),
+    m_applied(appliedConstants)
 {
 	SetPeakAndNominalValues(networkTableName, controlInfo);
 
@@ -125,6 +128,15 @@ void DragonControlToCTREAdapter::InitializeDefaults()
 			Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, GetErrorPrompt(), string("ConfigPeakOutputReverse"), string("error"));
 			error = ErrorCode::OKAY;
 		}
+
+		// factory defaults wiped the slots, so the next constants have to be written
+		if ( m_applied != nullptr )
+		{
+			m_applied->Invalidate();
+			m_applied->peakNominalValid = true;
+			m_applied->peakValue = 1.0;
+			m_applied->nominalValue = 0.0;
+		}
 	}
 }
 
@@ -142,6 +154,18 @@ void DragonControlToCTREAdapter::SetPeakAndNominalValues
 )
 {
 	auto peak = controlInfo->GetPeakValue();
+	auto nominal = controlInfo->GetNominalValue();
+	if ( m_applied != nullptr )
+	{
+		if ( m_applied->peakNominalValid && m_applied->peakValue == peak && m_applied->nominalValue == nominal )
+		{
+			return;
+		}
+		m_applied->peakNominalValid = true;
+		m_applied->peakValue = peak;
+		m_applied->nominalValue = nominal;
+	}
+
 	auto error = m_controller->ConfigPeakOutputForward(peak);
 	if ( error != ErrorCode::OKAY )
 	{
@@ -153,7 +177,6 @@ void DragonControlToCTREAdapter::SetPeakAndNominalValues
 		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, networkTableName, GetErrorPrompt(), string("ConfigPeakOutputReverse error"));
 	}
 
-	auto nominal = controlInfo->GetNominalValue();
 	error = m_controller->ConfigNominalOutputForward(nominal);
 	if ( error != ErrorCode::OKAY )
 	{
@@ -173,6 +196,19 @@ void DragonControlToCTREAdapter::SetMaxVelocityAcceleration
     ControlData*                                                    controlInfo         
 )
 {
+	if ( m_applied != nullptr )
+	{
+		if ( m_applied->motionValid && 
+			 m_applied->maxAcceleration == controlInfo->GetMaxAcceleration() && 
+			 m_applied->cruiseVelocity == controlInfo->GetCruiseVelocity() )
+		{
+			return;
+		}
+		m_applied->motionValid = true;
+		m_applied->maxAcceleration = controlInfo->GetMaxAcceleration();
+		m_applied->cruiseVelocity = controlInfo->GetCruiseVelocity();
+	}
+
 	auto error = m_controller->ConfigMotionAcceleration( controlInfo->GetMaxAcceleration() );
 	if ( error != ErrorCode::OKAY )
 	{
@@ -193,6 +229,18 @@ void DragonControlToCTREAdapter::SetPIDConstants
     ControlData*                                                    controlInfo         
 )
 {
+	auto slotValid = ( m_applied != nullptr && controllerSlot >= 0 && controllerSlot < CTREAppliedConstants::NUM_SLOTS );
+	if ( slotValid &&
+		 m_applied->slotValid[controllerSlot] &&
+		 m_applied->proportional[controllerSlot] == controlInfo->GetP() &&
+		 m_applied->integral[controllerSlot] == controlInfo->GetI() &&
+		 m_applied->derivative[controllerSlot] == controlInfo->GetD() &&
+		 m_applied->feedforward[controllerSlot] == controlInfo->GetF() )
+	{
+		SelectProfileSlot(networkTableName, controllerSlot);
+		return;
+	}
+
 	auto error = m_controller->Config_kP(controllerSlot, controlInfo->GetP());
 	if ( error != ErrorCode::OKAY )
 	{
@@ -217,7 +265,32 @@ void DragonControlToCTREAdapter::SetPIDConstants
 		m_controller->Config_kF(controllerSlot, controlInfo->GetF());
 		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, networkTableName, GetErrorPrompt(), string("Config_kF error"));
 	}
-	error = m_controller->SelectProfileSlot(controllerSlot, 0);
+	if ( slotValid )
+	{
+		m_applied->slotValid[controllerSlot] = true;
+		m_applied->proportional[controllerSlot] = controlInfo->GetP();
+		m_applied->integral[controllerSlot] = controlInfo->GetI();
+		m_applied->derivative[controllerSlot] = controlInfo->GetD();
+		m_applied->feedforward[controllerSlot] = controlInfo->GetF();
+	}
+	SelectProfileSlot(networkTableName, controllerSlot);
+}
+
+void DragonControlToCTREAdapter::SelectProfileSlot
+(
+    std::string                                                     networkTableName,
+    int                                                             controllerSlot
+)
+{
+	if ( m_applied != nullptr )
+	{
+		if ( m_applied->selectedSlot == controllerSlot )
+		{
+			return;
+		}
+		m_applied->selectedSlot = controllerSlot;
+	}
+	auto error = m_controller->SelectProfileSlot(controllerSlot, 0);
 	if ( error != ErrorCode::OKAY )
 	{
 		Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, networkTableName, GetErrorPrompt(), string("SelectProfileSlot error"));
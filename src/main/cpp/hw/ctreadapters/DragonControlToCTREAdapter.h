@@ -38,6 +38,7 @@ namespace ctre
     }
 }
 class ControlData;
+struct CTREAppliedConstants;
 
 class DragonControlToCTREAdapter : public IDragonControlToVendorControlAdapter
 {
@@ -49,7 +50,8 @@ class DragonControlToCTREAdapter : public IDragonControlToVendorControlAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,                          
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
         ~DragonControlToCTREAdapter() = default;
 
@@ -76,11 +78,18 @@ class DragonControlToCTREAdapter : public IDragonControlToVendorControlAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo          
         );
+
+        void SelectProfileSlot
+        (
+            std::string                                                     networkTableName,
+            int                                                             controllerSlot
+        );
         
         std::string                                                         m_networkTableName;
         int                                                                 m_controllerSlot;
         ControlData*                                                        m_controlData;
         DistanceAngleCalcStruc                                              m_calcStruc;
         ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*          m_controller;
+        CTREAppliedConstants*                                               m_applied;
 
 };
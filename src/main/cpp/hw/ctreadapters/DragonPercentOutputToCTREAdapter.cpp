@@ -35,8 +35,9 @@ DragonPercentOutputToCTREAdapter::DragonPercentOutputToCTREAdapter
     int                                                             controllerSlot, 
     ControlData*                                                    controlInfo,          
     DistanceAngleCalcStruc                                          calcStruc,
-    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller   
-) : DragonControlToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller)
+    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+    CTREAppliedConstants*                                           appliedConstants
+) : DragonControlToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants)
 {
 
 }
@@ -38,6 +38,7 @@ namespace ctre
     }
 }
 class ControlData;
+struct CTREAppliedConstants;
 
 
 class DragonPercentOutputToCTREAdapter : public DragonControlToCTREAdapter
@@ -50,7 +51,8 @@ class DragonPercentOutputToCTREAdapter : public DragonControlToCTREAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
 
         ~DragonPercentOutputToCTREAdapter() = default;
@@ -38,6 +38,7 @@ namespace ctre
     }
 }
 class ControlData;
+struct CTREAppliedConstants;
 
 class DragonPositionDegreeToCTREAdapter : public DragonControlToCTREAdapter
 {
@@ -49,7 +50,8 @@ class DragonPositionDegreeToCTREAdapter : public DragonControlToCTREAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
 
         ~DragonPositionDegreeToCTREAdapter() = default;
@@ -41,6 +41,7 @@ namespace ctre
     }
 }
 class ControlData;
+struct CTREAppliedConstants;
 
 class DragonTrapezoidToCTREAdapter : public DragonControlToCTREAdapter
 {
@@ -52,7 +53,8 @@ class DragonTrapezoidToCTREAdapter : public DragonControlToCTREAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
 
         ~DragonTrapezoidToCTREAdapter() = default;
@@ -38,8 +38,9 @@ DragonVelocityDegreeToCTREAdapter::DragonVelocityDegreeToCTREAdapter
     int                                                             controllerSlot, 
     ControlData*                                                    controlInfo,          
     DistanceAngleCalcStruc                                          calcStruc,
-    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller   
-) : DragonControlToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller)
+    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+    CTREAppliedConstants*                                           appliedConstants
+) : DragonControlToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants)
 {
 }
 
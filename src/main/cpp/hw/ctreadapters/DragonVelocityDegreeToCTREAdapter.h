@@ -38,6 +38,7 @@ namespace ctre
     }
 }
 class ControlData;
+struct CTREAppliedConstants;
 
 class DragonVelocityDegreeToCTREAdapter : public DragonControlToCTREAdapter
 {
@@ -49,7 +50,8 @@ class DragonVelocityDegreeToCTREAdapter : public DragonControlToCTREAdapter
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
 
         ~DragonVelocityDegreeToCTREAdapter() = default;
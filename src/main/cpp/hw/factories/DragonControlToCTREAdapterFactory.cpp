@@ -69,13 +69,14 @@ DragonControlToCTREAdapterFactory* DragonControlToCTREAdapterFactory::GetFactory
 DragonControlToCTREAdapter* DragonControlToCTREAdapterFactory::CreatePercentOuptutAdapter
 (
     std::string                                                     networkTableName,  
-    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+    CTREAppliedConstants*                                           appliedConstants
 )
 {    
 
     ControlData controlInfo;
     DistanceAngleCalcStruc calcStruc;
-    return CreateAdapter(networkTableName, 0, &controlInfo, calcStruc, controller);
+    return CreateAdapter(networkTableName, 0, &controlInfo, calcStruc, controller, appliedConstants);
 }
 DragonControlToCTREAdapter* DragonControlToCTREAdapterFactory::CreateAdapter
 (
@@ -83,7 +84,8 @@ DragonControlToCTREAdapter* DragonControlToCTREAdapterFactory::CreateAdapter
     int                                                             controllerSlot, 
     ControlData*                                                    controlInfo,          
     DistanceAngleCalcStruc                                          calcStruc,                          
-    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+    ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+    CTREAppliedConstants*                                           appliedConstants
 )
 {
     if (controlInfo != nullptr && controller != nullptr)
@@ -91,38 +93,38 @@ DragonControlToCTREAdapter* DragonControlToCTREAdapterFactory::CreateAdapter
         switch (controlInfo->GetMode())
         {
             case ControlModes::CONTROL_TYPE::PERCENT_OUTPUT:
-                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::POSITION_ABSOLUTE:
                 break;
 
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
-                return new DragonPositionDegreeToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonPositionDegreeToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::POSITION_INCH:
-                return new DragonPositionInchToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonPositionInchToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
-                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::TRAPEZOID:		
-                return new DragonTrapezoidToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonTrapezoidToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::VELOCITY_DEGREES:
-                return new DragonVelocityDegreeToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonVelocityDegreeToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::VELOCITY_INCH:
-                return new DragonVelocityInchToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonVelocityInchToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::VELOCITY_RPS:
-                return new DragonVelocityRPSToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonVelocityRPSToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			case ControlModes::CONTROL_TYPE::CURRENT:
@@ -135,20 +137,20 @@ DragonControlToCTREAdapter* DragonControlToCTREAdapterFactory::CreateAdapter
                 break;
 
             case ControlModes::CONTROL_TYPE::VOLTAGE:
-                return new DragonVoltageToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonVoltageToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 
 			default:
                 string msg{"Invalid contrrol data "};
                 msg += to_string(controller->GetDeviceID());
 				Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonControlToCTREAdapterFactory"), string("CreateAdapter"), msg);
-                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+                return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
                 break;
 		}	
     }
     string msg{"Invalid contrrol information "};
     Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("DragonControlToCTREAdapterFactory"), string("CreateAdapter"), msg);
-    return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller);
+    return new DragonPercentOutputToCTREAdapter(networkTableName, controllerSlot, controlInfo, calcStruc, controller, appliedConstants);
 }
 
 
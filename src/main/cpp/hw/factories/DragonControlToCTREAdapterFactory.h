@@ -39,6 +39,7 @@ namespace ctre
 }
 class DragonControlToCTREAdapter;
 class ControlData;
+struct CTREAppliedConstants;
 
 class DragonControlToCTREAdapterFactory
 {
@@ -50,12 +51,14 @@ class DragonControlToCTREAdapterFactory
             int                                                             controllerSlot, 
             ControlData*                                                    controlInfo,          
             DistanceAngleCalcStruc                                          calcStruc,                          
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
         DragonControlToCTREAdapter* CreatePercentOuptutAdapter
         (
             std::string                                                     networkTableName,  
-            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller
+            ctre::phoenix::motorcontrol::can::WPI_BaseMotorController*      controller,
+            CTREAppliedConstants*                                           appliedConstants
         );
 
 
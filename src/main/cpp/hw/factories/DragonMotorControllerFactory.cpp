@@ -2,11 +2,15 @@
 #include <map>
 #include <string>
 
+#include <frc/RobotBase.h>
+
 #include <hw/factories/DragonMotorControllerFactory.h>        
 #include <hw/usages/MotorControllerUsage.h>
 #include <hw/DistanceAngleCalcStruc.h>
 #include <hw/DragonTalonSRX.h>
+#include <hw/DeviceConfigQueue.h>
 #include <hw/DragonFalcon.h>
+#include <hw/sim/DragonSimulation.h>
 #include <utils/Logger.h>
 
 #include <ctre/phoenix/motorcontrol/can/TalonSRX.h>
@@ -141,6 +145,21 @@ shared_ptr<IDragonMotorController> DragonMotorControllerFactory::CreateMotorCont
             talon->EnableVoltageCompensation(voltageCompensationSaturation);
         }
 
+        // the swerve modules count on the integrated sensor starting at zero; it has to be part of the
+        // queued configuration, anything written directly before it would be reset by the factory defaults
+        auto motorUsage = MotorControllerUsage::GetInstance()->GetUsage(usage);
+        auto required = motorUsage == MotorControllerUsage::MOTOR_CONTROLLER_USAGE::SWERVE_DRIVE || 
+                        motorUsage == MotorControllerUsage::MOTOR_CONTROLLER_USAGE::SWERVE_TURN;
+        if ( required )
+        {
+            talon->ConfigSelectedFeedbackSensor( FeedbackDevice::IntegratedSensor, 0, 50 );
+            talon->ConfigIntegratedSensorInitializationStrategy( ctre::phoenix::sensors::SensorInitializationStrategy::BootToZero, 50 );
+        }
+
+        // everything above only updated the falcon's configuration; a worker for its CAN bus sends it
+        // while the rest of robot.xml is parsed.  RobotInit only waits for the drive motors.
+        DeviceConfigQueue::GetInstance()->Add( talon, canBusName, required, [talon]() { talon->ApplyConfig(); } );
+
         /** **/
         controller.reset( talon );
     }
@@ -152,6 +171,10 @@ shared_ptr<IDragonMotorController> DragonMotorControllerFactory::CreateMotorCont
     if ( !hasError )
     {
         m_canmotorControllers[ canID ] = controller;
+        if ( frc::RobotBase::IsSimulation() )
+        {
+            DragonSimulation::GetInstance()->AddMotor( controller );
+        }
     }
 	return controller;
 }
@@ -23,6 +23,8 @@
 
 // FRC includes
 #include <frc/motorcontrol/MotorController.h>
+#include <units/current.h>
+#include <units/voltage.h>
 
 // Team 302 includes
 #include <hw/usages/MotorControllerUsage.h>
@@ -33,6 +35,16 @@
 #include <ctre/phoenix/motorcontrol/RemoteSensorSource.h>
 #include <ctre/phoenix/motorcontrol/StatusFrame.h>
 
+namespace ctre { namespace phoenix { namespace motorcontrol 
+{ 
+    class TalonFXSensorCollection;
+    namespace can 
+    { 
+        class WPI_TalonFX; 
+        class WPI_TalonSRX; 
+    } 
+} } }
+
 /// @interface IDragonMotorController
 /// @brief The general interface to motor mechanisms/controllers so that the specific mechanisms that use motors,
 ///        don't need to special case what motor controller is being used.
@@ -99,6 +111,20 @@ class IDragonMotorController
         /// @return std::shared_ptr<frc::SpeedControll> - pointer to the speed controller object
         virtual std::shared_ptr<frc::MotorController> GetSpeedController() const = 0;
 
+        /// @brief  Return the Talon FX behind this controller.  It is resolved when the controller is built and
+        ///         lives as long as it does, so hot paths can call it directly instead of casting the 
+        ///         GetSpeedController copy.
+        /// @return ctre::phoenix::motorcontrol::can::WPI_TalonFX* - the Talon FX or nullptr if this isn't a Falcon
+        virtual ctre::phoenix::motorcontrol::can::WPI_TalonFX* GetTalonFX() const { return nullptr; }
+
+        /// @brief  Return the Talon FX's integrated sensor (resolved once, like GetTalonFX)
+        /// @return ctre::phoenix::motorcontrol::TalonFXSensorCollection* - the sensor or nullptr if this isn't a Falcon
+        virtual ctre::phoenix::motorcontrol::TalonFXSensorCollection* GetIntegratedSensor() const { return nullptr; }
+
+        /// @brief  Return the Talon SRX behind this controller (resolved once, like GetTalonFX)
+        /// @return ctre::phoenix::motorcontrol::can::WPI_TalonSRX* - the Talon SRX or nullptr if this isn't a Talon SRX
+        virtual ctre::phoenix::motorcontrol::can::WPI_TalonSRX* GetTalonSRX() const { return nullptr; }
+
         // Setters
         virtual void Set(double value) = 0;
         virtual void SetRotationOffset(double rotations) = 0;
@@ -157,6 +183,25 @@ class IDragonMotorController
             bool enable
         ) = 0;
 
+        // Simulation
+        /// @brief  Return the voltage the controller is driving the motor with (simulation only)
+        /// @return units::volt_t - motor output voltage
+        virtual units::volt_t GetSimOutputVoltage() const = 0;
+
+        /// @brief  Feed the modeled motor state back into the controller's sensors (simulation only)
+        /// @param [in] units::volt_t       busVoltage - battery voltage at the controller
+        /// @param [in] double              motorRotations - motor shaft revolutions (before the gear ratio)
+        /// @param [in] double              motorRPS - motor shaft revolutions per second (before the gear ratio)
+        /// @param [in] units::ampere_t     current - current the motor is drawing
+        /// @return void
+        virtual void SetSimState
+        (
+            units::volt_t       busVoltage,
+            double              motorRotations,
+            double              motorRPS,
+            units::ampere_t     current
+        ) = 0;
+
     protected:
 
 };
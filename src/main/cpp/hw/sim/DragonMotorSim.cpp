@@ -0,0 +1,94 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cmath>
+#include <memory>
+
+// FRC includes
+#include <frc/simulation/DCMotorSim.h>
+#include <frc/system/plant/DCMotor.h>
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+#include <units/current.h>
+#include <units/moment_of_inertia.h>
+#include <units/time.h>
+#include <units/torque.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <hw/MotorData.h>
+#include <hw/interfaces/IDragonMotorController.h>
+#include <hw/sim/DragonMotorSim.h>
+
+// Third Party Includes
+
+using namespace std;
+
+/// @brief  Model a motor
+/// @param [in] std::shared_ptr<IDragonMotorController>             motor:      motor controller to simulate
+/// @param [in] units::moment_of_inertia::kilogram_square_meter_t   inertia:    inertia seen at the output of the gearing
+DragonMotorSim::DragonMotorSim
+(
+    shared_ptr<IDragonMotorController>                  motor,
+    units::moment_of_inertia::kilogram_square_meter_t   inertia
+) : m_motor(motor),
+    m_gearRatio(motor.get()->GetGearRatio() > 0.0 ? motor.get()->GetGearRatio() : 1.0),
+    m_sim(CreateMotorModel(motor.get()->GetMotorType()), m_gearRatio, inertia)
+{
+}
+
+/// @brief  Advance the model
+/// @param [in] units::time::second_t   dt:             time since the last update
+/// @param [in] units::volt_t           busVoltage:     battery voltage
+void DragonMotorSim::Update
+(
+    units::time::second_t   dt,
+    units::volt_t           busVoltage
+)
+{
+    m_sim.SetInputVoltage(m_motor.get()->GetSimOutputVoltage());
+    m_sim.Update(dt);
+
+    // the controller's sensor is on the motor shaft, before the gearing
+    units::angle::turn_t outputRotations = m_sim.GetAngularPosition();
+    units::angular_velocity::revolutions_per_minute_t outputRPM = m_sim.GetAngularVelocity();
+    m_motor.get()->SetSimState(busVoltage,
+                               outputRotations.to<double>() * m_gearRatio,
+                               outputRPM.to<double>() / 60.0 * m_gearRatio,
+                               m_sim.GetCurrentDraw());
+}
+
+/// @brief  Build the motor constants from the MotorData tables (Falcon 500 if the type is unknown)
+/// @param [in] IDragonMotorController::MOTOR_TYPE  type:   motor type from robot.xml
+/// @return frc::DCMotor    motor constants
+frc::DCMotor DragonMotorSim::CreateMotorModel
+(
+    IDragonMotorController::MOTOR_TYPE  type
+)
+{
+    auto data = MotorData::GetInstance();
+    if ( data->getStallCurrent(type) <= 0 || data->getFreeSpeed(type) <= 0 )
+    {
+        type = IDragonMotorController::MOTOR_TYPE::FALCON500;
+    }
+
+    return frc::DCMotor( units::voltage::volt_t(12.0),
+                         units::torque::newton_meter_t(data->getStallTorque(type)),
+                         units::current::ampere_t(data->getStallCurrent(type)),
+                         units::current::ampere_t(data->getFreeCurrent(type)),
+                         units::angular_velocity::revolutions_per_minute_t(data->getFreeSpeed(type)) );
+}
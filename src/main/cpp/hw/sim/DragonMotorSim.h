@@ -0,0 +1,85 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <memory>
+
+// FRC includes
+#include <frc/simulation/DCMotorSim.h>
+#include <frc/system/plant/DCMotor.h>
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+#include <units/current.h>
+#include <units/moment_of_inertia.h>
+#include <units/time.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+
+// Third Party Includes
+
+/// @class DragonMotorSim
+/// @brief DC motor model for one motor controller.  The motor constants come from MotorData and the gear
+///        ratio from the motor definition in robot.xml; each step reads the controller's output voltage and
+///        writes the modeled position, velocity and current back into its sensors.
+class DragonMotorSim
+{
+    public:
+        /// @brief  Model a motor
+        /// @param [in] std::shared_ptr<IDragonMotorController>             motor:      motor controller to simulate
+        /// @param [in] units::moment_of_inertia::kilogram_square_meter_t   inertia:    inertia seen at the output of the gearing
+        DragonMotorSim
+        (
+            std::shared_ptr<IDragonMotorController>             motor,
+            units::moment_of_inertia::kilogram_square_meter_t   inertia
+        );
+        DragonMotorSim() = delete;
+        ~DragonMotorSim() = default;
+
+        /// @brief  Advance the model
+        /// @param [in] units::time::second_t   dt:             time since the last update
+        /// @param [in] units::volt_t           busVoltage:     battery voltage
+        void Update
+        (
+            units::time::second_t   dt,
+            units::volt_t           busVoltage
+        );
+
+        /// @brief  Angle of the mechanism (after the gearing)
+        units::angle::radian_t GetAngle() const { return m_sim.GetAngularPosition(); }
+
+        /// @brief  Angular velocity of the mechanism (after the gearing)
+        units::angular_velocity::radians_per_second_t GetVelocity() const { return m_sim.GetAngularVelocity(); }
+
+        /// @brief  Current the motor is drawing
+        units::current::ampere_t GetCurrentDraw() const { return m_sim.GetCurrentDraw(); }
+
+        IDragonMotorController* GetMotor() const { return m_motor.get(); }
+
+    private:
+        /// @brief  Build the motor constants from the MotorData tables (Falcon 500 if the type is unknown)
+        static frc::DCMotor CreateMotorModel
+        (
+            IDragonMotorController::MOTOR_TYPE  type
+        );
+
+        std::shared_ptr<IDragonMotorController>     m_motor;
+        double                                      m_gearRatio;
+        frc::sim::DCMotorSim                        m_sim;
+};
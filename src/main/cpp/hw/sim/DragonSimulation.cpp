@@ -0,0 +1,120 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <memory>
+#include <vector>
+
+// FRC includes
+#include <frc/simulation/BatterySim.h>
+#include <frc/simulation/RoboRioSim.h>
+#include <units/current.h>
+#include <units/time.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+#include <hw/sim/DragonMotorSim.h>
+#include <hw/sim/DragonSimulation.h>
+#include <hw/usages/MotorControllerUsage.h>
+
+// Third Party Includes
+
+using namespace std;
+
+DragonSimulation* DragonSimulation::m_instance = nullptr;
+
+/// @brief  Find or create the simulation
+/// @return DragonSimulation*   the simulation
+DragonSimulation* DragonSimulation::GetInstance()
+{
+    if ( DragonSimulation::m_instance == nullptr )
+    {
+        DragonSimulation::m_instance = new DragonSimulation();
+    }
+    return DragonSimulation::m_instance;
+}
+
+DragonSimulation::DragonSimulation() : m_motors(),
+                                       m_batteryVoltage(units::voltage::volt_t(12.0))
+{
+}
+
+/// @brief  Add a model for a motor; the inertia is picked from what the motor is used for
+/// @param [in] std::shared_ptr<IDragonMotorController> motor:  motor controller to simulate
+void DragonSimulation::AddMotor
+(
+    shared_ptr<IDragonMotorController>  motor
+)
+{
+    if ( motor.get() == nullptr || GetMotorSim(motor.get()) != nullptr )
+    {
+        return;
+    }
+
+    auto inertia = kMechanismInertia;
+    switch ( motor.get()->GetType() )
+    {
+        case MotorControllerUsage::MOTOR_CONTROLLER_USAGE::SWERVE_DRIVE:
+            inertia = kDriveInertia;
+            break;
+
+        case MotorControllerUsage::MOTOR_CONTROLLER_USAGE::SWERVE_TURN:
+            inertia = kTurnInertia;
+            break;
+
+        default:
+            break;
+    }
+    m_motors.emplace_back( make_unique<DragonMotorSim>(motor, inertia) );
+}
+
+/// @brief  Find the model for a motor
+/// @param [in] const IDragonMotorController*   motor:  motor controller
+/// @return DragonMotorSim*     model (nullptr if the motor isn't simulated)
+DragonMotorSim* DragonSimulation::GetMotorSim
+(
+    const IDragonMotorController*   motor
+) const
+{
+    for ( auto& sim : m_motors )
+    {
+        if ( sim.get()->GetMotor() == motor )
+        {
+            return sim.get();
+        }
+    }
+    return nullptr;
+}
+
+/// @brief  Step every motor model and update the battery voltage from the current they draw
+/// @param [in] units::time::second_t   dt:     time since the last update
+void DragonSimulation::Update
+(
+    units::time::second_t   dt
+)
+{
+    vector<units::current::ampere_t> currents;
+    currents.reserve( m_motors.size() );
+    for ( auto& sim : m_motors )
+    {
+        sim.get()->Update( dt, m_batteryVoltage );
+        currents.emplace_back( sim.get()->GetCurrentDraw() );
+    }
+
+    m_batteryVoltage = frc::sim::BatterySim::Calculate( currents );
+    frc::sim::RoboRioSim::SetVInVoltage( m_batteryVoltage );
+}
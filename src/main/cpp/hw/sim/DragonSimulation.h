@@ -0,0 +1,83 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <memory>
+#include <vector>
+
+// FRC includes
+#include <units/moment_of_inertia.h>
+#include <units/time.h>
+#include <units/voltage.h>
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+#include <hw/sim/DragonMotorSim.h>
+
+// Third Party Includes
+
+/// @class DragonSimulation
+/// @brief Owns the motor models used when the robot program runs on the desktop.  The motor controller
+///        factory adds every motor it creates; Robot::SimulationPeriodic steps them all and then lets the
+///        chassis turn the modeled mechanisms into sensor readings (CANCoders, pigeon).
+class DragonSimulation
+{
+    public:
+        /// @brief  Find or create the simulation
+        /// @return DragonSimulation*   the simulation
+        static DragonSimulation* GetInstance();
+
+        /// @brief  Add a model for a motor; the inertia is picked from what the motor is used for
+        /// @param [in] std::shared_ptr<IDragonMotorController> motor:  motor controller to simulate
+        void AddMotor
+        (
+            std::shared_ptr<IDragonMotorController>     motor
+        );
+
+        /// @brief  Find the model for a motor
+        /// @param [in] const IDragonMotorController*   motor:  motor controller
+        /// @return DragonMotorSim*     model (nullptr if the motor isn't simulated)
+        DragonMotorSim* GetMotorSim
+        (
+            const IDragonMotorController*   motor
+        ) const;
+
+        /// @brief  Step every motor model and update the battery voltage from the current they draw
+        /// @param [in] units::time::second_t   dt:     time since the last update
+        void Update
+        (
+            units::time::second_t   dt
+        );
+
+        units::volt_t GetBatteryVoltage() const { return m_batteryVoltage; }
+
+    private:
+        DragonSimulation();
+        ~DragonSimulation() = default;
+
+        std::vector<std::unique_ptr<DragonMotorSim>>    m_motors;
+        units::volt_t                                   m_batteryVoltage;
+
+        // inertia at the output of the gearing:  a quarter of a ~55 kg robot on a 2 in wheel, a swerve
+        // module rotating about its steering axis and a generic roller/arm for everything else
+        const units::moment_of_inertia::kilogram_square_meter_t kDriveInertia = units::moment_of_inertia::kilogram_square_meter_t(0.035);
+        const units::moment_of_inertia::kilogram_square_meter_t kTurnInertia = units::moment_of_inertia::kilogram_square_meter_t(0.004);
+        const units::moment_of_inertia::kilogram_square_meter_t kMechanismInertia = units::moment_of_inertia::kilogram_square_meter_t(0.01);
+
+        static DragonSimulation*    m_instance;
+};
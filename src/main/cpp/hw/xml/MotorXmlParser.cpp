@@ -25,6 +25,7 @@
 // Team 302 includes
 #include <hw/DragonTalonSRX.h>
 #include <hw/factories/DragonMotorControllerFactory.h>
+#include <hw/FrameRateProfiles.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <utils/HardwareIDValidation.h>
 #include <utils/Logger.h>
@@ -80,6 +81,8 @@ shared_ptr<IDragonMotorController> MotorXmlParser::ParseXML
     bool enableVoltageCompensation = false;
     IDragonMotorController::MOTOR_TYPE motortype = IDragonMotorController::NONE;
     std::string canBusName("rio");
+    unsigned int fastFrameModes = 0;
+    unsigned int mediumFrameModes = 0;
 
 
     string mtype;
@@ -334,6 +337,16 @@ shared_ptr<IDragonMotorController> MotorXmlParser::ParseXML
         {
             reverseLimitSwitchNormallyOpen = attr.as_bool();
         }
+        // robot modes that need fast status frames (the motor is managed by FrameRateProfiles)
+        else if ( strcmp( attr.name(), "fastFrameModes") == 0 )
+        {
+            fastFrameModes = FrameRateProfiles::ParseModes( attr.value() );
+        }
+        // robot modes that only need some feedback (fastFrameModes wins if a mode is in both)
+        else if ( strcmp( attr.name(), "mediumFrameModes") == 0 )
+        {
+            mediumFrameModes = FrameRateProfiles::ParseModes( attr.value() );
+        }
         else if (strcmp( attr.name(), "voltageCompensationSaturation"))
         {
             voltageCompensationSaturation = attr.as_double();
@@ -377,6 +390,10 @@ shared_ptr<IDragonMotorController> MotorXmlParser::ParseXML
                                                                                          voltageCompensationSaturation,
                                                                                          enableVoltageCompensation,
                                                                                          motortype);
+        if ( controller.get() != nullptr && ( fastFrameModes != 0 || mediumFrameModes != 0 ) )
+        {
+            FrameRateProfiles::GetInstance()->Add( controller.get(), fastFrameModes, mediumFrameModes );
+        }
     }
     return controller;
 }
@@ -0,0 +1,114 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <string>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/DeviceConfigQueue.h>
+#include <mechanisms/base/Mech.h>
+#include <mechanisms/base/StateMgr.h>
+#include <mechanisms/MechanismFactory.h>
+#include <mechanisms/MechanismRegistry.h>
+#include <mechanisms/MechanismTypes.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+MechanismRegistry* MechanismRegistry::m_instance = nullptr;
+MechanismRegistry* MechanismRegistry::GetInstance()
+{
+    if ( MechanismRegistry::m_instance == nullptr )
+    {
+        MechanismRegistry::m_instance = new MechanismRegistry();
+    }
+    return MechanismRegistry::m_instance;
+}
+
+MechanismRegistry::MechanismRegistry() : m_mechanisms(),
+                                         m_built(false),
+                                         m_ranThisLoop(false)
+{
+}
+
+void MechanismRegistry::Build()
+{
+    m_mechanisms.clear();
+
+    auto factory = MechanismFactory::GetMechanismFactory();
+    for (auto i=MechanismTypes::MECHANISM_TYPE::UNKNOWN_MECHANISM+1; i<MechanismTypes::MECHANISM_TYPE::MAX_MECHANISM_TYPES; ++i)
+    {
+        auto mech = factory->GetMechanism(static_cast<MechanismTypes::MECHANISM_TYPE>(i));
+        auto stateMgr = mech != nullptr ? mech->GetStateMgr() : nullptr;
+        if (stateMgr != nullptr)
+        {
+            m_mechanisms.emplace_back(Entry{mech, stateMgr, mech->GetMotors(), false});
+        }
+    }
+    m_built = true;
+
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, string("MechanismRegistry"), string("mechanisms"), to_string(m_mechanisms.size()));
+}
+
+void MechanismRegistry::RunMechanismStates()
+{
+    if (m_ranThisLoop)
+    {
+        return;
+    }
+
+    if (!m_built)
+    {
+        Build();
+    }
+
+    m_ranThisLoop = true;
+    for (auto& entry : m_mechanisms)
+    {
+        // mechanism motors may still be getting configured after RobotInit
+        if (IsReady(entry))
+        {
+            entry.stateMgr->RunCurrentState();
+        }
+    }
+}
+
+bool MechanismRegistry::IsReady
+(
+    Entry&      entry
+) const
+{
+    if (!entry.ready)
+    {
+        auto queue = DeviceConfigQueue::GetInstance();
+        entry.ready = true;
+        for (auto motor : entry.motors)
+        {
+            entry.ready = entry.ready && (motor == nullptr || queue->IsConfigured(motor));
+        }
+    }
+    return entry.ready;
+}
+
+void MechanismRegistry::EndLoop()
+{
+    m_ranThisLoop = false;
+}
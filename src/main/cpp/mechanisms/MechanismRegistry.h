@@ -0,0 +1,77 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+class IDragonMotorController;
+class Mech;
+class StateMgr;
+
+/// @brief  The mechanisms robot.xml created, collected once after it is parsed so the periodic code walks a
+///         contiguous array instead of asking the MechanismFactory for every mechanism type each loop.
+///         RunMechanismStates runs each mechanism at most once per loop no matter how many mode methods 
+///         call it (e.g. teleop and an auton primitive); Robot::RobotPeriodic ends the loop.  A mechanism 
+///         only starts running once its own motors are configured, so one slow device doesn't hold up the rest.
+class MechanismRegistry
+{
+    public:
+        struct Entry
+        {
+            Mech*                                   mech;
+            StateMgr*                               stateMgr;
+            std::vector<IDragonMotorController*>    motors;     // checked against the DeviceConfigQueue until ready
+            bool                                    ready;
+        };
+
+        static MechanismRegistry* GetInstance();
+
+        /// @brief  Collect the mechanisms that have a state manager (call after robot.xml is parsed)
+        void Build();
+
+        /// @brief  Run each mechanism's current state unless they already ran this loop (mechanisms whose 
+        ///         motors are still being configured are skipped)
+        void RunMechanismStates();
+
+        /// @brief  Mark the end of the robot loop so the next RunMechanismStates runs the mechanisms again
+        void EndLoop();
+
+        const std::vector<Entry>& GetMechanisms() const { return m_mechanisms; }
+
+    private:
+        MechanismRegistry();
+        ~MechanismRegistry() = default;
+
+        /// @brief  true once every motor of the mechanism has its configuration written
+        bool IsReady
+        (
+            Entry&      entry
+        ) const;
+
+        static MechanismRegistry*   m_instance;
+
+        std::vector<Entry>          m_mechanisms;
+        bool                        m_built;
+        bool                        m_ranThisLoop;
+};
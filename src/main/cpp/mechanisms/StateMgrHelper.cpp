@@ -20,6 +20,7 @@
 #include <mechanisms/base/StateMgr.h>
 #include <mechanisms/controllers/MechanismTargetData.h>
 #include <mechanisms/MechanismFactory.h>
+#include <mechanisms/MechanismRegistry.h>
 #include <mechanisms/MechanismTypes.h>
 #include <mechanisms/StateMgrHelper.h>
 #include <mechanisms/StateStruc.h>
@@ -29,15 +30,7 @@ using namespace std;
 
 void StateMgrHelper::RunCurrentMechanismStates() 
 {
-    for (auto i=MechanismTypes::MECHANISM_TYPE::UNKNOWN_MECHANISM+1; i<MechanismTypes::MECHANISM_TYPE::MAX_MECHANISM_TYPES; ++i)
-    {
-        auto mech = MechanismFactory::GetMechanismFactory()->GetMechanism(static_cast<MechanismTypes::MECHANISM_TYPE>(i));
-        auto stateMgr = mech != nullptr ? mech->GetStateMgr() : nullptr;
-        if (stateMgr != nullptr)
-        {
-            stateMgr->RunCurrentState();
-        }
-    }   
+    MechanismRegistry::GetInstance()->RunMechanismStates();
 }
 
 IState* StateMgrHelper::CreateState
@@ -85,6 +85,13 @@ void Mech::LogHardwareInformation()
     // NO-OP - subclasses override when necessary
 }
 
+/// @brief the motors this mechanism drives (the MechanismRegistry waits for their configurations)
+/// @return std::vector<IDragonMotorController*> the motors; none in the base class
+vector<IDragonMotorController*> Mech::GetMotors() const
+{
+    return vector<IDragonMotorController*>();
+}
+
 void Mech::AddStateMgr
 (
     StateMgr*       mgr
@@ -18,12 +18,14 @@
 
 // C++ Includes
 #include <string>
+#include <vector>
 
 // Team 302 includes
 #include <mechanisms/base/ILoggableItem.h>
 #include <mechanisms/MechanismTypes.h>
 
 // Forward Declares
+class IDragonMotorController;
 class StateMgr;
 
 ///	 @class Mech
@@ -57,6 +59,10 @@ class Mech : public ILoggableItem
         /// @brief log data to the network table if it is activated and time period has past
         void LogHardwareInformation() override;
 
+        /// @brief the motors this mechanism drives (the MechanismRegistry waits for their configurations)
+        /// @return std::vector<IDragonMotorController*> the motors; none in the base class
+        virtual std::vector<IDragonMotorController*> GetMotors() const;
+
         virtual StateMgr* GetStateMgr() const;
         virtual void AddStateMgr
         (
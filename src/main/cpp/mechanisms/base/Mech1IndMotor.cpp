@@ -25,7 +25,8 @@
 // Team 302 includes
 #include <mechanisms/controllers/ControlData.h>
 #include <mechanisms/base/Mech1IndMotor.h>
-#include <mechanisms/base/Mech1IndMotor.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <mechanisms/controllers/RioMotorLoop.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <utils/Logger.h>
 
@@ -48,7 +49,9 @@ Mech1IndMotor::Mech1IndMotor
     std::shared_ptr<IDragonMotorController>     motorController
 ) : Mech(type, controlFileName, networkTableName),
     m_motor( motorController ),
-    m_target( 0.0 )
+    m_target( 0.0 ),
+    m_sample(),
+    m_loop( networkTableName, motorController )
 {
     if (m_motor.get() == nullptr )
     {
@@ -60,10 +63,7 @@ Mech1IndMotor::Mech1IndMotor
 
 void Mech1IndMotor::Update()
 {
-    if ( m_motor.get() != nullptr )
-    {
-        m_motor.get()->Set(m_target );
-    }
+    m_loop.SetTarget( m_target );
     LogHardwareInformation();
 }
 
@@ -80,7 +80,7 @@ void Mech1IndMotor::UpdateTarget
 double Mech1IndMotor::GetPosition() const
 
 {
-    return m_motor.get()->GetRotations() * 360.0;
+    return RobotStateMgr::GetInstance()->SampleMotor(m_motor.get(), m_sample).rotations * 360.0;
 }
 
 
@@ -88,7 +88,7 @@ double Mech1IndMotor::GetPosition() const
 double Mech1IndMotor::GetSpeed() const
 
 {
-    return m_motor.get()->GetRPS();
+    return RobotStateMgr::GetInstance()->SampleMotor(m_motor.get(), m_sample).rps;
 }
 
 
@@ -101,10 +101,15 @@ void Mech1IndMotor::SetControlConstants
     ControlData*                                pid                 
 )
 {
-    if ( m_motor.get() != nullptr )
-    {
-        m_motor.get()->SetControlConstants( slot, pid );
-    }
+    m_loop.SetControlConstants( slot, pid );
+}
+
+void Mech1IndMotor::SetRioSensor
+(
+    RioControlExecutor::Sensor                  sensor
+)
+{
+    m_loop.SetSensor( sensor );
 }
 
 
@@ -113,8 +118,8 @@ void Mech1IndMotor::SetControlConstants
 void Mech1IndMotor::LogHardwareInformation()
 {
     auto ntName = GetNetworkTableName();
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Speed", GetSpeed() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Position", GetPosition() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Target", GetTarget() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Speed", GetSpeed() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Position", GetPosition() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Target", GetTarget() );
 }
 
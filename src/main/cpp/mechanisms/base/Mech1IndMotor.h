@@ -17,12 +17,17 @@
 #pragma once
 
 // C++ Includes
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 // Team 302 includes
 #include <mechanisms/base/Mech.h>
 #include <mechanisms/MechanismTypes.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <mechanisms/controllers/RioMotorLoop.h>
+#include <RobotState.h>
 
 // forward declares
 class ControlModes;
@@ -75,13 +80,27 @@ class Mech1IndMotor :  public Mech
             int                                         slot,
             ControlData*                                pid                 
         );
+
+        /// @brief  Set the sensor used when the control data runs on the roboRIO (e.g. a potentiometer or 
+        ///         through-bore encoder).  Without one the motor's sensor is converted to the units of the 
+        ///         degree and revolution modes; the inch modes need this sensor (the motor doesn't know the 
+        ///         diameter) and run on the motor controller without it.
+        /// @param [in] RioControlExecutor::Sensor sensor - returns the value in the units of the control mode 
+        ///             and when it was sampled (RioControlExecutor::StampOnRead wraps a plain read)
+        void SetRioSensor
+        (
+            RioControlExecutor::Sensor                  sensor
+        );
+
         double GetTarget() const { return m_target; }
         std::shared_ptr<IDragonMotorController> GetMotor() const {return m_motor;}
+        std::vector<IDragonMotorController*> GetMotors() const override {return {m_motor.get()};}
 
     private:
-
         std::shared_ptr<IDragonMotorController>     m_motor;
         double                                      m_target;
+        mutable MotorSample                         m_sample;
+        RioMotorLoop                                m_loop;
 };
 
 
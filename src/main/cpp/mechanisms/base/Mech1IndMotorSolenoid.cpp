@@ -16,6 +16,7 @@
 // C++ Includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // Team 302 includes
 #include <mechanisms/base/Mech1IndMotor.h>
@@ -150,6 +151,10 @@ Mech1IndMotor* Mech1IndMotorSolenoid::Get1IndMotorMech() const
 {
     return m_motorMech;
 }
+vector<IDragonMotorController*> Mech1IndMotorSolenoid::GetMotors() const
+{
+    return m_motorMech != nullptr ? m_motorMech->GetMotors() : vector<IDragonMotorController*>();
+}
 Mech1Solenoid* Mech1IndMotorSolenoid::GetSolenoidMech() const
 {
     return m_solenoidMech;
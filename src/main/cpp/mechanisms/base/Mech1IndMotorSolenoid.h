@@ -19,6 +19,7 @@
 // C++ Includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // Team 302 includes
 #include <mechanisms/MechanismTypes.h>
@@ -94,6 +95,7 @@ class Mech1IndMotorSolenoid : public Mech
         bool IsSolenoidActivated() const;
         Mech1IndMotor* Get1IndMotorMech() const;
         Mech1Solenoid* GetSolenoidMech() const;
+        std::vector<IDragonMotorController*> GetMotors() const override;
 
     private:
         Mech1IndMotor*              m_motorMech;
@@ -129,8 +129,8 @@ void Mech1MotorState::Run()
     {
         m_mechanism->Update();
         auto ntName = m_mechanism->GetNetworkTableName();
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("Speed"), GetRPS());
+        LOG_DATA(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
+        LOG_DATA(LOGGER_LEVEL::PRINT, ntName, string("Speed"), GetRPS());
     }
 }
 
@@ -56,7 +56,7 @@ void Mech1ServoState::Run()
     {
         m_mechanism->SetAngle(m_target);
         auto ntName = m_mechanism->GetNetworkTableName();
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
+        LOG_DATA(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
     }
 }
 
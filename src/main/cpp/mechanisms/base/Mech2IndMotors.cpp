@@ -29,6 +29,8 @@
 #include <mechanisms/base/Mech1IndMotor.h>
 #include <mechanisms/base/Mech2IndMotors.h>
 #include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <mechanisms/controllers/RioMotorLoop.h>
 #include <hw/interfaces/IDragonMotorController.h>
 #include <utils/Logger.h>
 
@@ -54,7 +56,11 @@ Mech2IndMotors::Mech2IndMotors
     m_primary( primaryMotor),
     m_secondary( secondaryMotor),
     m_primaryTarget(0.0),
-    m_secondaryTarget(0.0)
+    m_secondaryTarget(0.0),
+    m_primarySample(),
+    m_secondarySample(),
+    m_primaryLoop( networkTableName + string( " primary" ), primaryMotor ),
+    m_secondaryLoop( networkTableName + string( " secondary" ), secondaryMotor )
 {
     if ( primaryMotor.get() == nullptr )
     {
@@ -73,14 +79,8 @@ Mech2IndMotors::Mech2IndMotors
 /// @return void 
 void Mech2IndMotors::Update()
 {
-    if ( m_primary.get() != nullptr )
-    {
-        m_primary.get()->Set(m_primaryTarget);
-    }
-    if ( m_secondary.get() != nullptr )
-    {
-        m_secondary.get()->Set(m_secondaryTarget);
-    }
+    m_primaryLoop.SetTarget(m_primaryTarget);
+    m_secondaryLoop.SetTarget(m_secondaryTarget);
 
     LogHardwareInformation();
 }
@@ -102,28 +102,28 @@ void Mech2IndMotors::UpdateTargets
 /// @return double	position in inches (translating mechanisms) or degrees (rotating mechanisms)
 double Mech2IndMotors::GetPrimaryPosition() const 
 {
-    return ( m_primary.get() != nullptr ) ? m_primary.get()->GetRotations() * 360.0 : 0.0;
+    return ( m_primary.get() != nullptr ) ? RobotStateMgr::GetInstance()->SampleMotor(m_primary.get(), m_primarySample).rotations * 360.0 : 0.0;
 }
 
 /// @brief  Return the current position of the secondary motor in the mechanism.  The value is in inches or degrees.
 /// @return double	position in inches (translating mechanisms) or degrees (rotating mechanisms)
 double Mech2IndMotors::GetSecondaryPosition() const 
 {
-    return ( m_secondary.get() != nullptr ) ? m_secondary.get()->GetRotations() * 360.0 : 0.0;
+    return ( m_secondary.get() != nullptr ) ? RobotStateMgr::GetInstance()->SampleMotor(m_secondary.get(), m_secondarySample).rotations * 360.0 : 0.0;
 }
 
 /// @brief  Get the current speed of the primary motor in the mechanism.  The value is in inches per second or degrees per second.
 /// @return double	speed in inches/second (translating mechanisms) or degrees/second (rotating mechanisms)
 double Mech2IndMotors::GetPrimarySpeed() const 
 {
-    return ( m_primary.get() != nullptr ) ? m_primary.get()->GetRPS() : 0.0;
+    return ( m_primary.get() != nullptr ) ? RobotStateMgr::GetInstance()->SampleMotor(m_primary.get(), m_primarySample).rps : 0.0;
 }
 
 /// @brief  Get the current speed of the secondary motor in the mechanism.  The value is in inches per second or degrees per second.
 /// @return double	speed in inches/second (translating mechanisms) or degrees/second (rotating mechanisms)
 double Mech2IndMotors::GetSecondarySpeed() const 
 {
-    return ( m_secondary.get() != nullptr ) ? m_secondary.get()->GetRPS() : 0.0;
+    return ( m_secondary.get() != nullptr ) ? RobotStateMgr::GetInstance()->SampleMotor(m_secondary.get(), m_secondarySample).rps : 0.0;
 }
 
 /// @brief  Set the control constants (e.g. PIDF values).
@@ -135,10 +135,7 @@ void Mech2IndMotors::SetControlConstants
     ControlData*                                pid                 
 ) 
 {
-    if ( m_primary.get() != nullptr )
-    {
-        m_primary.get()->SetControlConstants(slot, pid);
-    }
+    m_primaryLoop.SetControlConstants(slot, pid);
 }
 void Mech2IndMotors::SetSecondaryControlConstants
 (
@@ -146,10 +143,23 @@ void Mech2IndMotors::SetSecondaryControlConstants
     ControlData*                                pid                 
 ) 
 {
-    if ( m_secondary.get() != nullptr )
-    {
-        m_secondary.get()->SetControlConstants(slot, pid);
-    }    
+    m_secondaryLoop.SetControlConstants(slot, pid);
+}
+
+void Mech2IndMotors::SetPrimaryRioSensor
+(
+    RioControlExecutor::Sensor                  sensor
+)
+{
+    m_primaryLoop.SetSensor(sensor);
+}
+
+void Mech2IndMotors::SetSecondaryRioSensor
+(
+    RioControlExecutor::Sensor                  sensor
+)
+{
+    m_secondaryLoop.SetSensor(sensor);
 }
 
 
@@ -158,11 +168,11 @@ void Mech2IndMotors::LogHardwareInformation()
 {
     auto ntName = GetNetworkTableName();
 
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Speed - Primary", GetPrimarySpeed() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Speed - Secondary", GetSecondarySpeed() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Position - Primary", GetPrimaryPosition() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Position - Secondary", GetSecondaryPosition() );
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Target - Primary", m_primaryTarget);
-    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, "Target - Secondary", m_secondaryTarget);
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Speed - Primary", GetPrimarySpeed() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Speed - Secondary", GetSecondarySpeed() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Position - Primary", GetPrimaryPosition() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Position - Secondary", GetSecondaryPosition() );
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Target - Primary", m_primaryTarget);
+    LOG_DATA(LOGGER_LEVEL::PRINT, ntName, "Target - Secondary", m_secondaryTarget);
 }
 
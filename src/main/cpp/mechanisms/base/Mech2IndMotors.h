@@ -20,10 +20,14 @@
 // C++ Includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // Team 302 includes
 #include <mechanisms/base/Mech.h>
 #include <mechanisms/MechanismTypes.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <mechanisms/controllers/RioMotorLoop.h>
+#include <RobotState.h>
 
 // forward declares
 class ControlData;
@@ -92,18 +96,33 @@ class Mech2IndMotors : public Mech
             ControlData*                                pid                 
         );
 
+        /// @brief  Set the sensors used when the control data runs on the roboRIO (see Mech1IndMotor::SetRioSensor)
+        void SetPrimaryRioSensor
+        (
+            RioControlExecutor::Sensor                  sensor
+        );
+        void SetSecondaryRioSensor
+        (
+            RioControlExecutor::Sensor                  sensor
+        );
+
         double GetPrimaryTarget() const { return m_primaryTarget; }
         double GetSecondaryTarget() const { return m_secondaryTarget; }
 
         inline std::shared_ptr<IDragonMotorController> GetPrimaryMotor() const {return m_primary;};
         inline std::shared_ptr<IDragonMotorController> GetSecondaryMotor() const {return m_secondary;};
+        std::vector<IDragonMotorController*> GetMotors() const override {return {m_primary.get(), m_secondary.get()};}
 
     private: 
         std::shared_ptr<IDragonMotorController>     m_primary;
         std::shared_ptr<IDragonMotorController>     m_secondary;
         double                                      m_primaryTarget;
         double                                      m_secondaryTarget;
-        
+        mutable MotorSample                         m_primarySample;
+        mutable MotorSample                         m_secondarySample;
+        RioMotorLoop                                m_primaryLoop;
+        RioMotorLoop                                m_secondaryLoop;
+
 };
 
 
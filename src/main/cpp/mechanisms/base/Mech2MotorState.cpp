@@ -144,8 +144,8 @@ void Mech2MotorState::Run()
 {
     if ( m_mechanism != nullptr )
     {
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_mechanism->GetNetworkTableName(), string("target1"), m_primaryTarget);
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_mechanism->GetNetworkTableName(), string("target2"), m_secondaryTarget);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_mechanism->GetNetworkTableName(), string("target1"), m_primaryTarget);
+        LOG_DATA(LOGGER_LEVEL::PRINT, m_mechanism->GetNetworkTableName(), string("target2"), m_secondaryTarget);
         
         m_mechanism->Update();
         m_mechanism->LogHardwareInformation();
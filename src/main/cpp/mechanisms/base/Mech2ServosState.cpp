@@ -59,8 +59,8 @@ void Mech2ServosState::Run()
         m_mechanism->SetAngle(m_target);
         m_mechanism->SetAngle(m_target2);
         auto ntName = m_mechanism->GetNetworkTableName();
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
-        Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("Target2"), GetTarget2());
+        LOG_DATA(LOGGER_LEVEL::PRINT, ntName, string("Target"), GetTarget());
+        LOG_DATA(LOGGER_LEVEL::PRINT, ntName, string("Target2"), GetTarget2());
     }
 }
 
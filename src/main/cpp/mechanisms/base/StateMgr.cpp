@@ -14,21 +14,27 @@
 //====================================================================================================================================================
 
 // C++ Includes
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 // FRC includes
+#include <frc/Timer.h>
 #include <networktables/NetworkTableInstance.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 
 // Team 302 includes
+#include <hw/DragonDigitalInput.h>
+#include <hw/factories/DigitalInputFactory.h>
 #include <mechanisms/base/IState.h>
 #include <mechanisms/base/Mech.h>
 #include <mechanisms/base/StateMgr.h>
 #include <mechanisms/controllers/MechanismTargetData.h>
 #include <mechanisms/controllers/StateDataXmlParser.h>
+#include <mechanisms/controllers/StateTransitionData.h>
 #include <mechanisms/MechanismFactory.h>
 #include <mechanisms/StateMgrHelper.h>
 #include <mechanisms/StateStruc.h>
@@ -44,7 +50,15 @@ using namespace std;
 StateMgr::StateMgr() : m_mech(nullptr),
                        m_currentState(),
                        m_stateVector(),
-                       m_currentStateID(0)
+                       m_currentStateID(0),
+                       m_transitions(),
+                       m_stateNames(),
+                       m_sensorValues(),
+                       m_sensorsRead(false),
+                       m_stateStartTime(0.0),
+                       m_transitionCount(0),
+                       m_lastTransitionLatency(0.0),
+                       m_maxTransitionLatency(0.0)
 {
 }
 void StateMgr::Init
@@ -60,7 +74,8 @@ void StateMgr::Init
     {
         // Parse the configuration file 
         auto stateXML = make_unique<StateDataXmlParser>();
-        vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML(mech->GetType());
+        vector<StateTransitionData> transitions;
+        vector<MechanismTargetData*> targetData = stateXML.get()->ParseXML(mech->GetType(), transitions);
 
         if (targetData.empty())
         {
@@ -103,6 +118,169 @@ void StateMgr::Init
             	    Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, mech->GetNetworkTableName(), string("StateMgr::StateMgr"), string("state not found"));
                 }
             }
+
+            CompileTransitions(transitions, stateMap);
+            ResetTransitionInputs();
+        }
+    }
+}
+
+/// @brief  Build the dense transition table (one row per state id) from the state xml's transitions,
+///         resolving the state names and sensors once so the periodic check is only table lookups
+void StateMgr::CompileTransitions
+(
+    const vector<StateTransitionData>&  transitions,
+    const map<string,StateStruc>&       stateMap
+)
+{
+    m_transitions.assign(m_stateVector.size(), StateTransitions{vector<Transition>(), false});
+    m_stateNames.assign(m_stateVector.size(), string());
+    for ( auto& [name, struc] : stateMap )
+    {
+        if ( struc.id >= 0 && struc.id < static_cast<int>(m_stateNames.size()) )
+        {
+            m_stateNames[struc.id] = name;
+        }
+    }
+
+    auto stateID = [this, &stateMap](const string& name) -> int
+    {
+        auto itr = stateMap.find(name);
+        auto valid = itr != stateMap.end() && itr->second.id >= 0 && itr->second.id < static_cast<int>(m_stateVector.size()) &&
+                     m_stateVector[itr->second.id] != nullptr;
+        return valid ? itr->second.id : -1;
+    };
+
+    for ( auto& data : transitions )
+    {
+        auto to = stateID(data.toState);
+        auto anyState = data.fromState == string("ANY");
+        auto from = anyState ? -1 : stateID(data.fromState);
+        if ( to < 0 || ( !anyState && from < 0 ) )
+        {
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, m_mech->GetNetworkTableName(), string("StateMgr::CompileTransitions"), 
+                                         string("unknown state ") + ( to < 0 ? data.toState : data.fromState ));
+            continue;
+        }
+
+        // SetCurrentState ignores a change to the current state, so a self transition would match (and log)
+        // every loop without ever re-entering the state
+        if ( from == to )
+        {
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, m_mech->GetNetworkTableName(), string("StateMgr::CompileTransitions"), 
+                                         string("transition from a state to itself ignored ") + data.toState);
+            continue;
+        }
+
+        Transition transition{to, data.guard, nullptr, data.timeout, 0};
+        if ( data.guard == StateTransitionData::GUARD::SENSOR_ON || data.guard == StateTransitionData::GUARD::SENSOR_OFF )
+        {
+            transition.sensor = DigitalInputFactory::GetFactory()->GetInput(data.sensor);
+            if ( transition.sensor == nullptr )
+            {
+                Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, m_mech->GetNetworkTableName(), string("StateMgr::CompileTransitions"), 
+                                             string("missing sensor for transition to ") + data.toState);
+                continue;
+            }
+        }
+
+        auto polled = data.guard == StateTransitionData::GUARD::AT_TARGET || data.guard == StateTransitionData::GUARD::TIMEOUT;
+        for ( auto slot = 0; slot < static_cast<int>(m_transitions.size()); ++slot )
+        {
+            if ( ( anyState && slot != to ) || slot == from )
+            {
+                m_transitions[slot].transitions.emplace_back(transition);
+                m_transitions[slot].polled = m_transitions[slot].polled || polled;
+            }
+        }
+    }
+}
+
+/// @brief  Start the current state's guards over: its timeouts start now and its sensors are read fresh
+void StateMgr::ResetTransitionInputs()
+{
+    m_stateStartTime = frc::Timer::GetFPGATimestamp().to<double>();
+    auto rows = m_transitions.size();
+    m_sensorValues.assign( static_cast<size_t>(m_currentStateID) < rows ? m_transitions[m_currentStateID].transitions.size() : 0, false);
+    m_sensorsRead = false;
+}
+
+/// @brief  Take the first of the current state's transitions whose guard is true.  The guards are only checked
+///         when one of their sensors changed or the state has AT_TARGET/TIMEOUT guards.
+void StateMgr::EvaluateTransitions()
+{
+    if ( m_currentStateID < 0 || static_cast<size_t>(m_currentStateID) >= m_transitions.size() )
+    {
+        return;
+    }
+
+    auto& row = m_transitions[m_currentStateID];
+    if ( row.transitions.empty() )
+    {
+        return;
+    }
+
+    auto changed = !m_sensorsRead;
+    for ( size_t inx = 0; inx < row.transitions.size(); ++inx )
+    {
+        auto sensor = row.transitions[inx].sensor;
+        if ( sensor != nullptr )
+        {
+            auto value = sensor->Get();
+            changed = changed || value != m_sensorValues[inx];
+            m_sensorValues[inx] = value;
+        }
+    }
+    m_sensorsRead = true;
+
+    if ( !changed && !row.polled )
+    {
+        return;
+    }
+
+    auto now = frc::Timer::GetFPGATimestamp().to<double>();
+    for ( size_t inx = 0; inx < row.transitions.size(); ++inx )
+    {
+        auto& transition = row.transitions[inx];
+        auto guardTime = now;
+        auto fire = false;
+        switch ( transition.guard )
+        {
+            case StateTransitionData::GUARD::AT_TARGET:
+                fire = m_currentState != nullptr && m_currentState->AtTarget();
+                break;
+
+            case StateTransitionData::GUARD::TIMEOUT:
+                guardTime = m_stateStartTime + transition.timeout;
+                fire = now >= guardTime;
+                break;
+
+            case StateTransitionData::GUARD::SENSOR_ON:
+                fire = m_sensorValues[inx];
+                break;
+
+            case StateTransitionData::GUARD::SENSOR_OFF:
+                fire = !m_sensorValues[inx];
+                break;
+
+            default:
+                break;
+        }
+
+        if ( fire )
+        {
+            auto from = m_currentStateID;
+            ++transition.count;
+            SetCurrentState(transition.toState, false);
+
+            ++m_transitionCount;
+            m_lastTransitionLatency = frc::Timer::GetFPGATimestamp().to<double>() - guardTime;
+            m_maxTransitionLatency = max(m_maxTransitionLatency, m_lastTransitionLatency);
+
+            auto msg = m_stateNames[from] + string(" -> ") + m_stateNames[m_currentStateID] + string(" (") + 
+                       to_string(transition.count) + string(" times) latency ms ") + to_string(1000.0 * m_lastTransitionLatency);
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, m_mech->GetNetworkTableName(), string("transition"), msg);
+            break;
         }
     }
 }
@@ -114,6 +292,7 @@ void StateMgr::RunCurrentState()
     if ( m_mech != nullptr )
     {
         CheckForStateTransition();
+        EvaluateTransitions();
 
         // run the current state
         if ( m_currentState != nullptr )
@@ -158,6 +337,7 @@ void StateMgr::SetCurrentState
             m_currentState = state;
             m_currentStateID = stateID;       
             m_currentState->Init();
+            ResetTransitionInputs();
             
             // Run current new state if requested
             if ( run )
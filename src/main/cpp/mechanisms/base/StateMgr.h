@@ -18,13 +18,16 @@
 
 // C++ Includes
 #include <map>
+#include <string>
 #include <vector>
 
 // Team 302 includes
 #include <mechanisms/base/IState.h>
+#include <mechanisms/controllers/StateTransitionData.h>
 #include <mechanisms/StateStruc.h>
 
 // forward declare 
+class DragonDigitalInput;
 class Mech;
 
 // Third Party Includes
@@ -60,16 +63,55 @@ class StateMgr
         inline int GetCurrentState() const { return m_currentStateID; };
         inline IState* GetCurrentStatePtr() const { return m_stateVector[m_currentStateID]; };
 
+        /// @brief  number of transitions taken from the state xml's transition table
+        inline int GetTransitionCount() const { return m_transitionCount; };
+
+        /// @brief  seconds from a transition's guard being seen true (or its timeout expiring) until the new
+        ///         state is initialized, for the last transition and the worst one
+        inline double GetLastTransitionLatency() const { return m_lastTransitionLatency; };
+        inline double GetMaxTransitionLatency() const { return m_maxTransitionLatency; };
+
     protected:
         virtual void CheckForStateTransition();
 
     private:
+        struct Transition
+        {
+            int                             toState;
+            StateTransitionData::GUARD      guard;
+            DragonDigitalInput*             sensor;
+            double                          timeout;
+            int                             count;
+        };
+
+        struct StateTransitions
+        {
+            std::vector<Transition>         transitions;    // checked in order, the first true guard wins
+            bool                            polled;         // has AT_TARGET or TIMEOUT guards, so it is checked every loop
+        };
+
+        void CompileTransitions
+        (
+            const std::vector<StateTransitionData>&     transitions,
+            const std::map<std::string,StateStruc>&     stateMap
+        );
+        void EvaluateTransitions();
+        void ResetTransitionInputs();
 
         Mech*                   m_mech;
         IState*                 m_currentState;
         std::vector<IState*>    m_stateVector;
         int                     m_currentStateID;
 
+        std::vector<StateTransitions>   m_transitions;          // indexed by state id
+        std::vector<std::string>        m_stateNames;           // indexed by state id
+        std::vector<bool>               m_sensorValues;         // last reading for each of the current state's transitions
+        bool                            m_sensorsRead;          // m_sensorValues is valid for the current state
+        double                          m_stateStartTime;
+        int                             m_transitionCount;
+        double                          m_lastTransitionLatency;
+        double                          m_maxTransitionLatency;
+
 };
 
 
@@ -13,40 +13,54 @@
 // OR OTHER DEALINGS IN THE SOFTWARE.
 //====================================================================================================================================================
 
+#include <mutex>
+
 #include <frc/Timer.h>
 
 #include <mechanisms/controllers/ControlData.h>
 #include <mechanisms/controllers/DragonPID.h>
+#include <mechanisms/controllers/PIDEngine.h>
+
+using namespace std;
+
+PIDEngine DragonPID::m_engine;
+mutex DragonPID::m_engineMutex;
 
 DragonPID::DragonPID
 (
     ControlData*        controlData
-) : m_kP(controlData->GetP()),
-    m_kI(controlData->GetI()),
-    m_kD(controlData->GetD()),
-    m_kF(controlData->GetF()),
-    m_accumError(0.0),
-    m_prevError(0.0),
-    m_timer(new frc::Timer())
+) : m_channel(-1),
+    m_lastTime(frc::Timer::GetFPGATimestamp().to<double>())
 {
-    m_timer->Start();
+    lock_guard<mutex> lock(m_engineMutex);
+    m_channel = m_engine.AddChannel(controlData);
+}
+
+DragonPID::~DragonPID()
+{
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.RemoveChannel(m_channel);
 }
 
 void DragonPID::UpdateKP(double kP)
 {
-    m_kP = kP;
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.SetKP(m_channel, kP);
 }
 void DragonPID::UpdateKI(double kI)
 {
-    m_kI = kI;
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.SetKI(m_channel, kI);
 }
 void DragonPID::UpdateKD(double kD)
 {
-    m_kD = kD;
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.SetKD(m_channel, kD);
 }
 void DragonPID::UpdateKF(double kF)
 {
-    m_kF = kF;
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.SetKF(m_channel, kF);
 }
 
 double DragonPID::Calculate
@@ -56,12 +70,23 @@ double DragonPID::Calculate
     double targetVal
 )
 {
-    auto error = targetVal - currentVal;
-    m_accumError += error;
-    auto deltaT = m_timer->Get().to<double>();
-    m_timer->Reset();
-    auto deltaErr = error - m_prevError;
-    m_prevError = error;
+    auto now = frc::Timer::GetFPGATimestamp().to<double>();
+    auto deltaT = now - m_lastTime;
+    m_lastTime = now;
+    return Calculate(motorOutput, currentVal, targetVal, deltaT);
+}
 
-    return motorOutput + m_kP*error + m_kI*m_accumError + m_kD*deltaErr/deltaT + m_kF;
-}
\ No newline at end of file
+double DragonPID::Calculate
+(
+    double motorOutput,
+    double currentVal,
+    double targetVal,
+    double deltaT
+)
+{
+    lock_guard<mutex> lock(m_engineMutex);
+    m_engine.SetBias(m_channel, motorOutput);
+    m_engine.SetTarget(m_channel, targetVal);
+    m_engine.SetMeasurement(m_channel, currentVal);
+    return m_engine.Update(m_channel, deltaT);
+}
@@ -15,11 +15,14 @@
 
 #pragma once
 
-#include <frc/Timer.h>
+#include <mutex>
 
 #include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/PIDEngine.h>
 
-
+/// @brief  Single PID controller kept for existing callers; it is a channel in a shared PIDEngine, so it gets 
+///         the engine's anti-windup and derivative on measurement.  New code that runs several controllers
+///         together should use a PIDEngine directly.
 class DragonPID
 {
     public:
@@ -29,7 +32,9 @@ class DragonPID
         );
 
         DragonPID() = delete;
-        ~DragonPID() = default;
+        DragonPID(const DragonPID&) = delete;
+        DragonPID& operator=(const DragonPID&) = delete;
+        ~DragonPID();
 
         void UpdateKP(double kP);
         void UpdateKI(double kI);
@@ -43,12 +48,21 @@ class DragonPID
             double targetVal
         );
 
+        /// @brief  Calculate with the time since the last sensor reading supplied by the caller (e.g. from 
+        ///         timestamped reads) instead of the time since the last call
+        /// @param [in] double  deltaT - seconds between the previous and current sensor readings
+        double Calculate
+        (
+            double motorOutput,
+            double currentVal,
+            double targetVal,
+            double deltaT
+        );
+
     private:
-        double                              m_kP;
-        double                              m_kI;
-        double                              m_kD;
-        double                              m_kF;
-        double                              m_accumError;
-        double                              m_prevError;
-        frc::Timer*                         m_timer;
+        static PIDEngine                    m_engine;
+        static std::mutex                   m_engineMutex;
+
+        int                                 m_channel;
+        double                              m_lastTime;
 };
\ No newline at end of file
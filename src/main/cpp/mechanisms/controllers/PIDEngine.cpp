@@ -0,0 +1,316 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/PIDEngine.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+int PIDEngine::AddChannel
+(
+    const ControlData*      controlData
+)
+{
+    int channel = 0;
+    if ( !m_free.empty() )
+    {
+        channel = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        channel = static_cast<int>(m_used.size());
+        for ( auto array : { &m_kP, &m_kI, &m_kD, &m_kF, &m_iZone, &m_minOutput, &m_maxOutput, &m_slewRate, 
+                             &m_target, &m_measurement, &m_bias, &m_integral, &m_prevMeasurement, &m_primed, 
+                             &m_sampleTime, &m_sampleDt, &m_timestamped, &m_output, &m_enabled } )
+        {
+            array->emplace_back(0.0);
+        }
+        m_used.emplace_back(false);
+    }
+
+    m_used[channel] = true;
+    m_target[channel] = 0.0;
+    m_measurement[channel] = 0.0;
+    m_bias[channel] = 0.0;
+    m_timestamped[channel] = 0.0;
+    m_slewRate[channel] = 0.0;
+    m_minOutput[channel] = -numeric_limits<double>::max();
+    m_maxOutput[channel] = numeric_limits<double>::max();
+    m_enabled[channel] = 1.0;
+    Reset(channel);
+    SetGains(channel, controlData);
+    return channel;
+}
+
+void PIDEngine::RemoveChannel
+(
+    int                     channel
+)
+{
+    if ( IsValid(channel) )
+    {
+        m_used[channel] = false;
+        SetKP(channel, 0.0);
+        SetKI(channel, 0.0);
+        SetKD(channel, 0.0);
+        SetKF(channel, 0.0);
+        Reset(channel);
+        m_enabled[channel] = 0.0;
+        m_free.emplace_back(channel);
+    }
+}
+
+void PIDEngine::SetGains
+(
+    int                     channel,
+    const ControlData*      controlData
+)
+{
+    if ( !IsValid(channel) || controlData == nullptr )
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("PIDEngine"), string("SetGains"), string("invalid channel or control data"));
+        return;
+    }
+
+    m_kP[channel] = controlData->GetP();
+    m_kI[channel] = controlData->GetI();
+    m_kD[channel] = controlData->GetD();
+    m_kF[channel] = controlData->GetF();
+    m_iZone[channel] = controlData->GetIZone();
+    if ( controlData->GetPeakValue() > 0.0 )
+    {
+        SetOutputLimits(channel, -controlData->GetPeakValue(), controlData->GetPeakValue());
+    }
+}
+
+void PIDEngine::SetKP(int channel, double kP)
+{
+    if ( IsValid(channel) )
+    {
+        m_kP[channel] = kP;
+    }
+}
+void PIDEngine::SetKI(int channel, double kI)
+{
+    if ( IsValid(channel) )
+    {
+        m_kI[channel] = kI;
+    }
+}
+void PIDEngine::SetKD(int channel, double kD)
+{
+    if ( IsValid(channel) )
+    {
+        m_kD[channel] = kD;
+    }
+}
+void PIDEngine::SetKF(int channel, double kF)
+{
+    if ( IsValid(channel) )
+    {
+        m_kF[channel] = kF;
+    }
+}
+
+void PIDEngine::SetOutputLimits
+(
+    int                     channel,
+    double                  minOutput,
+    double                  maxOutput
+)
+{
+    if ( IsValid(channel) && minOutput <= maxOutput )
+    {
+        m_minOutput[channel] = minOutput;
+        m_maxOutput[channel] = maxOutput;
+    }
+}
+
+void PIDEngine::SetSlewRate
+(
+    int                     channel,
+    double                  ratePerSecond
+)
+{
+    if ( IsValid(channel) )
+    {
+        m_slewRate[channel] = max(ratePerSecond, 0.0);
+    }
+}
+
+void PIDEngine::Reset
+(
+    int                     channel
+)
+{
+    if ( IsValid(channel) )
+    {
+        m_integral[channel] = 0.0;
+        m_prevMeasurement[channel] = 0.0;
+        m_primed[channel] = 0.0;
+        m_sampleTime[channel] = 0.0;
+        m_sampleDt[channel] = 0.0;
+        m_output[channel] = 0.0;
+    }
+}
+
+void PIDEngine::SetEnabled
+(
+    int                     channel,
+    bool                    enabled
+)
+{
+    if ( IsValid(channel) )
+    {
+        Reset(channel);
+        m_enabled[channel] = enabled ? 1.0 : 0.0;
+    }
+}
+
+void PIDEngine::SetTarget(int channel, double target)
+{
+    m_target[channel] = target;
+}
+void PIDEngine::SetMeasurement(int channel, double measurement)
+{
+    m_measurement[channel] = measurement;
+}
+void PIDEngine::SetMeasurement
+(
+    int                     channel,
+    double                  measurement,
+    double                  timestamp
+)
+{
+    m_measurement[channel] = measurement;
+    m_sampleDt[channel] = m_sampleTime[channel] > 0.0 ? max(timestamp - m_sampleTime[channel], 0.0) : 0.0;
+    m_sampleTime[channel] = max(timestamp, m_sampleTime[channel]);
+    m_timestamped[channel] = 1.0;
+}
+void PIDEngine::SetBias(int channel, double bias)
+{
+    m_bias[channel] = bias;
+}
+
+void PIDEngine::Update
+(
+    double                  dt
+)
+{
+    Step(0, static_cast<int>(m_output.size()), dt);
+}
+
+double PIDEngine::Update
+(
+    int                     channel,
+    double                  dt
+)
+{
+    if ( !IsValid(channel) )
+    {
+        return 0.0;
+    }
+    Step(channel, channel+1, dt);
+    return m_output[channel];
+}
+
+/// @brief  Run the channels in [begin, end).  The body has no branches or conditional expressions: conditions 
+///         are comparisons turned into 0.0/1.0 masks that scale the terms, and limits use fmin/fmax.  Whether that 
+///         becomes SIMD code depends on the target and the floating point flags (GCC vectorizes it on x86 with 
+///         -fno-trapping-math -ffinite-math-only -fno-signed-zeros; the roboRIO's NEON has no double lanes), 
+///         but no channel's path depends on its data.  Unused and disabled channels are held at zero output 
+///         with no integral.
+void PIDEngine::Step
+(
+    int                     begin,
+    int                     end,
+    double                  dt
+)
+{
+    auto unlimited = numeric_limits<double>::max();
+
+    const double* kP = m_kP.data();
+    const double* kI = m_kI.data();
+    const double* kD = m_kD.data();
+    const double* kF = m_kF.data();
+    const double* iZone = m_iZone.data();
+    const double* minOut = m_minOutput.data();
+    const double* maxOut = m_maxOutput.data();
+    const double* slew = m_slewRate.data();
+    const double* target = m_target.data();
+    const double* measurement = m_measurement.data();
+    const double* bias = m_bias.data();
+    double* integral = m_integral.data();
+    double* prevMeasurement = m_prevMeasurement.data();
+    double* primed = m_primed.data();
+    double* output = m_output.data();
+    const double* enabled = m_enabled.data();
+    const double* sampleDt = m_sampleDt.data();
+    const double* timestamped = m_timestamped.data();
+
+    for ( int inx=begin; inx<end; ++inx )
+    {
+        // channels with sample times run over the time between their samples; a zero dt gives 1/dt = 0
+        auto channelDt = fmax(timestamped[inx]*sampleDt[inx] + (1.0 - timestamped[inx])*dt, 0.0);
+        auto hasDt = static_cast<double>(channelDt > 0.0);
+        auto invDt = hasDt / (channelDt + 1.0 - hasDt);
+
+        auto error = target[inx] - measurement[inx];
+
+        // anti-windup: hold the integral while the last output was saturated in the direction of the error,
+        // reset it outside the izone and keep its contribution within the output limits (the two saturated
+        // cases can't both be true, so their sum is a mask)
+        auto saturated = static_cast<double>(output[inx] >= maxOut[inx]) * static_cast<double>(error > 0.0) + 
+                         static_cast<double>(output[inx] <= minOut[inx]) * static_cast<double>(error < 0.0);
+        auto inZone = fmax(static_cast<double>(iZone[inx] <= 0.0), static_cast<double>(fabs(error) <= iZone[inx]));
+        auto iTerm = (integral[inx] + (1.0 - saturated)*kI[inx]*error*channelDt) * inZone;
+        iTerm = fmin(fmax(iTerm, minOut[inx]), maxOut[inx]) * enabled[inx];
+        integral[inx] = iTerm;
+
+        // derivative on measurement: no kick when the target changes
+        auto dTerm = -kD[inx] * (measurement[inx] - prevMeasurement[inx]) * invDt * primed[inx];
+        prevMeasurement[inx] = measurement[inx];
+        primed[inx] = enabled[inx];
+
+        auto out = bias[inx] + kP[inx]*error + iTerm + dTerm + kF[inx];
+        out = fmin(fmax(out, minOut[inx]), maxOut[inx]);
+
+        auto hasSlew = static_cast<double>(slew[inx] > 0.0);
+        auto step = hasSlew*slew[inx]*channelDt + (1.0 - hasSlew)*unlimited;
+        output[inx] = fmin(fmax(out, output[inx]-step), output[inx]+step) * enabled[inx];
+    }
+}
+
+bool PIDEngine::IsValid
+(
+    int                     channel
+) const
+{
+    return channel >= 0 && channel < static_cast<int>(m_used.size()) && m_used[channel];
+}
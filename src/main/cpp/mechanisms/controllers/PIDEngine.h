@@ -0,0 +1,167 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+
+// Third Party Includes
+
+class ControlData;
+
+/// @brief  PID/feedforward controllers stored as a structure of arrays so every channel is updated in one 
+///         branch-free pass (each over its own sample interval when its measurements have sample times).  
+///         Each channel has:
+///         - derivative on measurement, so target changes don't kick the output
+///         - anti-windup: the integral term is clamped to the output limits and stops accumulating while the 
+///           output is saturated in the direction of the error; it is reset outside the izone
+///         - an optional output slew limit (output units per second)
+///         - gains that can be swapped while running without a bump (the integral is stored as its 
+///           contribution to the output)
+///         - time based gains: the integral accumulates kI * error * dt and the derivative is per second, so 
+///           the gains don't depend on the update rate (these aren't the motor controllers' per-1 ms units)
+///         - an enable flag, so idle channels are held at zero without branching in the update
+///         The engine allocates only when channels are added; it isn't thread safe, so the owner serializes
+///         access.
+class PIDEngine
+{
+    public:
+        PIDEngine() = default;
+        ~PIDEngine() = default;
+
+        /// @brief  Add a channel using the gains, izone and peak value (output limit when > 0) from the control data
+        /// @return int - channel handle
+        int AddChannel
+        (
+            const ControlData*      controlData
+        );
+
+        void RemoveChannel
+        (
+            int                     channel
+        );
+
+        /// @brief  Swap the gains, izone and output limits while running; the integral and output are kept
+        void SetGains
+        (
+            int                     channel,
+            const ControlData*      controlData
+        );
+        void SetKP(int channel, double kP);
+        void SetKI(int channel, double kI);
+        void SetKD(int channel, double kD);
+        void SetKF(int channel, double kF);
+
+        void SetOutputLimits
+        (
+            int                     channel,
+            double                  minOutput,
+            double                  maxOutput
+        );
+
+        /// @brief  Limit how fast the output can change, in output units per second (0 disables the limit)
+        void SetSlewRate
+        (
+            int                     channel,
+            double                  ratePerSecond
+        );
+
+        /// @brief  Clear the integral, derivative history and output
+        void Reset
+        (
+            int                     channel
+        );
+
+        /// @brief  A disabled channel keeps its gains but is reset and held at zero output by Update, so it 
+        ///         doesn't integrate a stale error while its owner isn't using it (channels start enabled)
+        void SetEnabled
+        (
+            int                     channel,
+            bool                    enabled
+        );
+
+        void SetTarget(int channel, double target);
+        void SetMeasurement(int channel, double measurement);
+
+        /// @brief  Set a measurement and the time (seconds) it was sampled.  From then on the channel's updates 
+        ///         use the time between its samples instead of the dt passed to Update; a sample that isn't 
+        ///         newer than the previous one has a dt of zero, so it doesn't integrate, differentiate or slew.
+        void SetMeasurement
+        (
+            int                     channel,
+            double                  measurement,
+            double                  timestamp
+        );
+
+        /// @brief  Value added to the output before it is limited (e.g. an open loop output being corrected)
+        void SetBias(int channel, double bias);
+
+        /// @brief  Update every channel
+        /// @param [in] double  dt - seconds since the previous update (for channels without sample times)
+        void Update
+        (
+            double                  dt
+        );
+
+        /// @brief  Update a single channel
+        /// @return double - the new output
+        double Update
+        (
+            int                     channel,
+            double                  dt
+        );
+
+        double GetOutput(int channel) const { return m_output[channel]; }
+
+    private:
+        void Step
+        (
+            int                     begin,
+            int                     end,
+            double                  dt
+        );
+        bool IsValid
+        (
+            int                     channel
+        ) const;
+
+        std::vector<double>     m_kP;
+        std::vector<double>     m_kI;
+        std::vector<double>     m_kD;
+        std::vector<double>     m_kF;
+        std::vector<double>     m_iZone;
+        std::vector<double>     m_minOutput;
+        std::vector<double>     m_maxOutput;
+        std::vector<double>     m_slewRate;
+        std::vector<double>     m_target;
+        std::vector<double>     m_measurement;
+        std::vector<double>     m_bias;
+        std::vector<double>     m_integral;         // kI * accumulated error
+        std::vector<double>     m_prevMeasurement;
+        std::vector<double>     m_primed;           // 1.0 once m_prevMeasurement is valid
+        std::vector<double>     m_sampleTime;       // time of the latest measurement (0 until there is one)
+        std::vector<double>     m_sampleDt;         // time between the latest two measurements
+        std::vector<double>     m_timestamped;      // 1.0 if the measurements have sample times
+        std::vector<double>     m_output;
+        std::vector<double>     m_enabled;          // 1.0 while the channel runs, 0.0 holds it reset
+        std::vector<bool>       m_used;
+        std::vector<int>        m_free;
+};
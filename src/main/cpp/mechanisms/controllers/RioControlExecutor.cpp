@@ -0,0 +1,312 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// FRC includes
+#include <frc/DriverStation.h>
+#include <frc/Notifier.h>
+#include <frc/Timer.h>
+#include <units/time.h>
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+#include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/ControlModes.h>
+#include <mechanisms/controllers/PIDEngine.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <utils/InputRecorder.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+namespace
+{
+    constexpr double PERIOD = 0.005;            // seconds
+    constexpr double LATE = 1.5 * PERIOD;       // a callback starting this long after the previous one overran
+    constexpr int PUBLISH_CYCLES = 1000;        // 5 seconds
+}
+
+RioControlExecutor* RioControlExecutor::m_instance = nullptr;
+RioControlExecutor* RioControlExecutor::GetInstance()
+{
+    if ( RioControlExecutor::m_instance == nullptr )
+    {
+        RioControlExecutor::m_instance = new RioControlExecutor();
+    }
+    return RioControlExecutor::m_instance;
+}
+
+RioControlExecutor::RioControlExecutor() : m_loops(),
+                                           m_engine(),
+                                           m_notifier(),
+                                           m_mutex(),
+                                           m_stepped(false),
+                                           m_lastStart(0.0),
+                                           m_cycles(0),
+                                           m_overruns(0),
+                                           m_maxJitter(0.0),
+                                           m_sumJitter(0.0),
+                                           m_maxRunTime(0.0)
+{
+}
+
+RioControlExecutor::Sensor RioControlExecutor::StampOnRead
+(
+    function<double()>      read
+)
+{
+    if ( !read )
+    {
+        return Sensor();
+    }
+    return [read]
+    {
+        auto value = read();
+        return SensorSample{value, frc::Timer::GetFPGATimestamp().to<double>()};
+    };
+}
+
+bool RioControlExecutor::RunsOnRio
+(
+    const ControlData*      controlData
+)
+{
+    if ( controlData == nullptr || controlData->GetRunLoc() != ControlModes::CONTROL_RUN_LOCS::ROBORIO )
+    {
+        return false;
+    }
+
+    switch ( controlData->GetMode() )
+    {
+        case ControlModes::CONTROL_TYPE::POSITION_INCH:
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
+        case ControlModes::CONTROL_TYPE::VELOCITY_INCH:
+        case ControlModes::CONTROL_TYPE::VELOCITY_DEGREES:
+        case ControlModes::CONTROL_TYPE::VELOCITY_RPS:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+int RioControlExecutor::AddLoop
+(
+    const string&               name,
+    IDragonMotorController*     motor
+)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_loops.emplace_back();
+    auto& loop = m_loops.back();
+    loop.name = name;
+    loop.motor = motor;
+    loop.channel = -1;
+    loop.sample = SensorSample{0.0, 0.0};
+    loop.active = false;
+
+    if ( m_notifier.get() == nullptr && !m_stepped )
+    {
+        m_notifier = make_unique<frc::Notifier>([this] { Run(); });
+        m_notifier->StartPeriodic(units::second_t(PERIOD));
+    }
+    return static_cast<int>(m_loops.size()) - 1;
+}
+
+void RioControlExecutor::SetControlData
+(
+    int                         loop,
+    ControlData*                controlData,
+    Sensor                      sensor
+)
+{
+    if ( loop < 0 || loop >= static_cast<int>(m_loops.size()) || controlData == nullptr || !sensor )
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("RioControlExecutor"), string("SetControlData"), string("invalid loop, control data or sensor"));
+        return;
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    auto& info = m_loops[loop];
+    if ( info.channel < 0 )
+    {
+        info.channel = m_engine.AddChannel(controlData);
+    }
+    else
+    {
+        m_engine.SetGains(info.channel, controlData);
+        m_engine.SetEnabled(info.channel, true);
+    }
+    auto peak = controlData->GetPeakValue() > 0.0 ? min(controlData->GetPeakValue(), 1.0) : 1.0;
+    m_engine.SetOutputLimits(info.channel, -peak, peak);
+    info.sensor = sensor;
+    info.active = true;
+}
+
+void RioControlExecutor::SetTarget
+(
+    int                         loop,
+    double                      target
+)
+{
+    if ( loop >= 0 && loop < static_cast<int>(m_loops.size()) )
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if ( m_loops[loop].channel >= 0 )
+        {
+            m_engine.SetTarget(m_loops[loop].channel, target);
+        }
+    }
+}
+
+void RioControlExecutor::Stop
+(
+    int                         loop
+)
+{
+    if ( loop >= 0 && loop < static_cast<int>(m_loops.size()) )
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_loops[loop].active = false;
+        if ( m_loops[loop].channel >= 0 )
+        {
+            m_engine.SetEnabled(m_loops[loop].channel, false);
+        }
+    }
+}
+
+void RioControlExecutor::SetStepped()
+{
+    unique_ptr<frc::Notifier> notifier;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stepped = true;
+        notifier.swap(m_notifier);
+    }
+    // destroying the notifier waits for a callback in progress, which needs the lock
+    notifier.reset();
+}
+
+void RioControlExecutor::Step()
+{
+    Run();
+}
+
+void RioControlExecutor::Run()
+{
+    auto start = frc::Timer::GetFPGATimestamp().to<double>();
+
+    lock_guard<mutex> lock(m_mutex);
+
+    // nothing is driven while disabled; the controllers start over on enable instead of kicking with the
+    // integral they wound up against a motor that couldn't move
+    if ( frc::DriverStation::IsDisabled() )
+    {
+        for ( auto& loop : m_loops )
+        {
+            if ( loop.channel >= 0 )
+            {
+                m_engine.Reset(loop.channel);
+            }
+        }
+        m_lastStart = start;
+        return;
+    }
+
+    auto late = false;
+    auto dt = PERIOD;
+    if ( m_lastStart > 0.0 )
+    {
+        auto period = start - m_lastStart;
+        dt = period;
+        auto jitter = abs(period - PERIOD);
+        m_maxJitter = max(m_maxJitter.load(), jitter);
+        m_sumJitter += jitter;
+        late = period > LATE;
+    }
+    m_lastStart = start;
+
+    // replay closes the loops on the recorded samples; the loop handle tags them
+    auto recorder = InputRecorder::GetInstance();
+    recorder->BeginExecutorCycle(start);
+    for ( auto inx=0U; inx<m_loops.size(); ++inx )
+    {
+        auto& loop = m_loops[inx];
+        if ( !loop.active )
+        {
+            continue;
+        }
+
+        if ( !recorder->ReplayExecutor(static_cast<int>(inx), loop.sample.value, loop.sample.timestamp) )
+        {
+            loop.sample = loop.sensor();
+        }
+        m_engine.SetMeasurement(loop.channel, loop.sample.value, loop.sample.timestamp);
+    }
+
+    // every active channel has a sample time, so dt is only used by channels without one
+    m_engine.Update(dt);
+
+    for ( auto inx=0U; inx<m_loops.size(); ++inx )
+    {
+        auto& loop = m_loops[inx];
+        if ( loop.active )
+        {
+            auto output = m_engine.GetOutput(loop.channel);
+            loop.motor->Set(output);
+            recorder->RecordExecutor(static_cast<int>(inx), loop.sample.value, loop.sample.timestamp, output);
+        }
+    }
+    recorder->EndExecutorCycle();
+
+    auto runTime = frc::Timer::GetFPGATimestamp().to<double>() - start;
+    m_maxRunTime = max(m_maxRunTime.load(), runTime);
+    if ( late || runTime > PERIOD )
+    {
+        m_overruns++;
+    }
+
+    auto cycles = ++m_cycles;
+    if ( cycles % PUBLISH_CYCLES == 0 )
+    {
+        PublishStats();
+    }
+}
+
+/// @brief  Log the jitter and overruns since the last publish and start a new window
+void RioControlExecutor::PublishStats()
+{
+    auto ntName = string("RioControlExecutor");
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("overruns"), to_string(m_overruns.load()));
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("max jitter (ms)"), m_maxJitter.load() * 1000.0);
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("mean jitter (ms)"), m_sumJitter * 1000.0 / PUBLISH_CYCLES);
+    Logger::GetLogger()->LogData(LOGGER_LEVEL::PRINT, ntName, string("max run time (ms)"), m_maxRunTime.load() * 1000.0);
+
+    m_overruns = 0;
+    m_maxJitter = 0.0;
+    m_sumJitter = 0.0;
+    m_maxRunTime = 0.0;
+}
@@ -0,0 +1,151 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/Notifier.h>
+
+// Team 302 includes
+#include <mechanisms/controllers/PIDEngine.h>
+
+// Third Party Includes
+
+class ControlData;
+class IDragonMotorController;
+
+/// @brief  Runs the control data marked ROBORIO in the xml on a notifier at a fixed period, independent of the
+///         20 ms robot loop.  Each cycle reads every loop's sensor, updates all of the controllers in one 
+///         PIDEngine pass and writes percent output straight to the motors.  Each controller integrates and 
+///         differentiates over the time between its own sensor samples (not the notifier period, which 
+///         jitters), so a sensor that knows when it was sampled should report it.  The sensor is supplied by the mechanism, so
+///         loops can be closed on sensors the motor controller can't see (e.g. analog potentiometers or 
+///         through-bore encoders on the roboRIO).  Nothing runs while the robot is disabled and the controllers 
+///         are reset, so they don't wind up before enable.
+///
+///         Every cycle is recorded by the InputRecorder (sensor sample and output per loop handle).  When 
+///         replaying, the executor is stepped by the replay tool instead of the notifier and closes its loops 
+///         on the recorded samples.
+///
+///         The motor belongs to the executor while its loop is active; its owner must not write it or change 
+///         its control constants until Stop returns.
+class RioControlExecutor
+{
+    public:
+        /// @brief  A sensor value and the FPGA time (seconds) it was sampled at
+        struct SensorSample
+        {
+            double      value;
+            double      timestamp;
+        };
+        using Sensor = std::function<SensorSample()>;
+
+        static RioControlExecutor* GetInstance();
+
+        /// @brief  Wrap a sensor that doesn't know when it was sampled; it is stamped when it is read, which is 
+        ///         right for sensors wired to the roboRIO and the best we can do for CAN status frames
+        static Sensor StampOnRead
+        (
+            std::function<double()>     read
+        );
+
+        /// @brief  true if the control data should run on the executor (ROBORIO run location and a closed loop mode)
+        static bool RunsOnRio
+        (
+            const ControlData*      controlData
+        );
+
+        /// @brief  Register a motor to be driven by the executor.  The loop is idle until SetControlData is called.
+        /// @return int - handle for the other methods
+        int AddLoop
+        (
+            const std::string&          name,
+            IDragonMotorController*     motor
+        );
+
+        /// @brief  Start (or restart) running the loop with new constants; resets the integrator
+        /// @param [in] Sensor  sensor - returns the current value in the units of the control mode
+        void SetControlData
+        (
+            int                         loop,
+            ControlData*                controlData,
+            Sensor                      sensor
+        );
+
+        void SetTarget
+        (
+            int                         loop,
+            double                      target
+        );
+
+        /// @brief  Stop driving the motor; the caller owns the motor output again.  This waits for a cycle in 
+        ///         progress, so the motor can be written (or reconfigured) as soon as it returns.
+        void Stop
+        (
+            int                         loop
+        );
+
+        /// @brief  Stop the notifier; cycles only run when Step is called (replay runs them against its own clock)
+        void SetStepped();
+
+        /// @brief  Run one cycle now (only meant for SetStepped)
+        void Step();
+
+        // read from other threads while the notifier updates them
+        int GetCycleCount() const { return m_cycles.load(); }
+        int GetOverrunCount() const { return m_overruns.load(); }
+        double GetMaxJitter() const { return m_maxJitter.load(); }            // seconds
+        double GetMaxRunTime() const { return m_maxRunTime.load(); }          // seconds
+
+    private:
+        RioControlExecutor();
+        ~RioControlExecutor() = default;
+
+        void Run();
+        void PublishStats();
+
+        struct Loop
+        {
+            std::string                 name;
+            IDragonMotorController*     motor;
+            int                         channel;
+            Sensor                      sensor;
+            SensorSample                sample;         // this cycle's, for the recorder
+            bool                        active;
+        };
+
+        static RioControlExecutor*      m_instance;
+
+        std::vector<Loop>               m_loops;
+        PIDEngine                       m_engine;
+        std::unique_ptr<frc::Notifier>  m_notifier;
+        std::mutex                      m_mutex;
+        bool                            m_stepped;
+        double                          m_lastStart;
+        std::atomic<int>                m_cycles;
+        std::atomic<int>                m_overruns;
+        std::atomic<double>             m_maxJitter;
+        double                          m_sumJitter;
+        std::atomic<double>             m_maxRunTime;
+};
@@ -0,0 +1,152 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <functional>
+#include <memory>
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/interfaces/IDragonMotorController.h>
+#include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/ControlModes.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <mechanisms/controllers/RioMotorLoop.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+RioMotorLoop::RioMotorLoop
+(
+    const string&                               name,
+    shared_ptr<IDragonMotorController>          motor
+) : m_name( name ),
+    m_motor( motor ),
+    m_percentOutput( make_unique<ControlData>() ),
+    m_sensor(),
+    m_target( 0.0 ),
+    m_loop( -1 ),
+    m_onRio( false )
+{
+}
+
+RioMotorLoop::~RioMotorLoop()
+{
+    // the executor keeps a raw pointer to the motor
+    if ( m_onRio )
+    {
+        RioControlExecutor::GetInstance()->Stop( m_loop );
+    }
+}
+
+void RioMotorLoop::SetControlConstants
+(
+    int                                         slot,
+    ControlData*                                pid
+)
+{
+    if ( m_motor.get() == nullptr )
+    {
+        return;
+    }
+
+    auto executor = RioControlExecutor::GetInstance();
+    auto sensor = RioControlExecutor::RunsOnRio( pid ) ? GetSensor( pid ) : RioControlExecutor::Sensor();
+    if ( sensor )
+    {
+        if ( m_loop < 0 )
+        {
+            m_loop = executor->AddLoop( m_name, m_motor.get() );
+        }
+        // the executor closes the loop and writes percent output; once it is running the motor is only 
+        // written from the executor thread, so it is switched to percent output before the loop starts
+        if ( !m_onRio )
+        {
+            m_motor.get()->SetControlConstants( slot, m_percentOutput.get() );
+        }
+        executor->SetControlData( m_loop, pid, sensor );
+        executor->SetTarget( m_loop, m_target );
+        m_onRio = true;
+    }
+    else
+    {
+        if ( m_onRio )
+        {
+            executor->Stop( m_loop );
+            m_onRio = false;
+        }
+        m_motor.get()->SetControlConstants( slot, pid );
+    }
+}
+
+void RioMotorLoop::SetTarget
+(
+    double                                      target
+)
+{
+    m_target = target;
+    if ( m_onRio )
+    {
+        RioControlExecutor::GetInstance()->SetTarget( m_loop, m_target );
+    }
+    else if ( m_motor.get() != nullptr )
+    {
+        m_motor.get()->Set( m_target );
+    }
+}
+
+void RioMotorLoop::SetSensor
+(
+    RioControlExecutor::Sensor                  sensor
+)
+{
+    m_sensor = sensor;
+}
+
+RioControlExecutor::Sensor RioMotorLoop::GetSensor
+(
+    const ControlData*                          pid
+) const
+{
+    if ( m_sensor )
+    {
+        return m_sensor;
+    }
+
+    // the motor's status frames don't carry a sample time, so these are stamped when they are read
+    auto motor = m_motor.get();
+    switch ( pid->GetMode() )
+    {
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES:
+        case ControlModes::CONTROL_TYPE::POSITION_DEGREES_ABSOLUTE:
+            return RioControlExecutor::StampOnRead( [motor] { return motor->GetRotations() * 360.0; } );
+
+        case ControlModes::CONTROL_TYPE::VELOCITY_DEGREES:
+            return RioControlExecutor::StampOnRead( [motor] { return motor->GetRPS() * 360.0; } );
+
+        case ControlModes::CONTROL_TYPE::VELOCITY_RPS:
+            return RioControlExecutor::StampOnRead( [motor] { return motor->GetRPS(); } );
+
+        default:
+            Logger::GetLogger()->LogData( LOGGER_LEVEL::ERROR_ONCE, m_name, string( "RioMotorLoop::SetControlConstants" ), 
+                                          string( "no RIO sensor for this control mode (SetRioSensor); running it on the motor controller" ) );
+            return RioControlExecutor::Sensor();
+    }
+}
@@ -0,0 +1,90 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <memory>
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+#include <mechanisms/controllers/RioControlExecutor.h>
+
+// Third Party Includes
+
+class ControlData;
+class IDragonMotorController;
+
+/// @brief  One mechanism motor and where its control data runs.  Control data marked ROBORIO is closed on the 
+///         RioControlExecutor (the motor controller gets percent output); everything else goes to the motor 
+///         controller.  The target is sent to whichever one is running the loop.  Mechanisms use one of these
+///         per independent motor so no ROBORIO control data reaches a motor controller.
+class RioMotorLoop
+{
+    public:
+        /// @param [in] std::string                             name - loop name in the executor's reports
+        /// @param [in] std::shared_ptr<IDragonMotorController> motor - the motor (may be nullptr)
+        RioMotorLoop
+        (
+            const std::string&                          name,
+            std::shared_ptr<IDragonMotorController>     motor
+        );
+        RioMotorLoop() = delete;
+        RioMotorLoop(const RioMotorLoop&) = delete;
+        RioMotorLoop& operator=(const RioMotorLoop&) = delete;
+        ~RioMotorLoop();
+
+        /// @brief  Run the control data on the executor or the motor controller
+        void SetControlConstants
+        (
+            int                                         slot,
+            ControlData*                                pid
+        );
+
+        /// @brief  Send the target to the executor or the motor controller
+        void SetTarget
+        (
+            double                                      target
+        );
+
+        /// @brief  Set the sensor the roboRIO loop closes on (e.g. a potentiometer or through-bore encoder).
+        ///         Without one the motor's sensor is converted to the units of the degree and revolution modes; 
+        ///         the inch modes need this sensor (the motor doesn't know the diameter) and run on the motor 
+        ///         controller without it.
+        void SetSensor
+        (
+            RioControlExecutor::Sensor                  sensor
+        );
+
+        bool IsOnRio() const { return m_onRio; }
+
+    private:
+        /// @brief  The sensor the RIO loop closes on, in the units of the control mode (empty if there isn't one)
+        RioControlExecutor::Sensor GetSensor
+        (
+            const ControlData*                          pid
+        ) const;
+
+        std::string                                 m_name;
+        std::shared_ptr<IDragonMotorController>     m_motor;
+        std::unique_ptr<ControlData>                m_percentOutput;
+        RioControlExecutor::Sensor                  m_sensor;
+        double                                      m_target;
+        int                                         m_loop;
+        bool                                        m_onRio;
+};
@@ -47,6 +47,7 @@
 #include <mechanisms/controllers/ControlDataXmlParser.h>
 #include <mechanisms/controllers/MechanismTargetXmlParser.h>
 #include <mechanisms/controllers/StateDataXmlParser.h>
+#include <mechanisms/controllers/StateTransitionXmlParser.h>
 
 // Third Party Includes
 #include <pugixml/pugixml.hpp>
@@ -62,6 +63,20 @@ vector<MechanismTargetData*> StateDataXmlParser::ParseXML
 (
     MechanismTypes::MECHANISM_TYPE mechanism
 )
+{
+    vector<StateTransitionData> transitions;
+    return ParseXML(mechanism, transitions);
+}
+
+/// @brief      Parse a mechanismState.xml file including its transitions
+/// @param [in] MechanismTypes::MECHANISM_TYPE  - mechanism that the states are for
+/// @param [out] vector<StateTransitionData>& - the transition elements
+/// @return     state data
+vector<MechanismTargetData*> StateDataXmlParser::ParseXML
+(
+    MechanismTypes::MECHANISM_TYPE          mechanism,
+    vector<StateTransitionData>&            transitions
+)
 {
     bool hasError = false;
     vector<MechanismTargetData*> targetDataVector;
@@ -87,69 +102,94 @@ vector<MechanismTargetData*> StateDataXmlParser::ParseXML
 
         if (!hasError)
         {
-            // load the xml file into memory (parse it)
             filename += mechFile;
-            xml_document doc;
-            xml_parse_result result = doc.load_file(filename.c_str());
+            targetDataVector = ParseFile(filename, transitions);
+        }
+    }
+    return targetDataVector;
+}
 
-            // if it is good
-            if (result)
-            {
-                unique_ptr<ControlDataXmlParser> controlDataXML = make_unique<ControlDataXmlParser>();
-                unique_ptr<MechanismTargetXmlParser> mechanismTargetXML = make_unique<MechanismTargetXmlParser>();
+/// @brief      Parse one state definition file (one of deploy/states/*.xml)
+/// @param [in] std::string - full path of the file
+/// @param [out] vector<StateTransitionData>& - the transition elements
+/// @return     state data
+vector<MechanismTargetData*> StateDataXmlParser::ParseFile
+(
+    const string&                           filename,
+    vector<StateTransitionData>&            transitions
+)
+{
+    vector<MechanismTargetData*> targetDataVector;
 
-                vector<ControlData*> controlDataVector;
+    // load the xml file into memory (parse it)
+    xml_document doc;
+    xml_parse_result result = doc.load_file(filename.c_str());
 
-                // get the root node <robot>
-                xml_node parent = doc.root();
-                for (xml_node node = parent.first_child(); node; node = node.next_sibling())
-                {   
-                    // loop through the direct children of <robot> and call the appropriate parser
-                    for (xml_node child = node.first_child(); child; child = child.next_sibling())
+    // if it is good
+    if (result)
+    {
+        unique_ptr<ControlDataXmlParser> controlDataXML = make_unique<ControlDataXmlParser>();
+        unique_ptr<MechanismTargetXmlParser> mechanismTargetXML = make_unique<MechanismTargetXmlParser>();
+        unique_ptr<StateTransitionXmlParser> transitionXML = make_unique<StateTransitionXmlParser>();
+
+        vector<ControlData*> controlDataVector;
+
+        // get the root node <robot>
+        xml_node parent = doc.root();
+        for (xml_node node = parent.first_child(); node; node = node.next_sibling())
+        {   
+            // loop through the direct children of <robot> and call the appropriate parser
+            for (xml_node child = node.first_child(); child; child = child.next_sibling())
+            {
+                if (strcmp(child.name(), "controlData") == 0)
+                {
+                    controlDataVector.push_back( controlDataXML.get()->ParseXML( child ) );
+                }
+                else if (strcmp(child.name(), "mechanismTarget") == 0)
+                {
+                    targetDataVector.push_back( mechanismTargetXML.get()->ParseXML( child ) );
+                }
+                else if (strcmp(child.name(), "transition") == 0)
+                {
+                    StateTransitionData transition;
+                    if ( transitionXML.get()->ParseXML( child, transition ) )
                     {
-                        if (strcmp(child.name(), "controlData") == 0)
-                        {
-                            controlDataVector.push_back( controlDataXML.get()->ParseXML( child ) );
-                        }
-                        else if (strcmp(child.name(), "mechanismTarget") == 0)
-                        {
-                            targetDataVector.push_back( mechanismTargetXML.get()->ParseXML( child ) );
-                        }
-                        else
-                        {
-                            string msg = "unknown child ";
-                            msg += child.name();
-                            Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML"), msg );
-                        }
+                        transitions.emplace_back( transition );
                     }
                 }
-                
-                for ( auto td : targetDataVector )
+                else
                 {
-                    td->Update( controlDataVector );
+                    string msg = "unknown child ";
+                    msg += child.name();
+                    Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML"), msg );
                 }
             }
-            else
-            {
-                string msg = "XML [";
-                msg += filename;
-                msg += "] parsed with errors, attr value: [";
-                msg += doc.child( "prototype" ).attribute( "attr" ).value();
-                msg += "]";
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (1) "), msg );
-
-                msg = "Error description: ";
-                msg += result.description();
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (2) "), msg );
-
-                msg = "Error offset: ";
-                msg += result.offset;
-                msg += " error at ...";
-                msg += filename;
-                msg += result.offset;
-                Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (3) "), msg );
-            }
         }
+        
+        for ( auto td : targetDataVector )
+        {
+            td->Update( controlDataVector );
+        }
+    }
+    else
+    {
+        string msg = "XML [";
+        msg += filename;
+        msg += "] parsed with errors, attr value: [";
+        msg += doc.child( "prototype" ).attribute( "attr" ).value();
+        msg += "]";
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (1) "), msg );
+
+        msg = "Error description: ";
+        msg += result.description();
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (2) "), msg );
+
+        msg = "Error offset: ";
+        msg += result.offset;
+        msg += " error at ...";
+        msg += filename;
+        msg += result.offset;
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateDataXmlParser"), string("ParseXML (3) "), msg );
     }
     return targetDataVector;
 }
@@ -15,10 +15,12 @@
 //====================================================================================================================================================
 
 #pragma once
+#include <string>
 #include <vector>
 
 #include <mechanisms/MechanismTypes.h>
 #include <mechanisms/controllers/MechanismTargetData.h>
+#include <mechanisms/controllers/StateTransitionData.h>
 
 //========================================================================================================
 /// StateDataXmlParser.h
@@ -47,4 +49,24 @@ class StateDataXmlParser
         (
             MechanismTypes::MECHANISM_TYPE mechanism
         );
+
+        /// @brief      Parse a mechanismState.xml file including its transitions
+        /// @param [in] MechanismTypes::MECHANISM_TYPE  - mechanism that the states are for
+        /// @param [out] std::vector<StateTransitionData>& - the transition elements
+        /// @return     state data
+        std::vector<MechanismTargetData*> ParseXML
+        (
+            MechanismTypes::MECHANISM_TYPE          mechanism,
+            std::vector<StateTransitionData>&       transitions
+        );
+
+        /// @brief      Parse one state definition file (one of deploy/states/*.xml)
+        /// @param [in] std::string - full path of the file
+        /// @param [out] std::vector<StateTransitionData>& - the transition elements
+        /// @return     state data
+        std::vector<MechanismTargetData*> ParseFile
+        (
+            const std::string&                      filename,
+            std::vector<StateTransitionData>&       transitions
+        );
 };
@@ -0,0 +1,46 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <string>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/usages/DigitalInputUsage.h>
+
+// Third Party Includes
+
+/// @brief  A state transition declared in a mechanism's state xml file:  when the mechanism is in fromState and
+///         the guard is true, it moves to toState.  StateMgr compiles these into its transition table.
+struct StateTransitionData
+{
+    enum GUARD
+    {
+        AT_TARGET,      // the current state reports AtTarget
+        TIMEOUT,        // the current state has run for timeout seconds
+        SENSOR_ON,      // the sensor reads true
+        SENSOR_OFF      // the sensor reads false
+    };
+
+    std::string                                 fromState;      // state identifier or ANY
+    std::string                                 toState;
+    GUARD                                       guard;
+    DigitalInputUsage::DIGITAL_SENSOR_USAGE     sensor;
+    double                                      timeout;
+};
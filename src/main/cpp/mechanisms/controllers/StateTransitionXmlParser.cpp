@@ -0,0 +1,116 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <string>
+#include <cstring>
+
+// FRC includes
+
+// Team 302 includes
+#include <hw/usages/DigitalInputUsage.h>
+#include <mechanisms/controllers/StateTransitionData.h>
+#include <mechanisms/controllers/StateTransitionXmlParser.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace std;
+using namespace pugi;
+
+
+/// @brief      Parse a transition XML element 
+/// @param [in] pugi::xml_node          transition node
+/// @param [out] StateTransitionData&   transition - the parsed transition
+/// @return     bool                    true if the transition is complete and valid
+bool StateTransitionXmlParser::ParseXML
+(
+    xml_node                transitionNode,
+    StateTransitionData&    transition
+)
+{
+    bool hasError = false;
+
+    transition.fromState.clear();
+    transition.toState.clear();
+    transition.guard = StateTransitionData::GUARD::AT_TARGET;
+    transition.sensor = DigitalInputUsage::DIGITAL_SENSOR_USAGE::UNKNOWN_DIGITAL_TYPE;
+    transition.timeout = 0.0;
+
+    // parse/validate xml
+    for (xml_attribute attr = transitionNode.first_attribute(); attr; attr = attr.next_attribute())
+    {
+        if ( strcmp( attr.name(), "from" ) == 0 )
+        {
+            transition.fromState = string( attr.value() );
+        }
+        else if ( strcmp( attr.name(), "to" ) == 0 )
+        {
+            transition.toState = string( attr.value() );
+        }
+        else if ( strcmp( attr.name(), "when" ) == 0 )
+        {
+            auto val = attr.value();
+            if ( strcmp( val, "AT_TARGET" ) == 0 )
+            {
+                transition.guard = StateTransitionData::GUARD::AT_TARGET;
+            }
+            else if ( strcmp( val, "TIMEOUT" ) == 0 )
+            {
+                transition.guard = StateTransitionData::GUARD::TIMEOUT;
+            }
+            else if ( strcmp( val, "SENSOR_ON" ) == 0 )
+            {
+                transition.guard = StateTransitionData::GUARD::SENSOR_ON;
+            }
+            else if ( strcmp( val, "SENSOR_OFF" ) == 0 )
+            {
+                transition.guard = StateTransitionData::GUARD::SENSOR_OFF;
+            }
+            else
+            {
+                Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateTransitionXmlParser"), string("ParseXML"), string("when enum"));
+                hasError = true;
+            }
+        }
+        else if ( strcmp( attr.name(), "sensor" ) == 0 )
+        {
+            transition.sensor = DigitalInputUsage::GetInstance()->GetUsage( string( attr.value() ) );
+        }
+        else if ( strcmp( attr.name(), "timeout" ) == 0 )
+        {
+            transition.timeout = attr.as_double();
+        }
+        else
+        {
+            string msg = "unknown attribute ";
+            msg += attr.name();
+            Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateTransitionXmlParser"), string("ParseXML"), msg );
+            hasError = true;
+        }
+    }
+
+    auto needsSensor = transition.guard == StateTransitionData::GUARD::SENSOR_ON || transition.guard == StateTransitionData::GUARD::SENSOR_OFF;
+    if ( transition.fromState.empty() || transition.toState.empty() || 
+         ( needsSensor && transition.sensor == DigitalInputUsage::DIGITAL_SENSOR_USAGE::UNKNOWN_DIGITAL_TYPE ) )
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("StateTransitionXmlParser"), string("ParseXML"), string("incomplete data"));
+        hasError = true;
+    }
+
+    return !hasError;
+}
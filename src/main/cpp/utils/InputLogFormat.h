@@ -0,0 +1,412 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Team 302 includes
+#include <utils/TelemetryFormat.h>
+
+/// @brief Layout of the input log written by InputRecorder and read by the desktop replay tool.  Like
+/// @brief TelemetryFormat.h it has no WPILib dependencies.  Doubles are written as their 8 raw bytes (the 
+/// @brief roboRIO and the desktop are both little endian).
+///
+///   file      := header frame*
+///   header    := MAGIC[8] version:u16
+///   frame     := length:varint payload[length]
+///   payload   := timestamp:f64 cycleTime:f64 flags:u8 alliance:u8 matchTime:f64
+///                axisMask:varint axis:f64 (one per set bit) buttonMask:varint buttons:varint
+///                autonLen:varint auton
+///                module*4 := valid:u8 driveRPS:f64 driveRotations:f64 turnTicks:f64 absoluteAngle:f64 angle:f64
+///                gyroValid:u8 yaw:f64 pdpValid:u8 batteryVoltage:f64 totalCurrent:f64
+///                limelight := valid:u8 hasTarget:u8 horizontal:f64 vertical:f64 area:f64 distance:f64 
+///                             latency:f64 timestamp:f64 frameId:varint
+///                motorCount:varint (id:varint rotations:f64 rps:f64)*
+///                outputCount:varint (id:varint value:f64)*
+///                executorCount:varint (cycleTime:f64 loop:varint measurement:f64 sampleTime:f64 output:f64)*
+///
+/// A frame is one robot loop.  Fields a loop didn't read (axes, buttons and motors) are left out, so
+/// replay can tell "not read" from "read as 0".  The executor samples are the RioControlExecutor cycles
+/// that ran since the previous frame, one per active loop per cycle.
+namespace InputLogFormat
+{
+    constexpr char      MAGIC[8] = { 'T', '3', '0', '2', 'I', 'N', 'P', '\0' };
+    constexpr uint16_t  VERSION = 2;
+    constexpr int       MAX_FUNCTIONS = 64;     // axes and buttons are indexed by TeleopControl::FUNCTION_IDENTIFIER
+
+    /// @enum FLAGS
+    enum FLAGS : uint8_t
+    {
+        ENABLED = 0x01,
+        AUTONOMOUS = 0x02,
+        TEST = 0x04,
+        DS_ATTACHED = 0x08
+    };
+
+    struct ModuleInput
+    {
+        bool        valid = false;
+        double      driveRPS = 0.0;
+        double      driveRotations = 0.0;
+        double      turnTicks = 0.0;
+        double      absoluteAngle = 0.0;        // degrees
+        double      angle = 0.0;                // degrees
+    };
+
+    struct LimelightInput
+    {
+        bool        valid = false;
+        bool        hasTarget = false;
+        double      horizontalOffset = 0.0;     // degrees
+        double      verticalOffset = 0.0;       // degrees
+        double      area = 0.0;
+        double      targetDistance = 0.0;       // inches
+        double      latency = 0.0;              // seconds
+        double      timestamp = 0.0;            // FPGA seconds
+        uint64_t    frameId = 0;
+    };
+
+    struct MotorInput
+    {
+        int         id = 0;
+        double      rotations = 0.0;
+        double      rps = 0.0;
+    };
+
+    /// @brief  One RioControlExecutor loop in one cycle: the sensor sample it closed on and the output it wrote
+    struct ExecutorSample
+    {
+        double      cycleTime = 0.0;            // FPGA seconds the cycle started
+        int         loop = 0;                   // RioControlExecutor loop handle
+        double      measurement = 0.0;
+        double      sampleTime = 0.0;           // FPGA seconds the sensor was sampled
+        double      output = 0.0;               // percent output written to the motor
+    };
+
+    /// @brief  Everything one loop consumed and the motor commands it produced
+    struct InputFrame
+    {
+        double                                  timestamp = 0.0;        // FPGA seconds of the sensor snapshot
+        double                                  cycleTime = 0.0;        // seconds since the previous loop ended
+        uint8_t                                 flags = 0;
+        uint8_t                                 alliance = 0;           // HAL_AllianceStationID
+        double                                  matchTime = 0.0;
+        uint64_t                                axisMask = 0;
+        double                                  axes[MAX_FUNCTIONS] = {};
+        uint64_t                                buttonMask = 0;
+        uint64_t                                buttons = 0;
+        std::string                             autonSelection;
+        ModuleInput                             modules[4];
+        bool                                    gyroValid = false;
+        double                                  yaw = 0.0;              // degrees
+        bool                                    pdpValid = false;
+        double                                  batteryVoltage = 0.0;
+        double                                  totalCurrent = 0.0;
+        LimelightInput                          limelight;
+        std::vector<MotorInput>                 motors;
+        std::vector<std::pair<int, double>>     outputs;                // motor CAN id, value passed to Set
+        std::vector<ExecutorSample>             executor;               // in the order the cycles ran
+
+        /// @brief  Empty the per-loop fields without freeing their storage
+        void Clear()
+        {
+            axisMask = 0;
+            buttonMask = 0;
+            buttons = 0;
+            motors.clear();
+            outputs.clear();
+            executor.clear();
+        }
+    };
+
+    inline void WriteDouble
+    (
+        std::vector<uint8_t>&   buffer,
+        double                  value
+    )
+    {
+        uint8_t bytes[sizeof( value )];
+        std::memcpy( bytes, &value, sizeof( value ) );
+        buffer.insert( buffer.end(), bytes, bytes + sizeof( bytes ) );
+    }
+
+    /// @returns bool: false if the buffer ran out
+    inline bool ReadDouble
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end,
+        double&                 value
+    )
+    {
+        if ( end - pos < static_cast<long>( sizeof( value ) ) )
+        {
+            return false;
+        }
+        std::memcpy( &value, pos, sizeof( value ) );
+        pos += sizeof( value );
+        return true;
+    }
+
+    /// @returns bool: false if the buffer ran out
+    inline bool ReadByte
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end,
+        uint8_t&                value
+    )
+    {
+        if ( pos >= end )
+        {
+            return false;
+        }
+        value = *pos++;
+        return true;
+    }
+
+    inline void WriteHeader
+    (
+        std::vector<uint8_t>&   buffer
+    )
+    {
+        buffer.insert( buffer.end(), MAGIC, MAGIC + sizeof( MAGIC ) );
+        buffer.push_back( static_cast<uint8_t>( VERSION & 0xFF ) );
+        buffer.push_back( static_cast<uint8_t>( VERSION >> 8 ) );
+    }
+
+    /// @returns bool: false if the header is missing or from another version
+    inline bool ReadHeader
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end
+    )
+    {
+        if ( end - pos < static_cast<long>( sizeof( MAGIC ) + 2 ) || std::memcmp( pos, MAGIC, sizeof( MAGIC ) ) != 0 )
+        {
+            return false;
+        }
+        pos += sizeof( MAGIC );
+        uint16_t version = static_cast<uint16_t>( pos[0] | ( pos[1] << 8 ) );
+        pos += 2;
+        return version == VERSION;
+    }
+
+    /// @brief  Append a length prefixed frame
+    /// @param [in/out] std::vector<uint8_t>& payload: scratch space for the frame (kept to avoid allocating)
+    inline void WriteFrame
+    (
+        std::vector<uint8_t>&   buffer,
+        std::vector<uint8_t>&   payload,
+        const InputFrame&       frame
+    )
+    {
+        using TelemetryFormat::WriteVarint;
+
+        payload.clear();
+        WriteDouble( payload, frame.timestamp );
+        WriteDouble( payload, frame.cycleTime );
+        payload.push_back( frame.flags );
+        payload.push_back( frame.alliance );
+        WriteDouble( payload, frame.matchTime );
+
+        WriteVarint( payload, frame.axisMask );
+        for ( auto inx=0; inx<MAX_FUNCTIONS; ++inx )
+        {
+            if ( ( frame.axisMask >> inx ) & 1 )
+            {
+                WriteDouble( payload, frame.axes[inx] );
+            }
+        }
+        WriteVarint( payload, frame.buttonMask );
+        WriteVarint( payload, frame.buttons );
+
+        WriteVarint( payload, frame.autonSelection.size() );
+        payload.insert( payload.end(), frame.autonSelection.begin(), frame.autonSelection.end() );
+
+        for ( const auto& module : frame.modules )
+        {
+            payload.push_back( module.valid ? 1 : 0 );
+            WriteDouble( payload, module.driveRPS );
+            WriteDouble( payload, module.driveRotations );
+            WriteDouble( payload, module.turnTicks );
+            WriteDouble( payload, module.absoluteAngle );
+            WriteDouble( payload, module.angle );
+        }
+        payload.push_back( frame.gyroValid ? 1 : 0 );
+        WriteDouble( payload, frame.yaw );
+        payload.push_back( frame.pdpValid ? 1 : 0 );
+        WriteDouble( payload, frame.batteryVoltage );
+        WriteDouble( payload, frame.totalCurrent );
+
+        const auto& limelight = frame.limelight;
+        payload.push_back( limelight.valid ? 1 : 0 );
+        payload.push_back( limelight.hasTarget ? 1 : 0 );
+        WriteDouble( payload, limelight.horizontalOffset );
+        WriteDouble( payload, limelight.verticalOffset );
+        WriteDouble( payload, limelight.area );
+        WriteDouble( payload, limelight.targetDistance );
+        WriteDouble( payload, limelight.latency );
+        WriteDouble( payload, limelight.timestamp );
+        WriteVarint( payload, limelight.frameId );
+
+        WriteVarint( payload, frame.motors.size() );
+        for ( const auto& motor : frame.motors )
+        {
+            WriteVarint( payload, static_cast<uint64_t>( motor.id ) );
+            WriteDouble( payload, motor.rotations );
+            WriteDouble( payload, motor.rps );
+        }
+
+        WriteVarint( payload, frame.outputs.size() );
+        for ( const auto& output : frame.outputs )
+        {
+            WriteVarint( payload, static_cast<uint64_t>( output.first ) );
+            WriteDouble( payload, output.second );
+        }
+
+        WriteVarint( payload, frame.executor.size() );
+        for ( const auto& sample : frame.executor )
+        {
+            WriteDouble( payload, sample.cycleTime );
+            WriteVarint( payload, static_cast<uint64_t>( sample.loop ) );
+            WriteDouble( payload, sample.measurement );
+            WriteDouble( payload, sample.sampleTime );
+            WriteDouble( payload, sample.output );
+        }
+
+        WriteVarint( buffer, payload.size() );
+        buffer.insert( buffer.end(), payload.begin(), payload.end() );
+    }
+
+    /// @returns bool: false if the buffer ended before the frame did or the frame is malformed
+    inline bool ReadFrame
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end,
+        InputFrame&             frame
+    )
+    {
+        using TelemetryFormat::ReadVarint;
+
+        uint64_t length = 0;
+        if ( !ReadVarint( pos, end, length ) || static_cast<uint64_t>( end - pos ) < length )
+        {
+            return false;
+        }
+        const uint8_t* frameEnd = pos + length;
+
+        uint8_t byte = 0;
+        uint64_t value = 0;
+        auto ok = ReadDouble( pos, frameEnd, frame.timestamp ) && 
+                  ReadDouble( pos, frameEnd, frame.cycleTime ) &&
+                  ReadByte( pos, frameEnd, frame.flags ) &&
+                  ReadByte( pos, frameEnd, frame.alliance ) &&
+                  ReadDouble( pos, frameEnd, frame.matchTime ) &&
+                  ReadVarint( pos, frameEnd, frame.axisMask );
+        for ( auto inx=0; ok && inx<MAX_FUNCTIONS; ++inx )
+        {
+            frame.axes[inx] = 0.0;
+            if ( ( frame.axisMask >> inx ) & 1 )
+            {
+                ok = ReadDouble( pos, frameEnd, frame.axes[inx] );
+            }
+        }
+        ok = ok && ReadVarint( pos, frameEnd, frame.buttonMask ) && 
+                   ReadVarint( pos, frameEnd, frame.buttons ) &&
+                   ReadVarint( pos, frameEnd, value ) && 
+                   static_cast<uint64_t>( frameEnd - pos ) >= value;
+        if ( ok )
+        {
+            frame.autonSelection.assign( reinterpret_cast<const char*>( pos ), value );
+            pos += value;
+        }
+
+        for ( auto& module : frame.modules )
+        {
+            ok = ok && ReadByte( pos, frameEnd, byte );
+            module.valid = byte != 0;
+            ok = ok && ReadDouble( pos, frameEnd, module.driveRPS ) &&
+                       ReadDouble( pos, frameEnd, module.driveRotations ) &&
+                       ReadDouble( pos, frameEnd, module.turnTicks ) &&
+                       ReadDouble( pos, frameEnd, module.absoluteAngle ) &&
+                       ReadDouble( pos, frameEnd, module.angle );
+        }
+        ok = ok && ReadByte( pos, frameEnd, byte );
+        frame.gyroValid = byte != 0;
+        ok = ok && ReadDouble( pos, frameEnd, frame.yaw ) && ReadByte( pos, frameEnd, byte );
+        frame.pdpValid = byte != 0;
+        ok = ok && ReadDouble( pos, frameEnd, frame.batteryVoltage ) && ReadDouble( pos, frameEnd, frame.totalCurrent );
+
+        auto& limelight = frame.limelight;
+        ok = ok && ReadByte( pos, frameEnd, byte );
+        limelight.valid = byte != 0;
+        ok = ok && ReadByte( pos, frameEnd, byte );
+        limelight.hasTarget = byte != 0;
+        ok = ok && ReadDouble( pos, frameEnd, limelight.horizontalOffset ) &&
+                   ReadDouble( pos, frameEnd, limelight.verticalOffset ) &&
+                   ReadDouble( pos, frameEnd, limelight.area ) &&
+                   ReadDouble( pos, frameEnd, limelight.targetDistance ) &&
+                   ReadDouble( pos, frameEnd, limelight.latency ) &&
+                   ReadDouble( pos, frameEnd, limelight.timestamp ) &&
+                   ReadVarint( pos, frameEnd, limelight.frameId );
+
+        frame.motors.clear();
+        ok = ok && ReadVarint( pos, frameEnd, value );
+        for ( uint64_t inx=0; ok && inx<value; ++inx )
+        {
+            MotorInput motor;
+            uint64_t id = 0;
+            ok = ReadVarint( pos, frameEnd, id ) && 
+                 ReadDouble( pos, frameEnd, motor.rotations ) && 
+                 ReadDouble( pos, frameEnd, motor.rps );
+            motor.id = static_cast<int>( id );
+            frame.motors.emplace_back( motor );
+        }
+
+        frame.outputs.clear();
+        ok = ok && ReadVarint( pos, frameEnd, value );
+        for ( uint64_t inx=0; ok && inx<value; ++inx )
+        {
+            uint64_t id = 0;
+            double output = 0.0;
+            ok = ReadVarint( pos, frameEnd, id ) && ReadDouble( pos, frameEnd, output );
+            frame.outputs.emplace_back( static_cast<int>( id ), output );
+        }
+
+        frame.executor.clear();
+        ok = ok && ReadVarint( pos, frameEnd, value );
+        for ( uint64_t inx=0; ok && inx<value; ++inx )
+        {
+            ExecutorSample sample;
+            uint64_t loop = 0;
+            ok = ReadDouble( pos, frameEnd, sample.cycleTime ) &&
+                 ReadVarint( pos, frameEnd, loop ) &&
+                 ReadDouble( pos, frameEnd, sample.measurement ) &&
+                 ReadDouble( pos, frameEnd, sample.sampleTime ) &&
+                 ReadDouble( pos, frameEnd, sample.output );
+            sample.loop = static_cast<int>( loop );
+            frame.executor.emplace_back( sample );
+        }
+
+        pos = frameEnd;
+        return ok;
+    }
+}
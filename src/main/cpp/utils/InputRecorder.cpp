@@ -0,0 +1,541 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#endif
+
+// FRC includes
+#include <frc/DriverStation.h>
+#include <frc/Timer.h>
+
+// Team 302 includes
+#include <RobotState.h>
+#include <TeleopControl.h>
+#include <utils/InputLogFormat.h>
+#include <utils/InputRecorder.h>
+#include <utils/Logger.h>
+
+// Third Party Includes
+
+using namespace std;
+
+// set while the calling thread runs an executor cycle, so its motor commands aren't taken for loop commands
+static thread_local bool t_inExecutorCycle = false;
+
+static_assert(TeleopControl::FUNCTION_IDENTIFIER::MAX_FUNCTIONS <= InputLogFormat::MAX_FUNCTIONS, "input frames can't hold every teleop function");
+
+InputRecorder* InputRecorder::m_instance = nullptr;
+InputRecorder* InputRecorder::GetInstance()
+{
+    if ( InputRecorder::m_instance == nullptr )
+    {
+        InputRecorder::m_instance = new InputRecorder();
+    }
+    return InputRecorder::m_instance;
+}
+
+InputRecorder::InputRecorder() : m_mode(OFF),
+                                 m_loopThread(),
+                                 m_frame(),
+                                 m_replayFrame(nullptr),
+                                 m_replayedOutputs(),
+                                 m_replayExecutorBegin(0),
+                                 m_replayExecutorEnd(0),
+                                 m_replayedExecutor(),
+                                 m_executorCycleTime(0.0),
+                                 m_executorMutex(),
+                                 m_executorSamples(),
+                                 m_lastLoopEnd(0.0),
+                                 m_payload(),
+                                 m_mutex(),
+                                 m_ready(),
+                                 m_pending(),
+                                 m_writing(),
+                                 m_directory(),
+                                 m_file(nullptr),
+                                 m_fileSize(0),
+                                 m_dropped(0)
+{
+    m_frame.motors.reserve(32);
+    m_frame.outputs.reserve(32);
+    m_frame.executor.reserve(MAX_EXECUTOR_SAMPLES);
+    m_executorSamples.reserve(MAX_EXECUTOR_SAMPLES);
+}
+
+void InputRecorder::StartRecording()
+{
+    if ( m_mode != OFF || !Open() )
+    {
+        return;
+    }
+    m_loopThread = this_thread::get_id();
+    m_mode = RECORD;
+    thread(&InputRecorder::RunWriter, this).detach();
+}
+
+void InputRecorder::StartReplay()
+{
+    m_loopThread = this_thread::get_id();
+    m_mode = REPLAY;
+}
+
+void InputRecorder::SetReplayFrame
+(
+    const InputLogFormat::InputFrame*   frame
+)
+{
+    m_replayFrame = frame;
+    m_replayExecutorBegin = 0;
+    m_replayExecutorEnd = 0;
+    m_replayedExecutor.clear();
+}
+
+double InputRecorder::Axis
+(
+    int                                 function,
+    double                              value
+)
+{
+    if ( m_mode == RECORD )
+    {
+        m_frame.axisMask |= 1ULL << function;
+        m_frame.axes[function] = value;
+    }
+    else if ( m_mode == REPLAY && m_replayFrame != nullptr )
+    {
+        value = m_replayFrame->axes[function];
+    }
+    return value;
+}
+
+bool InputRecorder::Button
+(
+    int                                 function,
+    bool                                pressed
+)
+{
+    if ( m_mode == RECORD )
+    {
+        auto bit = 1ULL << function;
+        m_frame.buttonMask |= bit;
+        m_frame.buttons = pressed ? ( m_frame.buttons | bit ) : ( m_frame.buttons & ~bit );
+    }
+    else if ( m_mode == REPLAY && m_replayFrame != nullptr )
+    {
+        pressed = ( ( m_replayFrame->buttons >> function ) & 1 ) != 0;
+    }
+    return pressed;
+}
+
+string InputRecorder::AutonSelection
+(
+    const string&                       selection
+)
+{
+    if ( m_mode == RECORD )
+    {
+        m_frame.autonSelection = selection;
+    }
+    else if ( m_mode == REPLAY && m_replayFrame != nullptr )
+    {
+        return m_replayFrame->autonSelection;
+    }
+    return selection;
+}
+
+void InputRecorder::RecordState
+(
+    const RobotState&                   state
+)
+{
+    if ( m_mode != RECORD )
+    {
+        return;
+    }
+
+    m_frame.timestamp = state.timestamp.to<double>();
+    for ( auto inx=0; inx<4; ++inx )
+    {
+        const auto& sample = state.modules[inx];
+        auto& module = m_frame.modules[inx];
+        module.valid = sample.valid;
+        module.driveRPS = sample.driveRPS;
+        module.driveRotations = sample.driveRotations;
+        module.turnTicks = sample.turnTicks;
+        module.absoluteAngle = sample.absoluteAngle.to<double>();
+        module.angle = sample.angle.to<double>();
+    }
+    m_frame.gyroValid = state.gyroValid;
+    m_frame.yaw = state.yaw.to<double>();
+    m_frame.pdpValid = state.pdpValid;
+    m_frame.batteryVoltage = state.batteryVoltage.to<double>();
+    m_frame.totalCurrent = state.totalCurrent.to<double>();
+
+    const auto& target = state.limelight;
+    auto& limelight = m_frame.limelight;
+    limelight.valid = target.valid;
+    limelight.hasTarget = target.hasTarget;
+    limelight.horizontalOffset = target.horizontalOffset.to<double>();
+    limelight.verticalOffset = target.verticalOffset.to<double>();
+    limelight.area = target.area;
+    limelight.targetDistance = target.targetDistance.to<double>();
+    limelight.latency = target.latency.to<double>();
+    limelight.timestamp = target.timestamp.to<double>();
+    limelight.frameId = target.frameId;
+}
+
+void InputRecorder::ReplayState
+(
+    RobotState&                         state
+) const
+{
+    if ( m_mode != REPLAY || m_replayFrame == nullptr )
+    {
+        return;
+    }
+
+    const auto& frame = *m_replayFrame;
+    state.timestamp = units::time::second_t(frame.timestamp);
+    for ( auto inx=0; inx<4; ++inx )
+    {
+        const auto& module = frame.modules[inx];
+        auto& sample = state.modules[inx];
+        sample.valid = module.valid;
+        sample.driveRPS = module.driveRPS;
+        sample.driveRotations = module.driveRotations;
+        sample.turnTicks = module.turnTicks;
+        sample.absoluteAngle = units::angle::degree_t(module.absoluteAngle);
+        sample.angle = units::angle::degree_t(module.angle);
+    }
+    state.gyroValid = frame.gyroValid;
+    state.yaw = units::angle::degree_t(frame.yaw);
+    state.pdpValid = frame.pdpValid;
+    state.batteryVoltage = units::voltage::volt_t(frame.batteryVoltage);
+    state.totalCurrent = units::current::ampere_t(frame.totalCurrent);
+
+    const auto& limelight = frame.limelight;
+    auto& target = state.limelight;
+    target.valid = limelight.valid;
+    target.hasTarget = limelight.hasTarget;
+    target.horizontalOffset = units::angle::degree_t(limelight.horizontalOffset);
+    target.verticalOffset = units::angle::degree_t(limelight.verticalOffset);
+    target.area = limelight.area;
+    target.targetDistance = units::length::inch_t(limelight.targetDistance);
+    target.latency = units::time::second_t(limelight.latency);
+    target.timestamp = units::time::second_t(limelight.timestamp);
+    target.frameId = limelight.frameId;
+}
+
+void InputRecorder::RecordMotor
+(
+    int                                 id,
+    double                              rotations,
+    double                              rps
+)
+{
+    if ( m_mode == RECORD )
+    {
+        InputLogFormat::MotorInput motor;
+        motor.id = id;
+        motor.rotations = rotations;
+        motor.rps = rps;
+        m_frame.motors.emplace_back(motor);
+    }
+}
+
+bool InputRecorder::ReplayMotor
+(
+    int                                 id,
+    double&                             rotations,
+    double&                             rps
+) const
+{
+    if ( m_mode != REPLAY || m_replayFrame == nullptr )
+    {
+        return false;
+    }
+    for ( const auto& motor : m_replayFrame->motors )
+    {
+        if ( motor.id == id )
+        {
+            rotations = motor.rotations;
+            rps = motor.rps;
+            return true;
+        }
+    }
+    return false;
+}
+
+void InputRecorder::RecordOutput
+(
+    int                                 id,
+    double                              value
+)
+{
+    if ( m_mode != OFF && this_thread::get_id() == m_loopThread && !t_inExecutorCycle )
+    {
+        m_frame.outputs.emplace_back(id, value);
+    }
+}
+
+void InputRecorder::BeginExecutorCycle
+(
+    double                              cycleTime
+)
+{
+    t_inExecutorCycle = true;
+    m_executorCycleTime = cycleTime;
+}
+
+void InputRecorder::EndExecutorCycle()
+{
+    t_inExecutorCycle = false;
+}
+
+void InputRecorder::RecordExecutor
+(
+    int                                 loop,
+    double                              measurement,
+    double                              sampleTime,
+    double                              output
+)
+{
+    InputLogFormat::ExecutorSample sample{m_executorCycleTime, loop, measurement, sampleTime, output};
+    if ( m_mode == REPLAY )
+    {
+        // replay steps the executor on the loop thread
+        m_replayedExecutor.emplace_back(sample);
+    }
+    else if ( m_mode == RECORD )
+    {
+        lock_guard<mutex> lock(m_executorMutex);
+        if ( m_executorSamples.size() < MAX_EXECUTOR_SAMPLES )
+        {
+            m_executorSamples.emplace_back(sample);
+        }
+    }
+}
+
+bool InputRecorder::ReplayExecutor
+(
+    int                                 loop,
+    double&                             measurement,
+    double&                             sampleTime
+) const
+{
+    if ( m_mode != REPLAY || m_replayFrame == nullptr )
+    {
+        return false;
+    }
+    for ( auto inx=m_replayExecutorBegin; inx<m_replayExecutorEnd && inx<m_replayFrame->executor.size(); ++inx )
+    {
+        const auto& sample = m_replayFrame->executor[inx];
+        if ( sample.loop == loop )
+        {
+            measurement = sample.measurement;
+            sampleTime = sample.sampleTime;
+            return true;
+        }
+    }
+    return false;
+}
+
+void InputRecorder::SetReplayExecutorCycle
+(
+    size_t                              begin,
+    size_t                              end
+)
+{
+    m_replayExecutorBegin = begin;
+    m_replayExecutorEnd = end;
+}
+
+void InputRecorder::EndLoop()
+{
+    if ( m_mode == REPLAY )
+    {
+        m_replayedOutputs.swap(m_frame.outputs);
+        m_frame.Clear();
+        return;
+    }
+    if ( m_mode != RECORD )
+    {
+        return;
+    }
+
+    {
+        // the executor cycles since the previous loop belong to this frame
+        lock_guard<mutex> lock(m_executorMutex);
+        m_frame.executor.swap(m_executorSamples);
+        m_executorSamples.clear();
+    }
+
+    // sitting disabled in the pits would fill the disk; keep the matches and practice runs
+    if ( !frc::DriverStation::IsEnabled() && !frc::DriverStation::IsFMSAttached() )
+    {
+        m_lastLoopEnd = 0.0;
+        m_frame.Clear();
+        return;
+    }
+
+    auto now = frc::Timer::GetFPGATimestamp().to<double>();
+    m_frame.cycleTime = m_lastLoopEnd > 0.0 ? now - m_lastLoopEnd : 0.0;
+    m_lastLoopEnd = now;
+
+    uint8_t flags = 0;
+    flags |= frc::DriverStation::IsEnabled() ? InputLogFormat::FLAGS::ENABLED : 0;
+    flags |= frc::DriverStation::IsAutonomous() ? InputLogFormat::FLAGS::AUTONOMOUS : 0;
+    flags |= frc::DriverStation::IsTest() ? InputLogFormat::FLAGS::TEST : 0;
+    flags |= frc::DriverStation::IsDSAttached() ? InputLogFormat::FLAGS::DS_ATTACHED : 0;
+    m_frame.flags = flags;
+    m_frame.alliance = static_cast<uint8_t>(frc::DriverStation::GetAlliance() == frc::DriverStation::Alliance::kBlue ? 
+                                            2 + frc::DriverStation::GetLocation() : frc::DriverStation::GetLocation() - 1);
+    m_frame.matchTime = frc::DriverStation::GetMatchTime();
+
+    auto flush = false;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if ( m_pending.size() < MAX_PENDING )
+        {
+            InputLogFormat::WriteFrame(m_pending, m_payload, m_frame);
+        }
+        else
+        {
+            m_dropped++;
+        }
+        flush = m_pending.size() >= FLUSH_SIZE;
+    }
+    if ( flush )
+    {
+        m_ready.notify_one();
+    }
+    m_frame.Clear();
+}
+
+bool InputRecorder::Open()
+{
+    struct stat info;
+    m_directory = (stat("/u", &info) == 0 && S_ISDIR(info.st_mode)) ? string("/u/inputs") : string("/home/lvuser/inputs");
+    mkdir(m_directory.c_str(), 0755);
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_pending.reserve(MAX_PENDING + FLUSH_SIZE);
+        m_writing.reserve(MAX_PENDING + FLUSH_SIZE);
+    }
+    return OpenFile();
+}
+
+/// @brief  Make room for and start a new log file; its header is written right away
+bool InputRecorder::OpenFile()
+{
+    DeleteOldLogs();
+
+    char name[32];
+    auto now = time(nullptr);
+    strftime(name, sizeof(name), "%Y%m%d_%H%M%S", localtime(&now));
+    auto path = m_directory + string("/inputs_") + string(name) + string(".t302in");
+
+    m_file = fopen(path.c_str(), "wb");
+    if ( m_file == nullptr )
+    {
+        Logger::GetLogger()->LogData(LOGGER_LEVEL::ERROR_ONCE, string("InputRecorder"), string("Open"), string("can't create ") + path);
+        return false;
+    }
+
+    vector<uint8_t> header;
+    InputLogFormat::WriteHeader(header);
+    fwrite(header.data(), 1, header.size(), m_file);
+    m_fileSize = header.size();
+    return true;
+}
+
+/// @brief  Delete the oldest logs so there are at most MAX_FILES once a new one is created (the names 
+///         start with the date and time, so they sort oldest first)
+void InputRecorder::DeleteOldLogs()
+{
+#ifdef __linux__
+    DIR* dir = opendir(m_directory.c_str());
+    if ( dir == nullptr )
+    {
+        return;
+    }
+
+    vector<string> logs;
+    const string prefix("inputs_");
+    const string ext(".t302in");
+    while ( auto entry = readdir(dir) )
+    {
+        string name(entry->d_name);
+        if ( name.size() > prefix.size() + ext.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+             name.compare(name.size()-ext.size(), ext.size(), ext) == 0 )
+        {
+            logs.emplace_back(name);
+        }
+    }
+    closedir(dir);
+
+    sort(logs.begin(), logs.end());
+    for ( size_t inx=0; inx+MAX_FILES <= logs.size(); ++inx )
+    {
+        remove((m_directory + string("/") + logs[inx]).c_str());
+    }
+#endif
+}
+
+/// @brief  Write whatever is pending when there is enough of it or every half second
+void InputRecorder::RunWriter()
+{
+    while ( true )
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_ready.wait_for(lock, chrono::milliseconds(500), [this] { return m_pending.size() >= FLUSH_SIZE; });
+            m_writing.swap(m_pending);
+        }
+
+        if ( !m_writing.empty() )
+        {
+            fwrite(m_writing.data(), 1, m_writing.size(), m_file);
+            fflush(m_file);
+            m_fileSize += m_writing.size();
+            m_writing.clear();
+        }
+
+        if ( m_fileSize >= MAX_FILE_SIZE )
+        {
+            fclose(m_file);
+            if ( !OpenFile() )
+            {
+                m_mode = OFF;
+                return;
+            }
+        }
+    }
+}
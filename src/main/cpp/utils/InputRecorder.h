@@ -0,0 +1,217 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// FRC includes
+
+// Team 302 includes
+#include <utils/InputLogFormat.h>
+
+// Third Party Includes
+
+struct RobotState;
+
+/// @brief  Records what each robot loop consumed (driver inputs, driver station state, the sensor snapshot 
+///         and the auton selection) and the motor commands it produced, one InputLogFormat frame per loop.
+///         The same hooks serve replay: the desktop inputReplay tool hands the recorder each recorded frame 
+///         and the hooks return the recorded values instead of the hardware ones.
+///
+///         Motor commands are recorded from the robot loop thread only.  The RioControlExecutor records each 
+///         of its cycles separately (the sensor sample every loop closed on and the output it wrote, tagged 
+///         with the loop); they are added to the next frame.  When replaying the executor gets the recorded 
+///         samples back and its outputs are kept for the replay tool to compare.  Frames are written by a 
+///         background thread; if it falls behind frames are dropped and counted rather than blocking the loop.
+///
+///         Loops are only recorded while the robot is enabled or attached to the FMS.  A file is closed at 
+///         MAX_FILE_SIZE and a new one started; only the newest MAX_FILES logs are kept.
+class InputRecorder
+{
+    public:
+        enum MODE
+        {
+            OFF,
+            RECORD,
+            REPLAY
+        };
+
+        static InputRecorder* GetInstance();
+
+        /// @brief  Start writing frames to a new file (call from the robot loop thread)
+        void StartRecording();
+
+        /// @brief  Serve inputs from SetReplayFrame instead of recording (call from the robot loop thread)
+        void StartReplay();
+
+        /// @brief  Frame whose inputs the next loop (and the executor cycles until the next call) get
+        void SetReplayFrame
+        (
+            const InputLogFormat::InputFrame*   frame
+        );
+
+        MODE GetMode() const { return m_mode; }
+        bool IsReplaying() const { return m_mode == REPLAY; }
+
+        /// @brief  Record a driver axis, or replace it with the recorded value when replaying
+        /// @param [in] int     function - TeleopControl::FUNCTION_IDENTIFIER
+        /// @return double - the value the loop should use
+        double Axis
+        (
+            int                                 function,
+            double                              value
+        );
+
+        /// @brief  Record a driver button, or replace it with the recorded value when replaying
+        bool Button
+        (
+            int                                 function,
+            bool                                pressed
+        );
+
+        /// @brief  Record the auton selection, or replace it with the recorded one when replaying
+        std::string AutonSelection
+        (
+            const std::string&                  selection
+        );
+
+        void RecordState
+        (
+            const RobotState&                   state
+        );
+
+        /// @brief  Fill the snapshot from the replayed frame (the cycle count is left alone)
+        void ReplayState
+        (
+            RobotState&                         state
+        ) const;
+
+        void RecordMotor
+        (
+            int                                 id,
+            double                              rotations,
+            double                              rps
+        );
+
+        /// @return bool - false if the motor wasn't read in the recorded loop
+        bool ReplayMotor
+        (
+            int                                 id,
+            double&                             rotations,
+            double&                             rps
+        ) const;
+
+        /// @brief  Record a motor command (ignored off the robot loop thread)
+        void RecordOutput
+        (
+            int                                 id,
+            double                              value
+        );
+
+        /// @brief  Finish the loop: write the frame when recording, keep its commands when replaying
+        void EndLoop();
+
+        /// @brief  Start an executor cycle on the calling thread; motor commands are not recorded as loop 
+        ///         commands until EndExecutorCycle
+        /// @param [in] double  cycleTime - FPGA seconds the cycle started
+        void BeginExecutorCycle
+        (
+            double                              cycleTime
+        );
+        void EndExecutorCycle();
+
+        /// @brief  Record what an executor loop did this cycle (any thread)
+        void RecordExecutor
+        (
+            int                                 loop,
+            double                              measurement,
+            double                              sampleTime,
+            double                              output
+        );
+
+        /// @brief  The recorded sensor sample of an executor loop in the cycle being replayed
+        /// @return bool - false if the loop didn't run in that cycle (or nothing is being replayed)
+        bool ReplayExecutor
+        (
+            int                                 loop,
+            double&                             measurement,
+            double&                             sampleTime
+        ) const;
+
+        /// @brief  Select the samples [begin, end) of the replay frame's executor samples for the next cycle
+        void SetReplayExecutorCycle
+        (
+            size_t                              begin,
+            size_t                              end
+        );
+
+        /// @brief  Executor samples replayed since the last SetReplayFrame
+        const std::vector<InputLogFormat::ExecutorSample>& GetReplayedExecutor() const { return m_replayedExecutor; }
+
+        /// @brief  Motor commands of the last replayed loop
+        const std::vector<std::pair<int, double>>& GetReplayedOutputs() const { return m_replayedOutputs; }
+
+        unsigned int GetDroppedFrames() const { return m_dropped; }
+
+    private:
+        InputRecorder();
+        ~InputRecorder() = default;
+
+        bool Open();
+        bool OpenFile();
+        void DeleteOldLogs();
+        void RunWriter();
+
+        static constexpr size_t     FLUSH_SIZE = 32 * 1024;
+        static constexpr size_t     MAX_PENDING = 1024 * 1024;
+        static constexpr size_t     MAX_FILE_SIZE = 16 * 1024 * 1024;   // about 12 minutes of enabled loops
+        static constexpr size_t     MAX_FILES = 8;
+        static constexpr size_t     MAX_EXECUTOR_SAMPLES = 1024;        // between two loops; more are dropped
+
+        static InputRecorder*                   m_instance;
+
+        std::atomic<MODE>                       m_mode;             // RecordOutput reads it from any thread
+        std::thread::id                         m_loopThread;
+        InputLogFormat::InputFrame              m_frame;
+        const InputLogFormat::InputFrame*       m_replayFrame;
+        std::vector<std::pair<int, double>>     m_replayedOutputs;
+        size_t                                  m_replayExecutorBegin;
+        size_t                                  m_replayExecutorEnd;
+        std::vector<InputLogFormat::ExecutorSample> m_replayedExecutor;
+        double                                  m_executorCycleTime;    // executor thread only
+        std::mutex                              m_executorMutex;
+        std::vector<InputLogFormat::ExecutorSample> m_executorSamples;  // guarded by m_executorMutex
+        double                                  m_lastLoopEnd;
+        std::vector<uint8_t>                    m_payload;
+
+        std::mutex                              m_mutex;
+        std::condition_variable                 m_ready;
+        std::vector<uint8_t>                    m_pending;          // guarded by m_mutex
+        std::vector<uint8_t>                    m_writing;          // writer thread only
+        std::string                             m_directory;
+        std::FILE*                              m_file;             // writer thread only once recording starts
+        size_t                                  m_fileSize;
+        unsigned int                            m_dropped;
+};
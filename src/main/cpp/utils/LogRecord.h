@@ -0,0 +1,68 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Team 302 includes
+#include <utils/LoggerEnums.h>
+
+/// @brief Fixed size copy of one logged item.  The robot loop fills these in and the logger's background 
+/// @brief thread sends them to their destination, so nothing on the loop allocates or waits on I/O.
+struct LogRecord
+{
+    /// @enum VALUE_TYPE
+    /// @brief which of the value fields is filled in
+    enum VALUE_TYPE
+    {
+        STRING_VALUE,
+        DOUBLE_VALUE,
+        BOOL_VALUE,
+        INT_VALUE
+    };
+
+    static constexpr size_t GROUP_SIZE = 48;
+    static constexpr size_t IDENTIFIER_SIZE = 64;
+    static constexpr size_t MESSAGE_SIZE = 64;
+
+    LOGGER_OPTION       option;                         // where the record should be written
+    VALUE_TYPE          type;
+    uint64_t            timestamp;                      // FPGA time (microseconds) when it was logged
+    char                group[GROUP_SIZE];
+    char                identifier[IDENTIFIER_SIZE];
+    char                message[MESSAGE_SIZE];          // used for STRING_VALUE
+    double              value;                          // used for DOUBLE_VALUE, BOOL_VALUE and INT_VALUE
+
+    /// @brief copy a string into one of the fixed size fields, truncating it if it doesn't fit
+    /// @param [in] char*: destination field
+    /// @param [in] size_t: size of the destination field
+    /// @param [in] std::string: text to copy
+    static void CopyText
+    (
+        char*                   dest,
+        size_t                  size,
+        const std::string&      text
+    )
+    {
+        auto len = text.size() < size ? text.size() : size - 1;
+        std::memcpy( dest, text.c_str(), len );
+        dest[len] = '\0';
+    }
+};
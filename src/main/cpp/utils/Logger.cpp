@@ -26,11 +26,17 @@
 
 // C++ Includes
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <string>
+#include <thread>
 
 // FRC includes
+#include <frc/RobotController.h>
+#include <frc/Threads.h>
 #include <frc/SmartDashboard/SendableChooser.h>
 #include <frc/SmartDashboard/SmartDashboard.h>
 #include <networktables/NetworkTableInstance.h>
@@ -38,6 +44,7 @@
 #include <networktables/NetworkTableEntry.h>
 
 // Team 302 includes
+#include <utils/LogRecord.h>
 #include <utils/Logger.h>
 
 
@@ -50,6 +57,7 @@ using namespace std;
 /// @brief Find or create the singleton logger
 /// @returns Logger* pointer to the logger
 Logger* Logger::m_instance = nullptr;
+atomic<unsigned int> Logger::m_enabledLevels{0U};
 Logger* Logger::GetLogger()
 {
     if ( Logger::m_instance == nullptr )
@@ -73,27 +81,9 @@ void Logger::LogData
     const string&   message                 
 )
 {
-    if (ShouldDisplayIt(level, group, identifier, message))
+    if (IsLoggingEnabled(level) && ShouldDisplayIt(level, group, identifier, message))
     {
-        switch ( m_option )
-        {
-            case LOGGER_OPTION::CONSOLE:
-            {
-                cout << group << " " << identifier << ": " << message << endl;
-            }
-            break;
-
-            case LOGGER_OPTION::DASHBOARD:
-            {
-                auto table = nt::NetworkTableInstance::GetDefault().GetTable(group);
-        	    table.get()->PutString(identifier, message);
-            }
-            break;
-
-            default:  // case LOGGER_OPTION::EAT_IT:
-                break;
-
-        }
+        QueueRecord(level, group, identifier, LogRecord::VALUE_TYPE::STRING_VALUE, message, 0.0);
     }
 }
 
@@ -110,27 +100,10 @@ void Logger::LogData
     double          value                 
 )
 {
-    if (ShouldDisplayIt(level, group, identifier, to_string(value)))
+    // the value only has to be formatted here when it is needed for the *_ONCE key
+    if (IsLoggingEnabled(level) && (!IsOnceLevel(level) || ShouldDisplayIt(level, group, identifier, to_string(value))))
     {
-        switch ( m_option )
-        {
-            case LOGGER_OPTION::CONSOLE:
-            {
-                cout << group << " " << identifier << ": " << to_string(value) << endl;
-            }
-            break;
-
-            case LOGGER_OPTION::DASHBOARD:
-            {
-                auto table = nt::NetworkTableInstance::GetDefault().GetTable(group);
-	            table.get()->PutNumber(identifier, value);
-            }
-            break;
-
-            default:  // case LOGGER_OPTION::EAT_IT:
-                break;
-
-        }
+        QueueRecord(level, group, identifier, LogRecord::VALUE_TYPE::DOUBLE_VALUE, string(), static_cast<double>(value));
     }
 }
 
@@ -148,27 +121,10 @@ void Logger::LogData
     bool                    value                 
 )
 {
-    if (ShouldDisplayIt(level, group, identifier, to_string(value)))
+    // the value only has to be formatted here when it is needed for the *_ONCE key
+    if (IsLoggingEnabled(level) && (!IsOnceLevel(level) || ShouldDisplayIt(level, group, identifier, to_string(value))))
     {
-        switch ( m_option )
-        {
-            case LOGGER_OPTION::CONSOLE:
-            {
-                cout << group << " " << identifier << ": " << to_string(value) << endl;
-            }
-            break;
-
-            case LOGGER_OPTION::DASHBOARD:
-            {
-                auto table = nt::NetworkTableInstance::GetDefault().GetTable(group);
-	            table.get()->PutBoolean(identifier, value);
-            }
-            break;
-
-            default:  // case LOGGER_OPTION::EAT_IT:
-                break;
-
-        }
+        QueueRecord(level, group, identifier, LogRecord::VALUE_TYPE::BOOL_VALUE, string(), static_cast<double>(value));
     }
 }
 
@@ -185,27 +141,10 @@ void Logger::LogData
     int                     value                 
 )
 {
-    if (ShouldDisplayIt(level, group, identifier, to_string(value)))
+    // the value only has to be formatted here when it is needed for the *_ONCE key
+    if (IsLoggingEnabled(level) && (!IsOnceLevel(level) || ShouldDisplayIt(level, group, identifier, to_string(value))))
     {
-        switch ( m_option )
-        {
-            case LOGGER_OPTION::CONSOLE:
-            {
-                cout << group << " " << identifier << ": " << to_string(value) << endl;
-            }
-            break;
-
-            case LOGGER_OPTION::DASHBOARD:
-            {
-                auto table = nt::NetworkTableInstance::GetDefault().GetTable(group);
-	            table.get()->PutNumber(identifier, value);
-            }
-            break;
-
-            default:  // case LOGGER_OPTION::EAT_IT:
-                break;
-
-        }
+        QueueRecord(level, group, identifier, LogRecord::VALUE_TYPE::INT_VALUE, string(), static_cast<double>(value));
     }
 }
 
@@ -214,6 +153,10 @@ void Logger::LogData
     LoggerData&     info
 )
 {
+    if (!IsLoggingEnabled(info.level))
+    {
+        return;
+    }
     for (auto boollog : info.bools)
     {
         LogData(info.level, info.group, boollog.first, boollog.second);
@@ -246,26 +189,77 @@ bool Logger::ShouldDisplayIt
     const string&   message                 
 )
 {
-    if (m_option == LOGGER_OPTION::EAT_IT)
+    if (!IsLoggingEnabled(level))
     {
         return false;
     }
     // If the error level is *_ONCE, display it only the first time it happens
-    if ((level == ERROR_ONCE) || (level == WARNING_ONCE) || (level == PRINT_ONCE))
+    if (IsOnceLevel(level))
     {
-        string key = group + identifier + message;
-        auto it = m_alreadyDisplayed.find(key);
-        if (it == m_alreadyDisplayed.end())  // display if not already displayed
+        // the hash finds the candidates; only an exact match means the message was already logged
+        auto key = GetOnceKey(group, identifier, message);
+        lock_guard<mutex> lock(m_onceMutex);
+        auto range = m_alreadyDisplayed.equal_range(key);
+        for (auto itr = range.first; itr != range.second; ++itr)
         {
-            m_alreadyDisplayed.insert(key);     // save the key
-            return true;
+            const auto& logged = itr->second;
+            if (logged.message == message && logged.identifier == identifier && logged.group == group)
+            {
+                return false;
+            }
         }
-        return false;
-
+        m_alreadyDisplayed.emplace(key, OnceMessage{group, identifier, message});
+        return true;
     }
     return true;
 }
 
+/// @brief combine the group, identifier and message into the key used to remember *_ONCE messages
+/// @param [in] std::string: network table name or classname to group messages
+/// @param [in] std::string: message identifier
+/// @param [in] std::string: message/value
+/// @returns size_t: hash for m_alreadyDisplayed
+size_t Logger::GetOnceKey
+(
+    const string&   group,
+    const string&   identifier,     
+    const string&   message                 
+) const
+{
+    // hash each piece and combine them, so no concatenated string has to be built
+    hash<string> hasher;
+    auto key = hasher(group);
+    key ^= hasher(identifier) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= hasher(message) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    return key;
+}
+
+/// @brief recalculate the enabled level masks from the current option, level and telemetry switch
+void Logger::UpdateEnabledLevels()
+{
+    unsigned int enabled = 0U;
+    if (m_option == LOGGER_OPTION::CONSOLE || m_option == LOGGER_OPTION::DASHBOARD)
+    {
+        // levels come in pairs (xxx_ONCE, xxx) ordered from worst to best, so the selected level 
+        // enables its pair and everything worse
+        for (auto level=0; level<=LOGGER_LEVEL::PRINT; ++level)
+        {
+            if ((level / 2) <= (m_level / 2))
+            {
+                enabled |= (1U << level);
+            }
+        }
+    }
+    m_displayLevels = enabled;
+
+    // the telemetry file is full rate capture, so it takes every level
+    if (m_recordTelemetry.load() || m_option == LOGGER_OPTION::BINARY_FILE)
+    {
+        enabled = (1U << (LOGGER_LEVEL::PRINT + 1)) - 1U;
+    }
+    m_enabledLevels = enabled;
+}
+
 /// @brief Display/select logging options/levels on dashboard
 void Logger::PutLoggingSelectionsOnDashboard()
 {
@@ -273,6 +267,7 @@ void Logger::PutLoggingSelectionsOnDashboard()
     m_optionChooser.SetDefaultOption("EAT_IT", LOGGER_OPTION::EAT_IT);
     m_optionChooser.AddOption("DASHBOARD", LOGGER_OPTION::DASHBOARD);
     m_optionChooser.AddOption("CONSOLE", LOGGER_OPTION::CONSOLE);
+    m_optionChooser.AddOption("BINARY_FILE", LOGGER_OPTION::BINARY_FILE);
     frc::SmartDashboard::PutData("Logging Options", &m_optionChooser);
 
     // set up level menu
@@ -284,6 +279,11 @@ void Logger::PutLoggingSelectionsOnDashboard()
     m_levelChooser.AddOption("PRINT", LOGGER_LEVEL::PRINT);
     frc::SmartDashboard::PutData("Logging Levels", &m_levelChooser);
 
+    // set up telemetry file menu
+    m_telemetryChooser.SetDefaultOption("ON", true);
+    m_telemetryChooser.AddOption("OFF", false);
+    frc::SmartDashboard::PutData("Telemetry File", &m_telemetryChooser);
+
     m_cyclingCounter = 0;
 }
 
@@ -315,6 +315,10 @@ void Logger::PeriodicLog()
                     optionAsString.assign("DASHBOARD");
                     break;
 
+                case BINARY_FILE:
+                    optionAsString.assign("BINARY_FILE");
+                    break;
+
                 case EAT_IT:
                     optionAsString.assign("EAT_IT");
                     break;
@@ -324,6 +328,7 @@ void Logger::PeriodicLog()
                     m_option = EAT_IT;
                     break;
             }
+            UpdateEnabledLevels();
             LogData(LOGGER_LEVEL::PRINT, string("Logger"), string("Selected Option"), optionAsString);
         }
 
@@ -369,8 +374,263 @@ void Logger::PeriodicLog()
                     m_level = WARNING;
                     break;
             }
+            UpdateEnabledLevels();
             LogData(LOGGER_LEVEL::PRINT, string("Logger"), string("Selected Level"), levelAsString);
         }
+
+        //
+        // Check for the telemetry file being turned on or off
+        //
+        auto record = m_telemetryChooser.GetSelected();
+        if (record != m_recordTelemetry.load())
+        {
+            SetTelemetryRecording(record);
+        }
+    }
+}
+
+/// @brief the calling thread's record queues.  Each logging thread gets its own single producer queues the first 
+/// @brief time it logs, so producers never wait on each other; a thread that exits gives its queues to the next 
+/// @brief new thread.
+/// @returns Producer*: the queues or nullptr if every producer slot is taken
+Logger::Producer* Logger::GetProducer()
+{
+    thread_local ProducerHandle handle;
+    if (!handle.registered)
+    {
+        handle.registered = true;
+        lock_guard<mutex> lock(m_producerMutex);
+        auto count = m_producerCount.load(memory_order_relaxed);
+        for (auto inx=0; inx<count && handle.slot<0; ++inx)
+        {
+            if (!m_producers[inx].inUse)
+            {
+                handle.slot = inx;
+            }
+        }
+        if (handle.slot < 0 && count < kMaxProducers)
+        {
+            m_producers[count].ring = make_unique<RecordRing>();
+            m_producers[count].telemetry = make_unique<TelemetryRing>();
+            handle.slot = count;
+            m_producerCount.store(count + 1, memory_order_release);
+        }
+        if (handle.slot >= 0)
+        {
+            m_producers[handle.slot].inUse = true;
+            handle.logger = this;
+        }
+    }
+    return handle.slot >= 0 ? &m_producers[handle.slot] : nullptr;
+}
+
+/// @brief give the producer slot back when its thread exits (records still queued are written as usual)
+Logger::ProducerHandle::~ProducerHandle()
+{
+    if (logger != nullptr && slot >= 0)
+    {
+        lock_guard<mutex> lock(logger->m_producerMutex);
+        logger->m_producers[slot].inUse = false;
+    }
+}
+
+/// @brief copy a message into the calling thread's record queues for the writer thread: the display queue if 
+/// @brief the level is displayed and the telemetry queue if the telemetry file is on.  This never blocks; if a 
+/// @brief queue is full the record is dropped and counted.
+/// @param [in] LOGGER_LEVEL: message level
+/// @param [in] std::string: network table name or classname to group messages
+/// @param [in] std::string: message identifier
+/// @param [in] LogRecord::VALUE_TYPE: which value is being logged
+/// @param [in] std::string: message (STRING_VALUE)
+/// @param [in] double: value (DOUBLE_VALUE, BOOL_VALUE, INT_VALUE)
+void Logger::QueueRecord
+(
+    LOGGER_LEVEL            level,
+    const string&           group,
+    const string&           identifier,
+    LogRecord::VALUE_TYPE   type,
+    const string&           message,
+    double                  value
+)
+{
+    auto producer = GetProducer();
+    auto display = (m_displayLevels.load(memory_order_relaxed) & (1U << level)) != 0U;
+    auto telemetry = m_recordTelemetry.load(memory_order_relaxed) || m_option.load(memory_order_relaxed) == LOGGER_OPTION::BINARY_FILE;
+    auto timestamp = frc::RobotController::GetFPGATime();
+
+    auto fill = [&](LogRecord* record, LOGGER_OPTION option)
+    {
+        record->option = option;
+        record->type = type;
+        record->timestamp = timestamp;
+        LogRecord::CopyText(record->group, LogRecord::GROUP_SIZE, group);
+        LogRecord::CopyText(record->identifier, LogRecord::IDENTIFIER_SIZE, identifier);
+        LogRecord::CopyText(record->message, LogRecord::MESSAGE_SIZE, message);
+        record->value = value;
+    };
+
+    if (display)
+    {
+        auto record = producer != nullptr ? producer->ring->Reserve() : nullptr;
+        if (record != nullptr)
+        {
+            fill(record, m_option.load(memory_order_relaxed));
+            producer->ring->Push();
+        }
+        else
+        {
+            m_droppedRecords.fetch_add(1, memory_order_relaxed);
+        }
+    }
+    if (telemetry)
+    {
+        auto record = producer != nullptr ? producer->telemetry->Reserve() : nullptr;
+        if (record != nullptr)
+        {
+            fill(record, LOGGER_OPTION::BINARY_FILE);
+            producer->telemetry->Push();
+        }
+        else
+        {
+            m_droppedSamples.fetch_add(1, memory_order_relaxed);
+        }
+    }
+}
+
+/// @brief wait until the writer thread has taken every queued record (for the desktop tools; this 
+/// @brief blocks, so it must not be called from the robot loop)
+void Logger::Drain()
+{
+    auto isEmpty = [this]()
+    {
+        auto producers = m_producerCount.load(memory_order_acquire);
+        for (auto inx=0; inx<producers; ++inx)
+        {
+            if (!m_producers[inx].ring->IsEmpty() || !m_producers[inx].telemetry->IsEmpty())
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (m_running.load(memory_order_relaxed) && !isEmpty())
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+/// @brief body of the writer thread: drain the record queue to the console / network tables 
+/// @brief until the logger is destroyed
+void Logger::WriteRecords()
+{
+    // keep this below the robot loop
+    frc::SetCurrentThreadPriority(false, 0);
+
+    LogRecord record;
+    unsigned int reportedDrops = 0U;
+    unsigned int reportedSampleDrops = 0U;
+    while (m_running.load(memory_order_relaxed))
+    {
+        auto wroteToConsole = false;
+        auto producers = m_producerCount.load(memory_order_acquire);
+        for (auto inx=0; inx<producers; ++inx)
+        {
+            auto ring = m_producers[inx].ring.get();
+            while (ring->TryPop(record))
+            {
+                WriteRecord(record);
+                wroteToConsole = wroteToConsole || record.option == LOGGER_OPTION::CONSOLE;
+            }
+            auto telemetry = m_producers[inx].telemetry.get();
+            while (telemetry->TryPop(record))
+            {
+                m_recorder.Write(record);
+            }
+        }
+        if (wroteToConsole)
+        {
+            cout.flush();
+        }
+        if (m_recordTelemetry.load(memory_order_relaxed) || m_option.load(memory_order_relaxed) == LOGGER_OPTION::BINARY_FILE)
+        {
+            m_recorder.Flush(false);
+        }
+        else
+        {
+            m_recorder.Close();     // finish the file once recording is turned off
+        }
+
+        auto dropped = m_droppedRecords.load(memory_order_relaxed);
+        auto droppedSamples = m_droppedSamples.load(memory_order_relaxed);
+        if (dropped != reportedDrops || droppedSamples != reportedSampleDrops)
+        {
+            reportedDrops = dropped;
+            reportedSampleDrops = droppedSamples;
+            auto table = nt::NetworkTableInstance::GetDefault().GetTable(string("Logger"));
+            table.get()->PutNumber(string("dropped records"), dropped);
+            table.get()->PutNumber(string("dropped telemetry samples"), droppedSamples);
+        }
+
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+}
+
+/// @brief write one record to its destination (called on the writer thread)
+/// @param [in] LogRecord: record to write
+void Logger::WriteRecord
+(
+    const LogRecord&    record
+)
+{
+    switch ( record.option )
+    {
+        case LOGGER_OPTION::CONSOLE:
+        {
+            cout << record.group << " " << record.identifier << ": ";
+            switch ( record.type )
+            {
+                case LogRecord::VALUE_TYPE::STRING_VALUE:
+                    cout << record.message;
+                    break;
+
+                case LogRecord::VALUE_TYPE::BOOL_VALUE:
+                    cout << to_string(record.value != 0.0);
+                    break;
+
+                case LogRecord::VALUE_TYPE::INT_VALUE:
+                    cout << to_string(static_cast<int>(record.value));
+                    break;
+
+                default:
+                    cout << to_string(record.value);
+                    break;
+            }
+            cout << '\n';
+        }
+        break;
+
+        case LOGGER_OPTION::DASHBOARD:
+        {
+            auto table = nt::NetworkTableInstance::GetDefault().GetTable(record.group);
+            switch ( record.type )
+            {
+                case LogRecord::VALUE_TYPE::STRING_VALUE:
+                    table.get()->PutString(record.identifier, record.message);
+                    break;
+
+                case LogRecord::VALUE_TYPE::BOOL_VALUE:
+                    table.get()->PutBoolean(record.identifier, record.value != 0.0);
+                    break;
+
+                default:
+                    table.get()->PutNumber(record.identifier, record.value);
+                    break;
+            }
+        }
+        break;
+
+        default:  // BINARY_FILE (written from the telemetry queues) and EAT_IT
+            break;
     }
 }
 
@@ -382,6 +642,7 @@ void Logger::SetLoggingOption
 )
 {
     m_option = option;
+    UpdateEnabledLevels();
 }
 
 /// @brief set the level for messages that will be displayed
@@ -392,14 +653,50 @@ void Logger::SetLoggingLevel
 )
 {
     m_level = level;
+    UpdateEnabledLevels();
+}
+
+/// @brief turn the telemetry file on or off.  While it is on every message at every level is recorded, 
+/// @brief whatever the display option and level are.
+/// @param [in] bool: true - record the telemetry file, false - close it
+void Logger::SetTelemetryRecording
+(
+    bool    record
+)
+{
+    m_recordTelemetry = record;
+    UpdateEnabledLevels();
 }
 
 
 Logger::Logger() : m_option( LOGGER_OPTION::EAT_IT ), 
                    m_level( LOGGER_LEVEL::PRINT ),
                    m_alreadyDisplayed(),
+                   m_onceMutex(),
                    m_cyclingCounter(0), 
                    m_optionChooser(),
-                   m_levelChooser()
+                   m_levelChooser(),
+                   m_telemetryChooser(),
+                   m_recordTelemetry(false),
+                   m_displayLevels(0U),
+                   m_producers(),
+                   m_producerCount(0),
+                   m_producerMutex(),
+                   m_droppedRecords(0U),
+                   m_droppedSamples(0U),
+                   m_running(true),
+                   m_recorder(),
+                   m_writer()
 {
+    UpdateEnabledLevels();
+    m_writer = thread(&Logger::WriteRecords, this);
+}
+
+Logger::~Logger()
+{
+    m_running.store(false);
+    if (m_writer.joinable())
+    {
+        m_writer.join();
+    }
 }
@@ -17,15 +17,23 @@
 #pragma once
 
 // C++ Includes
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <set>
+#include <thread>
+#include <unordered_map>
 
 // FRC includes
 #include <frc/SmartDashboard/SendableChooser.h>
 
 // Team 302 includes
+#include <utils/LogRecord.h>
 #include <utils/LoggerData.h>
 #include <utils/LoggerEnums.h>
+#include <utils/SPSCRingBuffer.h>
+#include <utils/TelemetryRecorder.h>
 
 class Logger
 {
@@ -36,6 +44,18 @@ class Logger
         /// @returns Logger* pointer to the logger
         static Logger* GetLogger();
 
+        /// @brief Check whether a message at this level would be logged with the current option and level.  This 
+        /// @brief is a single test, so callers can skip building the message when logging is off (see LOG_DATA).
+        /// @param [in] LOGGER_LEVEL: message level
+        /// @returns bool: true - the message will be logged, false - the message will be dropped
+        static inline bool IsLoggingEnabled
+        (
+            LOGGER_LEVEL            level
+        )
+        {
+            return ( m_enabledLevels.load( std::memory_order_relaxed ) & ( 1U << level ) ) != 0U;
+        }
+
         /// @brief log a message
         /// @param [in] LOGGER_LEVEL: message level
         /// @param [in] std::string: network table name or classname to group messages.  If logging option is DASHBOARD, this will be the network table name
@@ -99,6 +119,32 @@ class Logger
         /// @brief Read logging option from dashboard, but not every 20ms
         void PeriodicLog();
 
+        /// @brief set the option for where the logging messages should be displayed
+        /// @param [in] LOGGER_OPTION:  logging option for where to log messages
+        void SetLoggingOption
+        (
+            LOGGER_OPTION option    // <I> - Logging option
+        );
+
+        /// @brief set the level for messages that will be displayed
+        /// @param [in] LOGGER_LEVEL:  logging level for which messages to display
+        void SetLoggingLevel
+        (
+            LOGGER_LEVEL level    // <I> - Logging level
+        );
+
+        /// @brief turn the telemetry file on or off.  While it is on every message at every level is recorded, 
+        /// @brief whatever the display option and level are.
+        /// @param [in] bool: true - record the telemetry file, false - close it
+        void SetTelemetryRecording
+        (
+            bool    record
+        );
+
+        /// @brief wait until the writer thread has taken every queued record (for the desktop tools; this 
+        /// @brief blocks, so it must not be called from the robot loop)
+        void Drain();
+
 
     protected:
 
@@ -117,35 +163,136 @@ class Logger
             const std::string&      identifier,     
             const std::string&      message  
         );
-        
-        /// @brief set the option for where the logging messages should be displayed
-        /// @param [in] LOGGER_OPTION:  logging option for where to log messages
-        void SetLoggingOption
+
+        /// @brief check for the levels that are only displayed the first time they are logged
+        /// @param [in] LOGGER_LEVEL: message level
+        /// @returns bool: true for ERROR_ONCE, WARNING_ONCE and PRINT_ONCE
+        static inline bool IsOnceLevel
         (
-            LOGGER_OPTION option    // <I> - Logging option
+            LOGGER_LEVEL            level
+        )
+        {
+            return (level == ERROR_ONCE) || (level == WARNING_ONCE) || (level == PRINT_ONCE);
+        }
+
+        using RecordRing = SPSCRingBuffer<LogRecord, 512>;
+        using TelemetryRing = SPSCRingBuffer<LogRecord, 2048>;
+
+        struct Producer;
+
+        /// @brief the calling thread's record queues, created the first time the thread logs
+        /// @returns Producer*: the queues or nullptr if every producer slot is taken
+        Producer* GetProducer();
+
+        /// @brief copy a message into the record queues for the writer thread
+        /// @param [in] LOGGER_LEVEL: message level
+        /// @param [in] std::string: network table name or classname to group messages
+        /// @param [in] std::string: message identifier
+        /// @param [in] LogRecord::VALUE_TYPE: which value is being logged
+        /// @param [in] std::string: message (STRING_VALUE)
+        /// @param [in] double: value (DOUBLE_VALUE, BOOL_VALUE, INT_VALUE)
+        void QueueRecord
+        (
+            LOGGER_LEVEL            level,
+            const std::string&      group,
+            const std::string&      identifier,
+            LogRecord::VALUE_TYPE   type,
+            const std::string&      message,
+            double                  value
         );
 
-        /// @brief set the level for messages that will be displayed
-        /// @param [in] LOGGER_LEVEL:  logging level for which messages to display
-        void SetLoggingLevel
+        /// @brief body of the writer thread
+        void WriteRecords();
+
+        /// @brief write one record to its destination (writer thread)
+        /// @param [in] LogRecord: record to write
+        void WriteRecord
         (
-            LOGGER_LEVEL level    // <I> - Logging level
+            const LogRecord&        record
         );
 
+        /// @brief recalculate the enabled level masks from the current option, level and telemetry switch
+        void UpdateEnabledLevels();
 
-        LOGGER_OPTION                           m_option;               // indicates where the message should go
-        LOGGER_LEVEL                            m_level;                // the level at which a message is important enough to send
-        std::set<std::string>                   m_alreadyDisplayed;
+        /// @brief combine the group, identifier and message into the hash used to find *_ONCE messages
+        /// @param [in] std::string: network table name or classname to group messages
+        /// @param [in] std::string: message identifier
+        /// @param [in] std::string: message/value
+        /// @returns size_t: hash for m_alreadyDisplayed
+        size_t GetOnceKey
+        (
+            const std::string&      group,
+            const std::string&      identifier,     
+            const std::string&      message  
+        ) const;
+
+        /// @brief a *_ONCE message already logged; the text is kept so messages whose hashes collide both get logged
+        struct OnceMessage
+        {
+            std::string     group;
+            std::string     identifier;
+            std::string     message;
+        };
+
+        /// @brief the record queues owned by one logging thread at a time; the writer drains every one of them.  
+        /// @brief The telemetry queue is separate (and bigger) so console/dashboard traffic can't crowd it out.
+        struct Producer
+        {
+            std::unique_ptr<RecordRing>     ring;
+            std::unique_ptr<TelemetryRing>  telemetry;
+            bool                            inUse = false;      // guarded by m_producerMutex
+        };
+
+        /// @brief thread_local owner of a producer slot; gives the slot back when its thread exits
+        struct ProducerHandle
+        {
+            ~ProducerHandle();
+
+            Logger*     logger = nullptr;
+            int         slot = -1;
+            bool        registered = false;
+        };
+
+        static constexpr int                    kMaxProducers = 16;
+
+
+        std::atomic<LOGGER_OPTION>              m_option;               // indicates where the message should go
+        std::atomic<LOGGER_LEVEL>               m_level;                // the level at which a message is important enough to send
+        std::unordered_multimap<size_t, OnceMessage> m_alreadyDisplayed;   // *_ONCE messages already logged by hash
+        std::mutex                              m_onceMutex;            // guards m_alreadyDisplayed (any thread may log)
         int                                     m_cyclingCounter;       // count 20ms loops
         frc::SendableChooser<LOGGER_OPTION>     m_optionChooser;
         frc::SendableChooser<LOGGER_LEVEL>      m_levelChooser;
+        frc::SendableChooser<bool>              m_telemetryChooser;
+        std::atomic<bool>                       m_recordTelemetry;      // telemetry file switch (independent of m_option)
+        std::atomic<unsigned int>               m_displayLevels;        // bit per LOGGER_LEVEL sent to the console/dashboard
+
+        std::array<Producer, kMaxProducers>     m_producers;            // one single producer queue per logging thread, drained by m_writer
+        std::atomic<int>                        m_producerCount;        // slots of m_producers that have a ring
+        std::mutex                              m_producerMutex;        // only taken the first time a thread logs (and when it exits)
+        std::atomic<unsigned int>               m_droppedRecords;       // records lost because the queue was full
+        std::atomic<unsigned int>               m_droppedSamples;       // telemetry records lost because the queue was full
+        std::atomic<bool>                       m_running;
+        TelemetryRecorder                       m_recorder;             // telemetry file (only used by m_writer)
+        std::thread                             m_writer;               // low priority thread doing the console/NT I/O
 
 
         Logger();
-        ~Logger() = default;
+        ~Logger();
 
         static Logger*                          m_instance;
+        static std::atomic<unsigned int>        m_enabledLevels;        // bit per LOGGER_LEVEL that is displayed or recorded
 
 };
 
+/// @brief Log a message only if its level is enabled.  The group, identifier and value arguments aren't evaluated
+/// @brief when the message would be dropped, so hot paths don't pay for building strings that are never displayed.
+#define LOG_DATA( level, group, identifier, value )                                 \
+    do                                                                              \
+    {                                                                               \
+        if ( Logger::IsLoggingEnabled( level ) )                                    \
+        {                                                                           \
+            Logger::GetLogger()->LogData( level, group, identifier, value );        \
+        }                                                                           \
+    } while ( 0 )
 
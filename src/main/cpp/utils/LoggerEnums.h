@@ -22,6 +22,7 @@ enum LOGGER_OPTION
 {
     CONSOLE,        ///< write to the RoboRio Console
     DASHBOARD,      ///< write to the SmartDashboard
+    BINARY_FILE,    ///< only record the binary telemetry file (see Logger::SetTelemetryRecording), nothing is displayed
     EAT_IT          ///< don't write anything (useful at comps where we want to minimize network traffic)
 };
 
@@ -0,0 +1,158 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// FRC includes
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableInstance.h>
+
+// Team 302 includes
+#include <utils/Logger.h>
+#include <utils/LoopProfiler.h>
+
+// Third Party Includes
+
+#if LOOP_PROFILER_ENABLED
+
+using namespace std;
+
+LoopProfiler* LoopProfiler::m_instance = nullptr;
+
+LoopProfiler* LoopProfiler::GetInstance()
+{
+    if ( LoopProfiler::m_instance == nullptr )
+    {
+        LoopProfiler::m_instance = new LoopProfiler();
+    }
+    return LoopProfiler::m_instance;
+}
+
+LoopProfiler::LoopProfiler() : m_histograms(),
+                               m_loopTimes(),
+                               m_entries(),
+                               m_overruns(),
+                               m_loopStart(),
+                               m_loopStarted( false ),
+                               m_cycle( 0 ),
+                               m_overrunCount( 0 )
+{
+    auto table = nt::NetworkTableInstance::GetDefault().GetTable( string( "LoopProfiler" ) );
+    for ( auto inx=0; inx<MAX_PHASES; ++inx )
+    {
+        string name( PHASE_NAMES[inx] );
+        m_entries[inx].p50 = table->GetEntry( name + string( " p50 (ms)" ) );
+        m_entries[inx].p99 = table->GetEntry( name + string( " p99 (ms)" ) );
+        m_entries[inx].max = table->GetEntry( name + string( " max (ms)" ) );
+    }
+    m_overruns = table->GetEntry( string( "Overruns" ) );
+}
+
+/// @brief  Close out the loop (called at the end of RobotPeriodic):  check the budgets and publish
+void LoopProfiler::EndLoop()
+{
+    if ( m_loopStarted )
+    {
+        auto elapsed = chrono::duration_cast<chrono::microseconds>( chrono::steady_clock::now() - m_loopStart );
+        Record( PHASE::LOOP, static_cast<uint32_t>( elapsed.count() ) );
+    }
+
+    for ( auto inx=0; inx<MAX_PHASES; ++inx )
+    {
+        if ( m_loopTimes[inx] > PHASE_BUDGETS_US[inx] )
+        {
+            ++m_overrunCount;
+            LogOverrun();
+            break;
+        }
+    }
+
+    ++m_cycle;
+    if ( m_cycle >= PUBLISH_CYCLES )
+    {
+        Publish();
+        m_cycle = 0;
+    }
+
+    m_loopTimes.fill( 0 );
+    m_loopStarted = false;
+}
+
+/// @brief  Log every phase's time for this loop, flagging the ones over budget
+void LoopProfiler::LogOverrun() const
+{
+    string msg;
+    for ( auto inx=0; inx<MAX_PHASES; ++inx )
+    {
+        msg += PHASE_NAMES[inx];
+        msg += " ";
+        msg += to_string( m_loopTimes[inx] / 1000.0 );
+        msg += " ms";
+        if ( m_loopTimes[inx] > PHASE_BUDGETS_US[inx] )
+        {
+            msg += " (over ";
+            msg += to_string( PHASE_BUDGETS_US[inx] / 1000.0 );
+            msg += " ms budget)";
+        }
+        msg += "; ";
+    }
+    Logger::GetLogger()->LogData( LOGGER_LEVEL::WARNING, string( "LoopProfiler" ), string( "Overrun" ), msg );
+}
+
+/// @brief  Publish p50/p99/max for each phase and start new histograms
+void LoopProfiler::Publish()
+{
+    for ( auto inx=0; inx<MAX_PHASES; ++inx )
+    {
+        auto& histogram = m_histograms[inx];
+        if ( histogram.count > 0 )
+        {
+            m_entries[inx].p50.SetDouble( histogram.Percentile( 0.50 ) / 1000.0 );
+            m_entries[inx].p99.SetDouble( histogram.Percentile( 0.99 ) / 1000.0 );
+            m_entries[inx].max.SetDouble( histogram.max / 1000.0 );
+        }
+        histogram.Clear();
+    }
+    m_overruns.SetDouble( m_overrunCount );
+}
+
+/// @brief  Upper edge of the bucket the fraction of samples falls in (the max for the overflow bucket)
+/// @param [in] double  fraction:   0.5 for the median, 0.99 for p99
+/// @return uint32_t    microseconds
+uint32_t LoopProfiler::Histogram::Percentile
+(
+    double      fraction
+) const
+{
+    auto target = static_cast<uint32_t>( fraction * count );
+    uint32_t seen = 0;
+    for ( uint32_t inx=0; inx<NUM_BUCKETS-1; ++inx )
+    {
+        seen += buckets[inx];
+        if ( seen > target )
+        {
+            return std::min( ( inx + 1 ) * BUCKET_WIDTH_US, max );
+        }
+    }
+    return max;
+}
+
+#endif
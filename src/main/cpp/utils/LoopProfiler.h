@@ -0,0 +1,190 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// FRC includes
+#include <networktables/NetworkTableEntry.h>
+
+// Team 302 includes
+
+// Third Party Includes
+
+/// @brief Set to 1 (here or with -DLOOP_PROFILER_ENABLED=1) to time the robot loop phases.  When it is 0 the
+/// @brief PROFILE_* macros expand to nothing and the profiler isn't compiled in.
+#ifndef LOOP_PROFILER_ENABLED
+#define LOOP_PROFILER_ENABLED 0
+#endif
+
+#if LOOP_PROFILER_ENABLED
+
+/// @class LoopProfiler
+/// @brief Times the phases of the robot loop into fixed bucket histograms.  p50/p99/max for each phase are
+/// @brief published to the "LoopProfiler" network table every few seconds and every phase time is logged
+/// @brief when the loop, or any phase, runs over its budget.
+class LoopProfiler
+{
+    public:
+        enum PHASE
+        {
+            SENSORS,        ///< RobotStateMgr::Update
+            ODOMETRY,       ///< IChassis::UpdateOdometry
+            DRIVE,          ///< SwerveDrive / ArcadeDrive Run
+            MECHANISMS,     ///< StateMgrHelper::RunCurrentMechanismStates
+            AUTON,          ///< CyclePrimitives::Run
+            LOGGER,         ///< Logger::PeriodicLog and robot level logging
+            LOOP,           ///< first phase through the end of RobotPeriodic
+            MAX_PHASES
+        };
+
+        static LoopProfiler* GetInstance();
+
+        /// @brief  Start the loop timer if this is the first phase of the loop
+        /// @param [in] std::chrono::steady_clock::time_point   start:  when the phase started
+        void StartLoop
+        (
+            std::chrono::steady_clock::time_point   start
+        )
+        {
+            if ( !m_loopStarted )
+            {
+                m_loopStart = start;
+                m_loopStarted = true;
+            }
+        }
+
+        /// @brief  Record how long a phase took
+        /// @param [in] PHASE           phase:          phase that finished
+        /// @param [in] uint32_t        microseconds:   time it took
+        void Record
+        (
+            PHASE       phase,
+            uint32_t    microseconds
+        )
+        {
+            m_loopTimes[phase] += microseconds;
+            m_histograms[phase].Add( microseconds );
+        }
+
+        /// @brief  Close out the loop (called at the end of RobotPeriodic):  check the budgets and publish
+        void EndLoop();
+
+    private:
+        LoopProfiler();
+        ~LoopProfiler() = default;
+
+        /// @brief  Time distribution in BUCKET_WIDTH_US buckets; the last bucket holds everything slower
+        struct Histogram
+        {
+            static constexpr uint32_t NUM_BUCKETS = 128;
+            static constexpr uint32_t BUCKET_WIDTH_US = 250;    // 32 ms covered
+
+            void Add( uint32_t microseconds )
+            {
+                ++buckets[ std::min( microseconds / BUCKET_WIDTH_US, NUM_BUCKETS - 1 ) ];
+                ++count;
+                max = std::max( max, microseconds );
+            }
+            uint32_t Percentile( double fraction ) const;
+            void Clear() { buckets.fill( 0 ); count = 0; max = 0; }
+
+            std::array<uint32_t, NUM_BUCKETS>   buckets{};
+            uint32_t                            count = 0;
+            uint32_t                            max = 0;
+        };
+
+        struct PhaseEntries
+        {
+            nt::NetworkTableEntry   p50;
+            nt::NetworkTableEntry   p99;
+            nt::NetworkTableEntry   max;
+        };
+
+        void Publish();
+        void LogOverrun() const;
+
+        static constexpr int PUBLISH_CYCLES = 250;          // 5 s of 20 ms loops
+
+        static constexpr std::array<const char*, MAX_PHASES> PHASE_NAMES = 
+        { 
+            "Sensors", "Odometry", "Drive", "Mechanisms", "Auton", "Logger", "Loop" 
+        };
+        static constexpr std::array<uint32_t, MAX_PHASES> PHASE_BUDGETS_US = 
+        { 
+            2000, 3000, 4000, 4000, 8000, 2000, 20000 
+        };
+
+        std::array<Histogram, MAX_PHASES>       m_histograms;
+        std::array<uint32_t, MAX_PHASES>        m_loopTimes;        // this loop's time in each phase
+        std::array<PhaseEntries, MAX_PHASES>    m_entries;
+        nt::NetworkTableEntry                   m_overruns;
+        std::chrono::steady_clock::time_point   m_loopStart;
+        bool                                    m_loopStarted;
+        int                                     m_cycle;
+        unsigned int                            m_overrunCount;
+
+        static LoopProfiler*                    m_instance;
+};
+
+/// @class ScopedPhaseTimer
+/// @brief Times the enclosing scope as one loop phase
+class ScopedPhaseTimer
+{
+    public:
+        explicit ScopedPhaseTimer
+        (
+            LoopProfiler::PHASE     phase
+        ) : m_phase( phase ),
+            m_start( std::chrono::steady_clock::now() )
+        {
+            LoopProfiler::GetInstance()->StartLoop( m_start );
+        }
+
+        ~ScopedPhaseTimer()
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - m_start );
+            LoopProfiler::GetInstance()->Record( m_phase, static_cast<uint32_t>( elapsed.count() ) );
+        }
+
+        ScopedPhaseTimer( const ScopedPhaseTimer& ) = delete;
+        ScopedPhaseTimer& operator=( const ScopedPhaseTimer& ) = delete;
+
+    private:
+        LoopProfiler::PHASE                     m_phase;
+        std::chrono::steady_clock::time_point   m_start;
+};
+
+#define PROFILE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_CONCAT( a, b ) PROFILE_CONCAT_INNER( a, b )
+
+/// @brief Time the rest of the enclosing scope as the given LoopProfiler::PHASE
+#define PROFILE_PHASE( phase ) ScopedPhaseTimer PROFILE_CONCAT( profilePhase, __LINE__ )( LoopProfiler::PHASE::phase )
+
+/// @brief Mark the end of the robot loop
+#define PROFILE_END_LOOP() LoopProfiler::GetInstance()->EndLoop()
+
+#else
+
+#define PROFILE_PHASE( phase )
+#define PROFILE_END_LOOP()
+
+#endif
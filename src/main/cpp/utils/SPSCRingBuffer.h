@@ -0,0 +1,103 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// @brief Fixed capacity single producer / single consumer queue.  The storage is allocated with the 
+/// @brief object, pushes and pops never block and a full queue rejects the push so the caller can count it.
+/// @tparam T item type (copied in and out)
+/// @tparam SIZE capacity, must be a power of two
+template <typename T, size_t SIZE>
+class SPSCRingBuffer
+{
+    static_assert( SIZE > 1 && ( SIZE & ( SIZE - 1 ) ) == 0, "SPSCRingBuffer size must be a power of two" );
+
+    public:
+        SPSCRingBuffer() : m_items(), m_head(0), m_tail(0)
+        {
+        }
+        ~SPSCRingBuffer() = default;
+
+        /// @brief Reserve the next free slot for the producer to fill in place.  Call Push once it is filled in.
+        /// @returns T* slot to fill in or nullptr if the queue is full
+        T* Reserve()
+        {
+            auto head = m_head.load( std::memory_order_relaxed );
+            if ( head - m_tail.load( std::memory_order_acquire ) >= SIZE )
+            {
+                return nullptr;
+            }
+            return &m_items[head & ( SIZE - 1 )];
+        }
+
+        /// @brief Publish the slot returned by Reserve to the consumer
+        void Push()
+        {
+            m_head.store( m_head.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+        }
+
+        /// @brief Copy an item into the queue
+        /// @param [in] T: item to add
+        /// @returns bool: true - item was queued, false - queue is full
+        bool TryPush
+        (
+            const T&    item
+        )
+        {
+            auto slot = Reserve();
+            if ( slot == nullptr )
+            {
+                return false;
+            }
+            *slot = item;
+            Push();
+            return true;
+        }
+
+        /// @brief Take the oldest item off of the queue
+        /// @param [out] T: item removed
+        /// @returns bool: true - item was removed, false - queue is empty
+        bool TryPop
+        (
+            T&          item
+        )
+        {
+            auto tail = m_tail.load( std::memory_order_relaxed );
+            if ( tail == m_head.load( std::memory_order_acquire ) )
+            {
+                return false;
+            }
+            item = m_items[tail & ( SIZE - 1 )];
+            m_tail.store( tail + 1, std::memory_order_release );
+            return true;
+        }
+
+        /// @returns bool: true if there is nothing to pop
+        bool IsEmpty() const
+        {
+            return m_tail.load( std::memory_order_acquire ) == m_head.load( std::memory_order_acquire );
+        }
+
+    private:
+        std::array<T, SIZE>                     m_items;
+        alignas(64) std::atomic<size_t>         m_head;     // next slot to write (producer)
+        alignas(64) std::atomic<size_t>         m_tail;     // next slot to read (consumer)
+};
@@ -0,0 +1,79 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+/// @brief Single slot holding the latest value from one writer thread.  The writer never blocks; readers
+/// @brief retry if a store lands while they are copying, so every Load returns one coherent value.
+/// @tparam T value type, must be trivially copyable
+template <typename T>
+class SeqLock
+{
+    static_assert( std::is_trivially_copyable<T>::value, "SeqLock values must be trivially copyable" );
+
+    public:
+        SeqLock() : m_sequence(0), m_value()
+        {
+        }
+        ~SeqLock() = default;
+
+        /// @brief Publish a new value (single writer only)
+        /// @param [in] T: value to publish
+        void Store
+        (
+            const T&    value
+        )
+        {
+            auto sequence = m_sequence.load( std::memory_order_relaxed );
+            m_sequence.store( sequence + 1, std::memory_order_relaxed );    // odd while the value is being written
+            std::atomic_thread_fence( std::memory_order_release );
+            std::memcpy( &m_value, &value, sizeof(T) );
+            m_sequence.store( sequence + 2, std::memory_order_release );
+        }
+
+        /// @brief Copy out the latest value
+        /// @returns T: latest value (default constructed if nothing has been stored)
+        T Load() const
+        {
+            T value;
+            unsigned int before;
+            unsigned int after;
+            do
+            {
+                before = m_sequence.load( std::memory_order_acquire );
+                std::memcpy( &value, &m_value, sizeof(T) );
+                std::atomic_thread_fence( std::memory_order_acquire );
+                after = m_sequence.load( std::memory_order_relaxed );
+            } while ( ( before & 1 ) != 0 || before != after );
+            return value;
+        }
+
+        /// @brief Number of values stored so far; readers can use it to tell if there is anything new
+        /// @returns unsigned int: store count
+        unsigned int GetCount() const
+        {
+            return m_sequence.load( std::memory_order_acquire ) / 2;
+        }
+
+    private:
+        std::atomic<unsigned int>       m_sequence;
+        T                               m_value;
+};
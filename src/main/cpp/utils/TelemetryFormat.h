@@ -0,0 +1,163 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/// @brief Layout of the binary telemetry log written by TelemetryRecorder (the logger's telemetry file).  This 
+/// @brief header has no WPILib dependencies so the desktop reader can share it.
+///
+///   file      := header chunk*
+///   header    := MAGIC[8] version:u16
+///   chunk     := SIGNAL id:varint type:u8 groupLen:varint group identifierLen:varint identifier
+///              | SAMPLE id:varint deltaTime:varint value
+///   value     := DOUBLE: n:u8 then the low n bytes (little endian) of bits XOR previous bits
+///              | INT/BOOL: zigzag varint of (value - previous value)
+///              | STRING: len:varint bytes
+///
+/// A SIGNAL chunk is written once, before the first sample of that signal.  deltaTime is microseconds
+/// (FPGA time) since the previous sample in the file; the first sample is relative to 0.  The "previous"
+/// value of a signal starts at 0.
+namespace TelemetryFormat
+{
+    constexpr char      MAGIC[8] = { 'T', '3', '0', '2', 'T', 'L', 'M', '\0' };
+    constexpr uint16_t  VERSION = 1;
+
+    /// @enum CHUNK_TYPE
+    enum CHUNK_TYPE : uint8_t
+    {
+        SIGNAL = 1,
+        SAMPLE = 2
+    };
+
+    /// @enum SIGNAL_TYPE
+    /// @brief value type of a signal (matches LogRecord::VALUE_TYPE)
+    enum SIGNAL_TYPE : uint8_t
+    {
+        STRING_SIGNAL = 0,
+        DOUBLE_SIGNAL = 1,
+        BOOL_SIGNAL = 2,
+        INT_SIGNAL = 3
+    };
+
+    inline void WriteVarint
+    (
+        std::vector<uint8_t>&   buffer,
+        uint64_t                value
+    )
+    {
+        while ( value >= 0x80 )
+        {
+            buffer.push_back( static_cast<uint8_t>( value | 0x80 ) );
+            value >>= 7;
+        }
+        buffer.push_back( static_cast<uint8_t>( value ) );
+    }
+
+    /// @returns bool: false if the buffer ran out before the varint ended
+    inline bool ReadVarint
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end,
+        uint64_t&               value
+    )
+    {
+        value = 0;
+        for ( auto shift=0; shift<64 && pos<end; shift+=7 )
+        {
+            auto byte = *pos++;
+            value |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+            if ( ( byte & 0x80 ) == 0 )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline uint64_t ZigZagEncode( int64_t value )
+    {
+        return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 );
+    }
+
+    inline int64_t ZigZagDecode( uint64_t value )
+    {
+        return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+    }
+
+    inline uint64_t DoubleToBits( double value )
+    {
+        uint64_t bits;
+        std::memcpy( &bits, &value, sizeof( bits ) );
+        return bits;
+    }
+
+    inline double BitsToDouble( uint64_t bits )
+    {
+        double value;
+        std::memcpy( &value, &bits, sizeof( value ) );
+        return value;
+    }
+
+    /// @brief write a double as the XOR with the previous value; unchanged leading bytes (sign, exponent and 
+    /// @brief high mantissa of a slowly changing signal) are dropped
+    inline void WriteDoubleDelta
+    (
+        std::vector<uint8_t>&   buffer,
+        uint64_t                previousBits,
+        uint64_t                bits
+    )
+    {
+        auto delta = bits ^ previousBits;
+        uint8_t count = 0;
+        for ( auto tmp=delta; tmp != 0; tmp >>= 8 )
+        {
+            ++count;
+        }
+        buffer.push_back( count );
+        for ( auto inx=0; inx<count; ++inx )
+        {
+            buffer.push_back( static_cast<uint8_t>( delta >> ( 8 * inx ) ) );
+        }
+    }
+
+    /// @returns bool: false if the buffer ran out
+    inline bool ReadDoubleDelta
+    (
+        const uint8_t*&         pos,
+        const uint8_t*          end,
+        uint64_t                previousBits,
+        uint64_t&               bits
+    )
+    {
+        if ( pos >= end || *pos > 8 || end - pos < 1 + *pos )
+        {
+            return false;
+        }
+        auto count = *pos++;
+        uint64_t delta = 0;
+        for ( auto inx=0; inx<count; ++inx )
+        {
+            delta |= static_cast<uint64_t>( *pos++ ) << ( 8 * inx );
+        }
+        bits = previousBits ^ delta;
+        return true;
+    }
+}
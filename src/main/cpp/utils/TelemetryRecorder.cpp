@@ -0,0 +1,215 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+// Linux includes
+#include <sys/stat.h>
+
+// Team 302 includes
+#include <utils/LogRecord.h>
+#include <utils/TelemetryFormat.h>
+#include <utils/TelemetryRecorder.h>
+
+using namespace std;
+
+/// @brief create the recorder; the file is opened when the first record is written
+/// @param [in] std::string: directory for the files, empty picks the USB stick, the roboRIO or (on the 
+/// @brief desktop) ./telemetry
+TelemetryRecorder::TelemetryRecorder
+(
+    const string&   directory
+) : m_directory(directory),
+    m_path(),
+    m_signals(),
+    m_buffer(),
+    m_file(nullptr),
+    m_openFailed(false),
+    m_lastTimestamp(0),
+    m_lastFlush(chrono::steady_clock::now())
+{
+    m_buffer.reserve(BUFFER_SIZE);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    Close();
+}
+
+/// @brief open a new file in the directory given to the constructor, or else on the USB stick if one is plugged 
+/// @brief in, on the roboRIO, or (in simulation, where there is no /home/lvuser) under the working directory
+/// @returns bool: true if the file is open
+bool TelemetryRecorder::Open()
+{
+    if (m_file != nullptr)
+    {
+        return true;
+    }
+    if (m_openFailed)
+    {
+        return false;
+    }
+
+    auto isDir = [](const char* path)
+    {
+        struct stat info;
+        return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+    };
+    auto dir = m_directory;
+    if (dir.empty())
+    {
+        dir = isDir("/u") ? string("/u/telemetry") : isDir("/home/lvuser") ? string("/home/lvuser/telemetry") : string("telemetry");
+    }
+    mkdir(dir.c_str(), 0755);
+
+    char name[32];
+    auto now = time(nullptr);
+    strftime(name, sizeof(name), "%Y%m%d_%H%M%S", localtime(&now));
+    m_path = dir + string("/telemetry_") + string(name) + string(".t302");
+
+    m_file = fopen(m_path.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        m_openFailed = true;   // don't retry every record
+        return false;
+    }
+
+    m_signals.clear();
+    m_buffer.clear();
+    m_lastTimestamp = 0;
+    m_buffer.insert(m_buffer.end(), TelemetryFormat::MAGIC, TelemetryFormat::MAGIC + sizeof(TelemetryFormat::MAGIC));
+    m_buffer.push_back(static_cast<uint8_t>(TelemetryFormat::VERSION & 0xFF));
+    m_buffer.push_back(static_cast<uint8_t>(TelemetryFormat::VERSION >> 8));
+    return true;
+}
+
+/// @brief find the signal for a record, writing its SIGNAL chunk the first time it is seen
+TelemetryRecorder::SignalInfo& TelemetryRecorder::GetSignal
+(
+    const LogRecord&    record
+)
+{
+    auto key = string(1, static_cast<char>(record.type)) + string(record.group) + string(1, '\0') + string(record.identifier);
+    auto itr = m_signals.find(key);
+    if (itr != m_signals.end())
+    {
+        return itr->second;
+    }
+
+    SignalInfo signal = {m_signals.size(), 0};
+    m_buffer.push_back(TelemetryFormat::CHUNK_TYPE::SIGNAL);
+    TelemetryFormat::WriteVarint(m_buffer, signal.id);
+    m_buffer.push_back(static_cast<uint8_t>(record.type));
+    auto groupLen = strlen(record.group);
+    TelemetryFormat::WriteVarint(m_buffer, groupLen);
+    m_buffer.insert(m_buffer.end(), record.group, record.group + groupLen);
+    auto identifierLen = strlen(record.identifier);
+    TelemetryFormat::WriteVarint(m_buffer, identifierLen);
+    m_buffer.insert(m_buffer.end(), record.identifier, record.identifier + identifierLen);
+
+    return m_signals.emplace(key, signal).first->second;
+}
+
+/// @brief encode a record into the buffer, opening the file on the first one
+/// @param [in] LogRecord: record to write
+void TelemetryRecorder::Write
+(
+    const LogRecord&    record
+)
+{
+    if (!Open())
+    {
+        return;
+    }
+
+    auto& signal = GetSignal(record);
+    m_buffer.push_back(TelemetryFormat::CHUNK_TYPE::SAMPLE);
+    TelemetryFormat::WriteVarint(m_buffer, signal.id);
+    auto delta = record.timestamp >= m_lastTimestamp ? record.timestamp - m_lastTimestamp : 0;
+    TelemetryFormat::WriteVarint(m_buffer, delta);
+    m_lastTimestamp += delta;
+
+    switch (record.type)
+    {
+        case LogRecord::VALUE_TYPE::STRING_VALUE:
+        {
+            auto len = strlen(record.message);
+            TelemetryFormat::WriteVarint(m_buffer, len);
+            m_buffer.insert(m_buffer.end(), record.message, record.message + len);
+        }
+        break;
+
+        case LogRecord::VALUE_TYPE::DOUBLE_VALUE:
+        {
+            auto bits = TelemetryFormat::DoubleToBits(record.value);
+            TelemetryFormat::WriteDoubleDelta(m_buffer, signal.previous, bits);
+            signal.previous = bits;
+        }
+        break;
+
+        default:    // BOOL_VALUE and INT_VALUE
+        {
+            auto value = static_cast<int64_t>(record.value);
+            TelemetryFormat::WriteVarint(m_buffer, TelemetryFormat::ZigZagEncode(value - static_cast<int64_t>(signal.previous)));
+            signal.previous = static_cast<uint64_t>(value);
+        }
+        break;
+    }
+
+    if (m_buffer.size() >= FLUSH_SIZE)
+    {
+        Flush(true);
+    }
+}
+
+/// @brief write the buffer to the file if it is getting full or hasn't been written for a while
+/// @param [in] bool: true - write whatever is buffered now
+void TelemetryRecorder::Flush
+(
+    bool                force
+)
+{
+    if (m_file == nullptr || m_buffer.empty())
+    {
+        return;
+    }
+
+    auto now = chrono::steady_clock::now();
+    if (force || (now - m_lastFlush) > chrono::seconds(1))
+    {
+        fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        fflush(m_file);
+        m_buffer.clear();
+        m_lastFlush = now;
+    }
+}
+
+/// @brief flush and close the file; the next record starts a new file
+void TelemetryRecorder::Close()
+{
+    if (m_file != nullptr)
+    {
+        Flush(true);
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    m_openFailed = false;
+}
@@ -0,0 +1,89 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Team 302 includes
+#include <utils/LogRecord.h>
+
+/// @brief Writes LogRecords to a compact binary file (see TelemetryFormat.h).  This is only used from the 
+/// @brief logger's writer thread, so it does blocking file I/O but never on the robot loop.
+class TelemetryRecorder
+{
+    public:
+        /// @brief create the recorder; the file is opened when the first record is written
+        /// @param [in] std::string: directory for the files, empty picks the USB stick, the roboRIO or (on the 
+        /// @brief desktop) ./telemetry
+        explicit TelemetryRecorder
+        (
+            const std::string&  directory = std::string()
+        );
+        ~TelemetryRecorder();
+
+        /// @brief encode a record into the buffer, opening the file on the first one
+        /// @param [in] LogRecord: record to write
+        void Write
+        (
+            const LogRecord&    record
+        );
+
+        /// @brief write the buffer to the file if it is getting full or hasn't been written for a while
+        /// @param [in] bool: true - write whatever is buffered now
+        void Flush
+        (
+            bool                force
+        );
+
+        /// @brief flush and close the file; the next record starts a new file
+        void Close();
+
+        /// @returns std::string: path of the current (or last) file, empty if none was opened
+        const std::string& GetPath() const { return m_path; }
+
+    private:
+        struct SignalInfo
+        {
+            uint64_t    id;
+            uint64_t    previous;       // bits of the previous double or the previous int/bool value
+        };
+
+        bool Open();
+
+        SignalInfo& GetSignal
+        (
+            const LogRecord&    record
+        );
+
+        static constexpr size_t     BUFFER_SIZE = 64 * 1024;
+        static constexpr size_t     FLUSH_SIZE = 48 * 1024;
+
+        std::string                                     m_directory;
+        std::string                                     m_path;
+        std::unordered_map<std::string, SignalInfo>     m_signals;
+        std::vector<uint8_t>                            m_buffer;
+        std::FILE*                                      m_file;
+        bool                                            m_openFailed;
+        uint64_t                                        m_lastTimestamp;
+        std::chrono::steady_clock::time_point           m_lastFlush;
+};
@@ -0,0 +1,195 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cstdint>
+#include <vector>
+
+// Team 302 includes
+#include <utils/InputLogFormat.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace InputLogFormat;
+
+static InputFrame CreateFrame()
+{
+    InputFrame frame;
+    frame.timestamp = 12.345;
+    frame.cycleTime = 0.021;
+    frame.flags = FLAGS::ENABLED | FLAGS::AUTONOMOUS;
+    frame.alliance = 4;
+    frame.matchTime = 13.5;
+    frame.axisMask = ( 1ULL << 0 ) | ( 1ULL << 63 );
+    frame.axes[0] = -0.75;
+    frame.axes[63] = 0.5;
+    frame.buttonMask = 0x0F;
+    frame.buttons = 0x05;
+    frame.autonSelection = "fiveBallRight.xml";
+    for ( auto inx=0; inx<4; ++inx )
+    {
+        auto& module = frame.modules[inx];
+        module.valid = true;
+        module.driveRPS = 10.0 + inx;
+        module.driveRotations = 100.0 + inx;
+        module.turnTicks = 2048.0 * inx;
+        module.absoluteAngle = -90.0 + inx;
+        module.angle = 45.0 + inx;
+    }
+    frame.gyroValid = true;
+    frame.yaw = 179.5;
+    frame.pdpValid = true;
+    frame.batteryVoltage = 12.3;
+    frame.totalCurrent = 87.5;
+    frame.limelight.valid = true;
+    frame.limelight.hasTarget = true;
+    frame.limelight.horizontalOffset = -3.25;
+    frame.limelight.verticalOffset = 7.5;
+    frame.limelight.area = 0.8;
+    frame.limelight.targetDistance = 120.0;
+    frame.limelight.latency = 0.035;
+    frame.limelight.timestamp = 12.3;
+    frame.limelight.frameId = 300;
+    frame.motors.push_back( MotorInput{ 1, 3.5, -2.25 } );
+    frame.motors.push_back( MotorInput{ 16, -0.125, 0.0 } );
+    frame.outputs.emplace_back( 1, 0.5 );
+    frame.outputs.emplace_back( 200, -1.0 );
+    frame.executor.push_back( ExecutorSample{ 12.340, 0, 45.0, 12.3395, 0.25 } );
+    frame.executor.push_back( ExecutorSample{ 12.345, 1, -3.5, 12.3448, -0.5 } );
+    return frame;
+}
+
+static void ExpectEqual
+(
+    const InputFrame&   expected,
+    const InputFrame&   actual
+)
+{
+    EXPECT_EQ( expected.timestamp, actual.timestamp );
+    EXPECT_EQ( expected.cycleTime, actual.cycleTime );
+    EXPECT_EQ( expected.flags, actual.flags );
+    EXPECT_EQ( expected.alliance, actual.alliance );
+    EXPECT_EQ( expected.matchTime, actual.matchTime );
+    EXPECT_EQ( expected.axisMask, actual.axisMask );
+    for ( auto inx=0; inx<MAX_FUNCTIONS; ++inx )
+    {
+        EXPECT_EQ( expected.axes[inx], actual.axes[inx] );
+    }
+    EXPECT_EQ( expected.buttonMask, actual.buttonMask );
+    EXPECT_EQ( expected.buttons, actual.buttons );
+    EXPECT_EQ( expected.autonSelection, actual.autonSelection );
+    for ( auto inx=0; inx<4; ++inx )
+    {
+        EXPECT_EQ( expected.modules[inx].valid, actual.modules[inx].valid );
+        EXPECT_EQ( expected.modules[inx].driveRPS, actual.modules[inx].driveRPS );
+        EXPECT_EQ( expected.modules[inx].driveRotations, actual.modules[inx].driveRotations );
+        EXPECT_EQ( expected.modules[inx].turnTicks, actual.modules[inx].turnTicks );
+        EXPECT_EQ( expected.modules[inx].absoluteAngle, actual.modules[inx].absoluteAngle );
+        EXPECT_EQ( expected.modules[inx].angle, actual.modules[inx].angle );
+    }
+    EXPECT_EQ( expected.gyroValid, actual.gyroValid );
+    EXPECT_EQ( expected.yaw, actual.yaw );
+    EXPECT_EQ( expected.pdpValid, actual.pdpValid );
+    EXPECT_EQ( expected.batteryVoltage, actual.batteryVoltage );
+    EXPECT_EQ( expected.totalCurrent, actual.totalCurrent );
+    EXPECT_EQ( expected.limelight.valid, actual.limelight.valid );
+    EXPECT_EQ( expected.limelight.hasTarget, actual.limelight.hasTarget );
+    EXPECT_EQ( expected.limelight.horizontalOffset, actual.limelight.horizontalOffset );
+    EXPECT_EQ( expected.limelight.verticalOffset, actual.limelight.verticalOffset );
+    EXPECT_EQ( expected.limelight.area, actual.limelight.area );
+    EXPECT_EQ( expected.limelight.targetDistance, actual.limelight.targetDistance );
+    EXPECT_EQ( expected.limelight.latency, actual.limelight.latency );
+    EXPECT_EQ( expected.limelight.timestamp, actual.limelight.timestamp );
+    EXPECT_EQ( expected.limelight.frameId, actual.limelight.frameId );
+    ASSERT_EQ( expected.motors.size(), actual.motors.size() );
+    for ( size_t inx=0; inx<expected.motors.size(); ++inx )
+    {
+        EXPECT_EQ( expected.motors[inx].id, actual.motors[inx].id );
+        EXPECT_EQ( expected.motors[inx].rotations, actual.motors[inx].rotations );
+        EXPECT_EQ( expected.motors[inx].rps, actual.motors[inx].rps );
+    }
+    EXPECT_EQ( expected.outputs, actual.outputs );
+    ASSERT_EQ( expected.executor.size(), actual.executor.size() );
+    for ( size_t inx=0; inx<expected.executor.size(); ++inx )
+    {
+        EXPECT_EQ( expected.executor[inx].cycleTime, actual.executor[inx].cycleTime );
+        EXPECT_EQ( expected.executor[inx].loop, actual.executor[inx].loop );
+        EXPECT_EQ( expected.executor[inx].measurement, actual.executor[inx].measurement );
+        EXPECT_EQ( expected.executor[inx].sampleTime, actual.executor[inx].sampleTime );
+        EXPECT_EQ( expected.executor[inx].output, actual.executor[inx].output );
+    }
+}
+
+TEST( InputLogFormatTest, RoundTrip )
+{
+    auto first = CreateFrame();
+    auto second = CreateFrame();
+    second.axisMask = 0;
+    second.buttonMask = 0;
+    second.buttons = 0;
+    second.autonSelection.clear();
+    second.motors.clear();
+    second.outputs.clear();
+    second.executor.clear();
+    for ( auto& axis : second.axes )
+    {
+        axis = 0.0;
+    }
+
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> payload;
+    WriteHeader( buffer );
+    WriteFrame( buffer, payload, first );
+    WriteFrame( buffer, payload, second );
+
+    const uint8_t* pos = buffer.data();
+    const uint8_t* end = buffer.data() + buffer.size();
+    ASSERT_TRUE( ReadHeader( pos, end ) );
+
+    InputFrame frame;
+    ASSERT_TRUE( ReadFrame( pos, end, frame ) );
+    ExpectEqual( first, frame );
+    ASSERT_TRUE( ReadFrame( pos, end, frame ) );
+    ExpectEqual( second, frame );
+    EXPECT_EQ( end, pos );
+    EXPECT_FALSE( ReadFrame( pos, end, frame ) );
+}
+
+TEST( InputLogFormatTest, TruncatedFrame )
+{
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> payload;
+    WriteHeader( buffer );
+    WriteFrame( buffer, payload, CreateFrame() );
+    buffer.pop_back();
+
+    const uint8_t* pos = buffer.data();
+    const uint8_t* end = buffer.data() + buffer.size();
+    ASSERT_TRUE( ReadHeader( pos, end ) );
+    InputFrame frame;
+    EXPECT_FALSE( ReadFrame( pos, end, frame ) );
+}
+
+TEST( InputLogFormatTest, WrongHeader )
+{
+    std::vector<uint8_t> buffer;
+    WriteHeader( buffer );
+    buffer[0] = 'X';
+
+    const uint8_t* pos = buffer.data();
+    EXPECT_FALSE( ReadHeader( pos, buffer.data() + buffer.size() ) );
+}
@@ -0,0 +1,170 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+
+// Team 302 includes
+#include <mechanisms/controllers/ControlData.h>
+#include <mechanisms/controllers/ControlModes.h>
+#include <mechanisms/controllers/PIDEngine.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+static ControlData CreateGains
+(
+    double  kP,
+    double  kI,
+    double  kD,
+    double  peak
+)
+{
+    return ControlData( ControlModes::CONTROL_TYPE::POSITION_DEGREES, ControlModes::CONTROL_RUN_LOCS::ROBORIO, "test",
+                        kP, kI, kD, 0.0, 0.0, 0.0, 0.0, peak, 0.0 );
+}
+
+TEST( PIDEngineTest, IntegralScalesWithDt )
+{
+    auto gains = CreateGains( 0.0, 2.0, 0.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetMeasurement( channel, 0.0 );
+
+    EXPECT_NEAR( 1.0, engine.Update( channel, 0.5 ), 1e-9 );
+    EXPECT_NEAR( 1.5, engine.Update( channel, 0.25 ), 1e-9 );
+    EXPECT_NEAR( 1.5, engine.Update( channel, 0.0 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, AntiWindup )
+{
+    auto gains = CreateGains( 10.0, 1.0, 0.0, 1.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetMeasurement( channel, 0.0 );
+
+    // the first update isn't saturated yet, every later one is, so the integral stops at kI * error * dt
+    for ( auto inx=0; inx<100; ++inx )
+    {
+        EXPECT_LE( engine.Update( channel, 0.02 ), 1.0 );
+    }
+    EXPECT_DOUBLE_EQ( 1.0, engine.GetOutput( channel ) );
+
+    engine.SetMeasurement( channel, 1.0 );
+    EXPECT_NEAR( 0.02, engine.Update( channel, 0.02 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, IntegralClampedToOutputLimits )
+{
+    auto gains = CreateGains( 0.0, 100.0, 0.0, 1.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetMeasurement( channel, 0.0 );
+    for ( auto inx=0; inx<100; ++inx )
+    {
+        engine.Update( channel, 0.02 );
+    }
+
+    // a wound up integral would keep the output at the limit after the error changes sign
+    engine.SetMeasurement( channel, 1.1 );
+    EXPECT_NEAR( 1.0 - 100.0 * 0.1 * 0.02, engine.Update( channel, 0.02 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, DerivativeOnMeasurement )
+{
+    auto gains = CreateGains( 0.0, 0.0, 1.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetMeasurement( channel, 0.0 );
+    engine.Update( channel, 0.1 );
+
+    // a target step doesn't kick the output
+    engine.SetTarget( channel, 10.0 );
+    EXPECT_DOUBLE_EQ( 0.0, engine.Update( channel, 0.1 ) );
+
+    // the measurement moving towards the target is damped
+    engine.SetMeasurement( channel, 0.1 );
+    EXPECT_NEAR( -1.0, engine.Update( channel, 0.1 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, SlewRate )
+{
+    auto gains = CreateGains( 1.0, 0.0, 0.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetSlewRate( channel, 1.0 );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetMeasurement( channel, 0.0 );
+
+    EXPECT_NEAR( 0.1, engine.Update( channel, 0.1 ), 1e-9 );
+    EXPECT_NEAR( 0.2, engine.Update( channel, 0.1 ), 1e-9 );
+
+    engine.SetSlewRate( channel, 0.0 );
+    EXPECT_NEAR( 1.0, engine.Update( channel, 0.1 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, HotSwapGains )
+{
+    auto gains = CreateGains( 0.0, 1.0, 0.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetMeasurement( channel, 0.0 );
+    engine.Update( channel, 0.5 );
+
+    // the integral is kept as its contribution to the output, so new gains don't bump the output
+    auto newGains = CreateGains( 3.0, 10.0, 0.0, 0.0 );
+    engine.SetGains( channel, &newGains );
+    engine.SetMeasurement( channel, 1.0 );
+    EXPECT_NEAR( 0.5, engine.Update( channel, 0.02 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, SampleTimes )
+{
+    auto gains = CreateGains( 0.0, 1.0, 0.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+
+    // the first sample has nothing to measure an interval from
+    engine.SetMeasurement( channel, 0.0, 10.00 );
+    EXPECT_DOUBLE_EQ( 0.0, engine.Update( channel, 1.0 ) );
+
+    // later samples use their own interval instead of the update's dt
+    engine.SetMeasurement( channel, 0.0, 10.01 );
+    EXPECT_NEAR( 0.01, engine.Update( channel, 1.0 ), 1e-9 );
+
+    // reading the same sample again doesn't integrate
+    engine.SetMeasurement( channel, 0.0, 10.01 );
+    EXPECT_NEAR( 0.01, engine.Update( channel, 1.0 ), 1e-9 );
+}
+
+TEST( PIDEngineTest, DisabledChannel )
+{
+    auto gains = CreateGains( 1.0, 1.0, 0.0, 0.0 );
+    PIDEngine engine;
+    auto channel = engine.AddChannel( &gains );
+    auto other = engine.AddChannel( &gains );
+    engine.SetTarget( channel, 1.0 );
+    engine.SetTarget( other, 1.0 );
+    engine.SetEnabled( other, false );
+
+    engine.Update( 0.1 );
+    EXPECT_NEAR( 1.1, engine.GetOutput( channel ), 1e-9 );
+    EXPECT_DOUBLE_EQ( 0.0, engine.GetOutput( other ) );
+}
@@ -0,0 +1,312 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Linux includes
+#include <stdlib.h>
+#include <unistd.h>
+
+// Team 302 includes
+#include <utils/LogRecord.h>
+#include <utils/TelemetryFormat.h>
+#include <utils/TelemetryRecorder.h>
+
+// Third Party Includes
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/// @brief one decoded sample with the names from its SIGNAL chunk
+struct DecodedSample
+{
+    string                  group;
+    string                  identifier;
+    LogRecord::VALUE_TYPE   type;
+    uint64_t                timestamp;
+    double                  value;
+    string                  text;
+};
+
+static LogRecord CreateRecord
+(
+    const string&           group,
+    const string&           identifier,
+    LogRecord::VALUE_TYPE   type,
+    uint64_t                timestamp,
+    double                  value,
+    const string&           message
+)
+{
+    LogRecord record;
+    record.option = LOGGER_OPTION::BINARY_FILE;
+    record.type = type;
+    record.timestamp = timestamp;
+    LogRecord::CopyText( record.group, LogRecord::GROUP_SIZE, group );
+    LogRecord::CopyText( record.identifier, LogRecord::IDENTIFIER_SIZE, identifier );
+    LogRecord::CopyText( record.message, LogRecord::MESSAGE_SIZE, message );
+    record.value = value;
+    return record;
+}
+
+static bool ReadText
+(
+    const uint8_t*&     pos,
+    const uint8_t*      end,
+    string&             text
+)
+{
+    uint64_t len = 0;
+    if ( !TelemetryFormat::ReadVarint( pos, end, len ) || len > static_cast<uint64_t>( end - pos ) )
+    {
+        return false;
+    }
+    text.assign( reinterpret_cast<const char*>( pos ), len );
+    pos += len;
+    return true;
+}
+
+/// @brief decode a whole telemetry file with the TelemetryFormat primitives
+/// @returns bool: false if the header is wrong or a chunk is truncated/corrupt
+static bool Decode
+(
+    const vector<uint8_t>&  file,
+    vector<DecodedSample>&  samples
+)
+{
+    struct Signal
+    {
+        string                  group;
+        string                  identifier;
+        LogRecord::VALUE_TYPE   type;
+        uint64_t                previous;
+    };
+    vector<Signal> signals;
+
+    auto pos = file.data();
+    auto end = file.data() + file.size();
+    if ( file.size() < sizeof( TelemetryFormat::MAGIC ) + 2 || 
+         memcmp( pos, TelemetryFormat::MAGIC, sizeof( TelemetryFormat::MAGIC ) ) != 0 )
+    {
+        return false;
+    }
+    pos += sizeof( TelemetryFormat::MAGIC );
+    auto version = static_cast<uint16_t>( pos[0] | ( pos[1] << 8 ) );
+    pos += 2;
+    if ( version != TelemetryFormat::VERSION )
+    {
+        return false;
+    }
+
+    uint64_t timestamp = 0;
+    while ( pos < end )
+    {
+        auto chunk = *pos++;
+        uint64_t id = 0;
+        if ( !TelemetryFormat::ReadVarint( pos, end, id ) )
+        {
+            return false;
+        }
+        if ( chunk == TelemetryFormat::CHUNK_TYPE::SIGNAL )
+        {
+            Signal signal;
+            if ( id != signals.size() || pos >= end )
+            {
+                return false;
+            }
+            signal.type = static_cast<LogRecord::VALUE_TYPE>( *pos++ );
+            signal.previous = 0;
+            if ( !ReadText( pos, end, signal.group ) || !ReadText( pos, end, signal.identifier ) )
+            {
+                return false;
+            }
+            signals.push_back( signal );
+            continue;
+        }
+
+        uint64_t delta = 0;
+        if ( chunk != TelemetryFormat::CHUNK_TYPE::SAMPLE || id >= signals.size() ||
+             !TelemetryFormat::ReadVarint( pos, end, delta ) )
+        {
+            return false;
+        }
+        timestamp += delta;
+
+        auto& signal = signals[id];
+        DecodedSample sample{ signal.group, signal.identifier, signal.type, timestamp, 0.0, string() };
+        if ( signal.type == LogRecord::VALUE_TYPE::STRING_VALUE )
+        {
+            if ( !ReadText( pos, end, sample.text ) )
+            {
+                return false;
+            }
+        }
+        else if ( signal.type == LogRecord::VALUE_TYPE::DOUBLE_VALUE )
+        {
+            uint64_t bits = 0;
+            if ( !TelemetryFormat::ReadDoubleDelta( pos, end, signal.previous, bits ) )
+            {
+                return false;
+            }
+            signal.previous = bits;
+            sample.value = TelemetryFormat::BitsToDouble( bits );
+        }
+        else
+        {
+            uint64_t encoded = 0;
+            if ( !TelemetryFormat::ReadVarint( pos, end, encoded ) )
+            {
+                return false;
+            }
+            auto value = static_cast<int64_t>( signal.previous ) + TelemetryFormat::ZigZagDecode( encoded );
+            signal.previous = static_cast<uint64_t>( value );
+            sample.value = static_cast<double>( value );
+        }
+        samples.push_back( sample );
+    }
+    return true;
+}
+
+class TelemetryRecorderTest : public ::testing::Test
+{
+    protected:
+        void SetUp() override
+        {
+            char dir[] = "/tmp/telemetryXXXXXX";
+            ASSERT_NE( nullptr, mkdtemp( dir ) );
+            m_directory = dir;
+        }
+
+        void TearDown() override
+        {
+            if ( !m_path.empty() )
+            {
+                remove( m_path.c_str() );
+            }
+            rmdir( m_directory.c_str() );
+        }
+
+        vector<uint8_t> ReadFile()
+        {
+            ifstream in( m_path, ios::binary );
+            return vector<uint8_t>( istreambuf_iterator<char>( in ), istreambuf_iterator<char>() );
+        }
+
+        string      m_directory;
+        string      m_path;
+};
+
+TEST_F( TelemetryRecorderTest, RoundTrip )
+{
+    vector<LogRecord> records;
+    records.push_back( CreateRecord( "Drive", "speed", LogRecord::VALUE_TYPE::DOUBLE_VALUE, 1000, 1.25, "" ) );
+    records.push_back( CreateRecord( "Drive", "heading", LogRecord::VALUE_TYPE::DOUBLE_VALUE, 1000, -179.5, "" ) );
+    records.push_back( CreateRecord( "Drive", "speed", LogRecord::VALUE_TYPE::DOUBLE_VALUE, 21000, 1.2500001, "" ) );
+    records.push_back( CreateRecord( "Drive", "speed", LogRecord::VALUE_TYPE::DOUBLE_VALUE, 41000, -3.0e-9, "" ) );
+    records.push_back( CreateRecord( "Intake", "ballCount", LogRecord::VALUE_TYPE::INT_VALUE, 41000, 2.0, "" ) );
+    records.push_back( CreateRecord( "Intake", "ballCount", LogRecord::VALUE_TYPE::INT_VALUE, 61000, -40000.0, "" ) );
+    records.push_back( CreateRecord( "Intake", "extended", LogRecord::VALUE_TYPE::BOOL_VALUE, 61000, 1.0, "" ) );
+    records.push_back( CreateRecord( "Intake", "extended", LogRecord::VALUE_TYPE::BOOL_VALUE, 81000, 0.0, "" ) );
+    records.push_back( CreateRecord( "Auton", "state", LogRecord::VALUE_TYPE::STRING_VALUE, 81000, 0.0, "DRIVE_PATH" ) );
+    records.push_back( CreateRecord( "Auton", "state", LogRecord::VALUE_TYPE::STRING_VALUE, 5000000000ULL, 0.0, "" ) );
+
+    {
+        TelemetryRecorder recorder( m_directory );
+        for ( auto& record : records )
+        {
+            recorder.Write( record );
+        }
+        recorder.Close();
+        m_path = recorder.GetPath();
+    }
+    ASSERT_FALSE( m_path.empty() );
+    EXPECT_EQ( 0U, m_path.find( m_directory ) );
+
+    vector<DecodedSample> samples;
+    ASSERT_TRUE( Decode( ReadFile(), samples ) );
+    ASSERT_EQ( records.size(), samples.size() );
+    for ( size_t inx=0; inx<records.size(); ++inx )
+    {
+        auto& record = records[inx];
+        auto& sample = samples[inx];
+        EXPECT_EQ( string( record.group ), sample.group );
+        EXPECT_EQ( string( record.identifier ), sample.identifier );
+        EXPECT_EQ( record.type, sample.type );
+        EXPECT_EQ( record.timestamp, sample.timestamp );
+        if ( record.type == LogRecord::VALUE_TYPE::STRING_VALUE )
+        {
+            EXPECT_EQ( string( record.message ), sample.text );
+        }
+        else
+        {
+            EXPECT_EQ( record.value, sample.value );    // lossless, so exact
+        }
+    }
+}
+
+TEST_F( TelemetryRecorderTest, SameTypeAndNameSharesSignal )
+{
+    {
+        TelemetryRecorder recorder( m_directory );
+        for ( auto inx=0; inx<100; ++inx )
+        {
+            recorder.Write( CreateRecord( "Drive", "speed", LogRecord::VALUE_TYPE::DOUBLE_VALUE, 20000 * inx, 0.5, "" ) );
+        }
+        recorder.Close();
+        m_path = recorder.GetPath();
+    }
+
+    auto file = ReadFile();
+    vector<DecodedSample> samples;
+    ASSERT_TRUE( Decode( file, samples ) );
+    EXPECT_EQ( 100U, samples.size() );
+
+    // an unchanged double is a one byte delta, so a sample is chunk + id + time delta + 1 byte
+    EXPECT_LT( file.size(), 100U * 8U );
+}
+
+TEST_F( TelemetryRecorderTest, CorruptFilesAreRejected )
+{
+    {
+        TelemetryRecorder recorder( m_directory );
+        recorder.Write( CreateRecord( "Auton", "state", LogRecord::VALUE_TYPE::STRING_VALUE, 1000, 0.0, "DRIVE_PATH" ) );
+        recorder.Close();
+        m_path = recorder.GetPath();
+    }
+    auto file = ReadFile();
+    vector<DecodedSample> samples;
+    ASSERT_TRUE( Decode( file, samples ) );
+
+    auto truncated = file;
+    truncated.pop_back();
+    samples.clear();
+    EXPECT_FALSE( Decode( truncated, samples ) );
+
+    auto badMagic = file;
+    badMagic[0] ^= 0xFF;
+    EXPECT_FALSE( Decode( badMagic, samples ) );
+
+    auto badVersion = file;
+    badVersion[sizeof( TelemetryFormat::MAGIC )] += 1;
+    EXPECT_FALSE( Decode( badVersion, samples ) );
+}
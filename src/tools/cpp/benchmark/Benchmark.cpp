@@ -0,0 +1,169 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Team 302 includes
+#include <Benchmark.h>
+
+using namespace std;
+
+/// @brief  Register a benchmark
+void BenchmarkRunner::Add
+(
+    const string&   group,
+    const string&   name,
+    uint64_t        iterationsPerSample,
+    int             samples,
+    BenchmarkBody   body,
+    SampleSetup     setup
+)
+{
+    m_benchmarks.emplace_back( Benchmark{ group, name, max<uint64_t>( iterationsPerSample, 1 ), max( samples, 1 ), body, setup } );
+}
+
+/// @brief  Record a benchmark that couldn't run so it still shows up in the results
+void BenchmarkRunner::Skip
+(
+    const string&   group,
+    const string&   name,
+    const string&   reason
+)
+{
+    m_results.emplace_back( BenchmarkResult{ group, name, reason, 0, 0, 0.0, 0.0, 0.0, 0.0 } );
+}
+
+/// @brief  Run the registered benchmarks whose group/name contains the filter
+void BenchmarkRunner::Run
+(
+    const string&   filter
+)
+{
+    for ( auto& benchmark : m_benchmarks )
+    {
+        auto fullName = benchmark.group + string( "/" ) + benchmark.name;
+        if ( !filter.empty() && fullName.find( filter ) == string::npos )
+        {
+            continue;
+        }
+
+        // one untimed sample to warm the caches and any lazily created singletons
+        if ( benchmark.setup )
+        {
+            benchmark.setup();
+        }
+        benchmark.body( benchmark.iterationsPerSample );
+
+        vector<double> perIteration;
+        perIteration.reserve( benchmark.samples );
+        for ( auto inx=0; inx<benchmark.samples; ++inx )
+        {
+            if ( benchmark.setup )
+            {
+                benchmark.setup();
+            }
+            auto start = chrono::steady_clock::now();
+            benchmark.body( benchmark.iterationsPerSample );
+            auto elapsed = chrono::duration<double, nano>( chrono::steady_clock::now() - start );
+            perIteration.emplace_back( elapsed.count() / static_cast<double>( benchmark.iterationsPerSample ) );
+        }
+
+        double total = 0.0;
+        for ( auto ns : perIteration )
+        {
+            total += ns;
+        }
+        sort( perIteration.begin(), perIteration.end() );
+        auto percentile = [&perIteration]( double fraction ) 
+        { 
+            return perIteration[ static_cast<size_t>( fraction * ( perIteration.size() - 1 ) ) ]; 
+        };
+
+        BenchmarkResult result{ benchmark.group, 
+                                benchmark.name, 
+                                string(), 
+                                benchmark.samples, 
+                                benchmark.iterationsPerSample,
+                                total / perIteration.size(), 
+                                perIteration.front(), 
+                                percentile( 0.50 ), 
+                                percentile( 0.99 ) };
+        m_results.emplace_back( result );
+
+        fprintf( stderr, "%-60s %12.1f ns  (p50 %.1f, p99 %.1f)\n", fullName.c_str(), result.meanNs, result.p50Ns, result.p99Ns );
+    }
+}
+
+static string Escape
+(
+    const string&   text
+)
+{
+    string escaped;
+    for ( auto c : text )
+    {
+        if ( c == '"' || c == '\\' )
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+/// @brief  Write the results as JSON
+void BenchmarkRunner::WriteJson
+(
+    ostream&    out
+) const
+{
+    char timestamp[32];
+    auto now = time( nullptr );
+    strftime( timestamp, sizeof( timestamp ), "%Y-%m-%dT%H:%M:%SZ", gmtime( &now ) );
+
+    out << "{\n";
+    out << "  \"timestamp\": \"" << timestamp << "\",\n";
+    out << "  \"compiler\": \"" << Escape( __VERSION__ ) << "\",\n";
+    out << "  \"benchmarks\": [\n";
+    for ( size_t inx=0; inx<m_results.size(); ++inx )
+    {
+        const auto& result = m_results[inx];
+        out << "    { \"group\": \"" << Escape( result.group ) << "\", \"name\": \"" << Escape( result.name ) << "\"";
+        if ( !result.skipped.empty() )
+        {
+            out << ", \"skipped\": \"" << Escape( result.skipped ) << "\"";
+        }
+        else
+        {
+            out << ", \"samples\": " << result.samples;
+            out << ", \"iterationsPerSample\": " << result.iterationsPerSample;
+            out << ", \"meanNs\": " << result.meanNs;
+            out << ", \"minNs\": " << result.minNs;
+            out << ", \"p50Ns\": " << result.p50Ns;
+            out << ", \"p99Ns\": " << result.p99Ns;
+        }
+        out << " }" << ( inx + 1 < m_results.size() ? "," : "" ) << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
@@ -0,0 +1,128 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+//========================================================================================================
+/// Benchmark.h
+//========================================================================================================
+///
+/// File Description:
+///     Minimal benchmark harness for the robot code benchmarks.  Each benchmark body is timed in samples
+///     of a fixed number of iterations; the per-iteration times of the samples give the mean, min, p50
+///     and p99 that are written out as JSON so runs can be compared.
+///
+//========================================================================================================
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// @brief Keep the compiler from optimizing away a value the benchmark computes
+template <typename T>
+inline void DoNotOptimize
+(
+    const T&    value
+)
+{
+    asm volatile( "" : : "r,m"( value ) : "memory" );
+}
+
+struct BenchmarkResult
+{
+    std::string     group;
+    std::string     name;
+    std::string     skipped;                // reason the benchmark didn't run (empty if it ran)
+    int             samples;
+    uint64_t        iterationsPerSample;
+    double          meanNs;                 // per iteration
+    double          minNs;
+    double          p50Ns;
+    double          p99Ns;
+};
+
+class BenchmarkRunner
+{
+    public:
+        /// @brief body runs the code under test the given number of times
+        using BenchmarkBody = std::function<void( uint64_t iterations )>;
+
+        /// @brief untimed work done before every sample (e.g. emptying a queue the body fills)
+        using SampleSetup = std::function<void()>;
+
+        BenchmarkRunner() = default;
+        ~BenchmarkRunner() = default;
+
+        /// @brief  Register a benchmark
+        /// @param [in] const std::string&  group:                  what is being measured (e.g. kinematics)
+        /// @param [in] const std::string&  name:                   benchmark name
+        /// @param [in] uint64_t            iterationsPerSample:    calls timed together in one sample
+        /// @param [in] int                 samples:                number of samples
+        /// @param [in] BenchmarkBody       body:                   code under test
+        /// @param [in] SampleSetup         setup:                  untimed work before each sample (optional)
+        void Add
+        (
+            const std::string&  group,
+            const std::string&  name,
+            uint64_t            iterationsPerSample,
+            int                 samples,
+            BenchmarkBody       body,
+            SampleSetup         setup = SampleSetup()
+        );
+
+        /// @brief  Record a benchmark that couldn't run so it still shows up in the results
+        /// @param [in] const std::string&  group:      what is being measured
+        /// @param [in] const std::string&  name:       benchmark name
+        /// @param [in] const std::string&  reason:     why it was skipped
+        void Skip
+        (
+            const std::string&  group,
+            const std::string&  name,
+            const std::string&  reason
+        );
+
+        /// @brief  Run the registered benchmarks whose group/name contains the filter
+        /// @param [in] const std::string&  filter:     substring to match (empty runs everything)
+        void Run
+        (
+            const std::string&  filter
+        );
+
+        /// @brief  Write the results as JSON
+        /// @param [in] std::ostream&   out:    where to write
+        void WriteJson
+        (
+            std::ostream&       out
+        ) const;
+
+        const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+    private:
+        struct Benchmark
+        {
+            std::string     group;
+            std::string     name;
+            uint64_t        iterationsPerSample;
+            int             samples;
+            BenchmarkBody   body;
+            SampleSetup     setup;
+        };
+
+        std::vector<Benchmark>          m_benchmarks;
+        std::vector<BenchmarkResult>    m_results;
+};
@@ -0,0 +1,392 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+//========================================================================================================
+/// RobotBenchmarks.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Desktop microbenchmarks for the robot control path.  Run it from the repository root so the
+///     deploy directory (src/main/deploy) resolves the same way it does in simulation:
+///
+///     robotBenchmarks [--filter <text>] [--out <file.json> | --out -]
+///
+///     Results are written as JSON (benchmark.json by default; "-" writes to stdout) and a one line 
+///     summary per benchmark goes to stderr.  Use the release build; debug timings are not meaningful.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/Filesystem.h>
+#include <frc/geometry/Pose2d.h>
+#include <frc/geometry/Rotation2d.h>
+#include <frc/geometry/Translation2d.h>
+#include <frc/kinematics/ChassisSpeeds.h>
+#include <frc/kinematics/SwerveDriveKinematics.h>
+#include <frc/kinematics/SwerveModuleState.h>
+#include <hal/HAL.h>
+#include <units/angle.h>
+#include <units/angular_velocity.h>
+#include <units/length.h>
+#include <units/velocity.h>
+
+// Team 302 includes
+#include <Benchmark.h>
+#include <RobotXmlParser.h>
+#include <chassis/ChassisFactory.h>
+#include <chassis/DragonTargetFinder.h>
+#include <chassis/swerve/EtherDirtySwerve.h>
+#include <chassis/swerve/SwerveChassis.h>
+#include <chassis/swerve/SwerveModule.h>
+#include <mechanisms/controllers/StateDataXmlParser.h>
+#include <utils/AngleUtils.h>
+#include <utils/Logger.h>
+#include <utils/LoggerEnums.h>
+
+// Third Party Includes
+#include <pugixml/pugixml.hpp>
+
+using namespace std;
+using namespace frc;
+
+// inputs are cycled through a table so the branchy code paths see realistic variety
+static constexpr size_t NUM_INPUTS = 64;
+
+static const vector<string> ROBOT_FILES = { "robot.xml", "robotcompbot.xml", "robotpracticebot.xml", "robotswervechassis.xml" };
+
+static vector<ChassisSpeeds> CreateSpeeds()
+{
+    vector<ChassisSpeeds> speeds;
+    for ( size_t inx=0; inx<NUM_INPUTS; ++inx )
+    {
+        double scale = ( static_cast<double>( inx ) / NUM_INPUTS ) * 2.0 - 1.0;
+        speeds.emplace_back( ChassisSpeeds{ units::velocity::meters_per_second_t( 4.0 * scale ),
+                                            units::velocity::meters_per_second_t( 2.5 * scale * scale - 1.0 ),
+                                            units::angular_velocity::radians_per_second_t( 6.0 * scale * ( inx % 3 ) ) } );
+    }
+    return speeds;
+}
+
+static vector<units::angle::degree_t> CreateAngles()
+{
+    vector<units::angle::degree_t> angles;
+    for ( size_t inx=0; inx<NUM_INPUTS; ++inx )
+    {
+        angles.emplace_back( units::angle::degree_t( -540.0 + 1080.0 * static_cast<double>( inx ) / NUM_INPUTS ) );
+    }
+    return angles;
+}
+
+static vector<Pose2d> CreatePoses()
+{
+    vector<Pose2d> poses;
+    for ( size_t inx=0; inx<NUM_INPUTS; ++inx )
+    {
+        double fraction = static_cast<double>( inx ) / NUM_INPUTS;
+        poses.emplace_back( Pose2d( units::length::meter_t( 16.0 * fraction ), 
+                                    units::length::meter_t( 8.0 * ( 1.0 - fraction ) ), 
+                                    Rotation2d( units::angle::degree_t( 360.0 * fraction - 180.0 ) ) ) );
+    }
+    return poses;
+}
+
+static void AddKinematicsBenchmarks
+(
+    BenchmarkRunner&    runner
+)
+{
+    // geometry of robotswervechassis.xml
+    units::length::meter_t wheelBase = units::length::inch_t( 22.75 );
+    units::length::meter_t track = units::length::inch_t( 22.75 );
+    auto maxSpeed = units::velocity::meters_per_second_t( 4.5 );
+    auto speeds = make_shared<vector<ChassisSpeeds>>( CreateSpeeds() );
+
+    auto ether = make_shared<EtherDirtySwerve>( wheelBase, track, maxSpeed );
+    runner.Add( "kinematics", "EtherDirtySwerve::CalcModuleStates", 10000, 50, [ether, speeds]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            DoNotOptimize( ether->CalcModuleStates( (*speeds)[inx % NUM_INPUTS] ) );
+        }
+    } );
+
+    auto kinematics = make_shared<SwerveDriveKinematics<4>>( Translation2d( wheelBase/2.0, track/2.0 ),
+                                                             Translation2d( wheelBase/2.0, -1.0*track/2.0 ),
+                                                             Translation2d( -1.0*wheelBase/2.0, track/2.0 ),
+                                                             Translation2d( -1.0*wheelBase/2.0, -1.0*track/2.0 ) );
+    runner.Add( "kinematics", "SwerveDriveKinematics::ToSwerveModuleStates", 10000, 50, [kinematics, speeds, maxSpeed]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            auto states = kinematics->ToSwerveModuleStates( (*speeds)[inx % NUM_INPUTS] );
+            SwerveDriveKinematics<4>::DesaturateWheelSpeeds( &states, maxSpeed );
+            DoNotOptimize( states );
+        }
+    } );
+}
+
+static void AddAngleBenchmarks
+(
+    BenchmarkRunner&    runner
+)
+{
+    auto angles = make_shared<vector<units::angle::degree_t>>( CreateAngles() );
+    runner.Add( "angles", "AngleUtils::GetDeltaAngle", 100000, 50, [angles]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            DoNotOptimize( AngleUtils::GetDeltaAngle( (*angles)[inx % NUM_INPUTS], (*angles)[( inx * 7 ) % NUM_INPUTS] ) );
+        }
+    } );
+    runner.Add( "angles", "AngleUtils::GetEquivAngle", 100000, 50, [angles]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            DoNotOptimize( AngleUtils::GetEquivAngle( (*angles)[inx % NUM_INPUTS] ) );
+        }
+    } );
+
+    auto poses = make_shared<vector<Pose2d>>( CreatePoses() );
+    auto finder = make_shared<DragonTargetFinder>();
+    runner.Add( "angles", "DragonTargetFinder::GetAngle2Target", 100000, 50, [finder, poses]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            DoNotOptimize( finder->GetAngle2Target( (*poses)[inx % NUM_INPUTS] ) );
+        }
+    } );
+}
+
+/// @brief  Reaches SwerveModule's private Optimize (SwerveModule declares this a friend)
+struct SwerveModuleBenchmark
+{
+    static SwerveModuleState Optimize
+    (
+        SwerveModule*               module,
+        const SwerveModuleState&    desiredState,
+        const Rotation2d&           currentAngle
+    )
+    {
+        return module->Optimize( desiredState, currentAngle );
+    }
+};
+
+/// @brief  SwerveModule needs its motors and CANCoder, so this uses the front left module of the chassis 
+///         built from robot.xml
+static void AddSwerveModuleBenchmarks
+(
+    BenchmarkRunner&    runner
+)
+{
+    auto factory = ChassisFactory::GetChassisFactory();
+    auto chassis = factory->GetIChassis();
+    if ( chassis == nullptr || chassis->GetType() != IChassis::CHASSIS_TYPE::SWERVE )
+    {
+        runner.Skip( "swerve", "SwerveModule::Optimize", "robot.xml doesn't define a swerve chassis" );
+        return;
+    }
+
+    auto module = factory->GetSwerveChassis()->GetFrontLeft();
+    auto speeds = make_shared<vector<ChassisSpeeds>>( CreateSpeeds() );
+    auto angles = make_shared<vector<units::angle::degree_t>>( CreateAngles() );
+    runner.Add( "swerve", "SwerveModule::Optimize", 10000, 50, [module, speeds, angles]( uint64_t iterations )
+    {
+        for ( uint64_t inx=0; inx<iterations; ++inx )
+        {
+            const auto& speed = (*speeds)[inx % NUM_INPUTS];
+            SwerveModuleState desired{ speed.vx, Rotation2d( (*angles)[( inx * 5 ) % NUM_INPUTS] ) };
+            DoNotOptimize( SwerveModuleBenchmark::Optimize( module.get(), desired, Rotation2d( (*angles)[inx % NUM_INPUTS] ) ) );
+        }
+    } );
+}
+
+static void AddLoggerBenchmarks
+(
+    BenchmarkRunner&    runner
+)
+{
+    const vector<pair<LOGGER_OPTION, string>> options = { { LOGGER_OPTION::CONSOLE, "CONSOLE" },
+                                                          { LOGGER_OPTION::DASHBOARD, "DASHBOARD" },
+                                                          { LOGGER_OPTION::BINARY_FILE, "BINARY_FILE" },
+                                                          { LOGGER_OPTION::EAT_IT, "EAT_IT" } };
+    // each sample has to fit in the logging thread's queues (512 display, 2048 telemetry records) and the
+    // writer empties them between samples; otherwise the samples mostly time the cheap full-queue drop
+    auto drain = []() { Logger::GetLogger()->Drain(); };
+    for ( auto& option : options )
+    {
+        auto loggerOption = option.first;
+        runner.Add( "logger", string( "Logger::LogData double " ) + option.second, 256, 50, [loggerOption]( uint64_t iterations )
+        {
+            auto logger = Logger::GetLogger();
+            logger->SetLoggingOption( loggerOption );
+            logger->SetLoggingLevel( LOGGER_LEVEL::PRINT );
+            for ( uint64_t inx=0; inx<iterations; ++inx )
+            {
+                logger->LogData( LOGGER_LEVEL::PRINT, string( "Benchmark" ), string( "value" ), static_cast<double>( inx ) );
+            }
+        }, drain );
+        runner.Add( "logger", string( "LOG_DATA double " ) + option.second, 256, 50, [loggerOption]( uint64_t iterations )
+        {
+            auto logger = Logger::GetLogger();
+            logger->SetLoggingOption( loggerOption );
+            logger->SetLoggingLevel( LOGGER_LEVEL::PRINT );
+            for ( uint64_t inx=0; inx<iterations; ++inx )
+            {
+                LOG_DATA( LOGGER_LEVEL::PRINT, string( "Benchmark" ), string( "value" ), static_cast<double>( inx ) );
+            }
+        }, drain );
+    }
+    Logger::GetLogger()->SetLoggingOption( LOGGER_OPTION::EAT_IT );
+}
+
+static void AddXmlBenchmarks
+(
+    BenchmarkRunner&    runner
+)
+{
+    auto deployDir = frc::filesystem::GetDeployDirectory();
+    for ( auto& file : ROBOT_FILES )
+    {
+        auto filename = deployDir + string( "/" ) + file;
+        runner.Add( "xml", string( "pugixml load " ) + file, 10, 10, [filename]( uint64_t iterations )
+        {
+            for ( uint64_t inx=0; inx<iterations; ++inx )
+            {
+                pugi::xml_document doc;
+                DoNotOptimize( doc.load_file( filename.c_str() ) );
+            }
+        } );
+
+        // RobotXmlParser would create the hardware again (duplicate CAN ids, config queue workers and
+        // CAN frame budget entries), so only the load plus the attribute walk the parsers do is measured
+        runner.Add( "xml", string( "pugixml load and walk " ) + file, 10, 10, [filename]( uint64_t iterations )
+        {
+            for ( uint64_t inx=0; inx<iterations; ++inx )
+            {
+                pugi::xml_document doc;
+                doc.load_file( filename.c_str() );
+                size_t count = 0;
+                for ( auto node : doc.select_nodes( "//*" ) )
+                {
+                    for ( auto attr : node.node().attributes() )
+                    {
+                        count += strlen( attr.value() );
+                    }
+                }
+                DoNotOptimize( count );
+            }
+        } );
+    }
+
+    // the state files are parsed directly, so they are measured whether or not robot.xml creates the mechanisms
+    auto hasStates = false;
+    std::error_code error;
+    for ( auto& entry : std::filesystem::directory_iterator( deployDir + string( "/states" ), error ) )
+    {
+        if ( entry.path().extension() != ".xml" )
+        {
+            continue;
+        }
+        hasStates = true;
+        auto filename = entry.path().string();
+        runner.Add( "xml", string( "StateDataXmlParser " ) + entry.path().filename().string(), 1, 10, [filename]( uint64_t iterations )
+        {
+            for ( uint64_t inx=0; inx<iterations; ++inx )
+            {
+                StateDataXmlParser parser;
+                vector<StateTransitionData> transitions;
+                auto targets = parser.ParseFile( filename, transitions );
+                DoNotOptimize( targets );
+                for ( auto target : targets )
+                {
+                    delete target;
+                }
+            }
+        } );
+    }
+    if ( !hasStates )
+    {
+        runner.Skip( "xml", "StateDataXmlParser", "no state files in the deploy directory" );
+    }
+}
+
+int main
+(
+    int     argc,
+    char**  argv
+)
+{
+    string filter;
+    string outFile( "benchmark.json" );
+    for ( auto inx=1; inx<argc; ++inx )
+    {
+        if ( strcmp( argv[inx], "--filter" ) == 0 && inx+1 < argc )
+        {
+            filter = argv[++inx];
+        }
+        else if ( strcmp( argv[inx], "--out" ) == 0 && inx+1 < argc )
+        {
+            outFile = argv[++inx];
+        }
+        else
+        {
+            cerr << "usage: robotBenchmarks [--filter <text>] [--out <file.json> | --out -]" << endl;
+            return 1;
+        }
+    }
+
+    HAL_Initialize( 500, 0 );
+
+    // keep logging out of the way of the hot path measurements (the logger benchmarks set their own option)
+    Logger::GetLogger()->SetLoggingOption( LOGGER_OPTION::EAT_IT );
+
+    // build the robot once so the benchmarks that need hardware objects have them
+    RobotXmlParser parser;
+    parser.ParseXML();
+
+    BenchmarkRunner runner;
+    AddKinematicsBenchmarks( runner );
+    AddAngleBenchmarks( runner );
+    AddSwerveModuleBenchmarks( runner );
+    AddXmlBenchmarks( runner );
+    AddLoggerBenchmarks( runner );
+    runner.Run( filter );
+
+    if ( outFile == "-" )
+    {
+        runner.WriteJson( cout );
+    }
+    else
+    {
+        ofstream out( outFile );
+        if ( !out )
+        {
+            cerr << "unable to write " << outFile << endl;
+            return 1;
+        }
+        runner.WriteJson( out );
+    }
+    return 0;
+}
@@ -0,0 +1,428 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+//========================================================================================================
+/// InputReplay.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Replays an InputRecorder log (inputs_*.t302in from /u/inputs or /home/lvuser/inputs) through 
+///     Robot on the simulation HAL with a paused clock that is stepped to each recorded loop, so it runs 
+///     as fast as the loops execute.  Every loop gets the recorded driver inputs, driver station state, 
+///     sensor snapshot and auton selection, and the motor commands it produces are compared with the 
+///     recorded ones.  The RioControlExecutor and the odometry thread don't run on their notifiers; they 
+///     are stepped on this thread with the clock: the executor once per recorded cycle (on the recorded 
+///     sensor samples, and its outputs are compared per loop too) and odometry at its period.  Run it 
+///     from the repository root so the deploy directory resolves:
+///
+///     inputReplay <file> [--tolerance <value>] [--until <frame>] [--report <count>]
+///
+///     --until stops after that frame, e.g. to look at a loop that overran under a profiler or debugger
+///     (build with enableLoopProfiler for the per-phase timings).  The exit code is 1 if any loop's 
+///     (or executor cycle's) commands differ.
+///
+//========================================================================================================
+
+// C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// FRC includes
+#include <frc/Timer.h>
+#include <frc/simulation/DriverStationSim.h>
+#include <frc/simulation/SimHooks.h>
+#include <hal/DriverStationTypes.h>
+#include <hal/HAL.h>
+#include <units/time.h>
+
+// Team 302 includes
+#include <Robot.h>
+#include <chassis/ChassisFactory.h>
+#include <chassis/IChassis.h>
+#include <chassis/swerve/SwerveChassis.h>
+#include <mechanisms/controllers/RioControlExecutor.h>
+#include <utils/InputLogFormat.h>
+#include <utils/InputRecorder.h>
+#include <utils/Logger.h>
+#include <utils/LoggerEnums.h>
+
+// Third Party Includes
+
+using namespace std;
+using namespace InputLogFormat;
+
+static constexpr double LOOP_PERIOD = 0.02;     // seconds
+
+/// @brief  Robot with its loop exposed so the replay can run one loop per recorded frame
+class ReplayRobot : public Robot
+{
+    public:
+        void RunLoop() 
+        { 
+            LoopFunc(); 
+        }
+};
+
+struct LoopResult
+{
+    size_t      frame;
+    double      recordedTime;       // seconds since the previous recorded loop ended
+    double      replayTime;         // seconds the replayed loop took
+};
+
+static bool ReadFrames
+(
+    const string&           fileName,
+    vector<InputFrame>&     frames
+)
+{
+    ifstream in( fileName, ios::binary );
+    if ( !in )
+    {
+        cerr << "unable to read " << fileName << endl;
+        return false;
+    }
+    vector<uint8_t> buffer( ( istreambuf_iterator<char>( in ) ), istreambuf_iterator<char>() );
+
+    const uint8_t* pos = buffer.data();
+    const uint8_t* end = pos + buffer.size();
+    if ( !ReadHeader( pos, end ) )
+    {
+        cerr << fileName << " isn't a version " << VERSION << " input log" << endl;
+        return false;
+    }
+
+    while ( pos < end )
+    {
+        InputFrame frame;
+        if ( !ReadFrame( pos, end, frame ) )
+        {
+            // the robot was probably turned off mid write; replay what is complete
+            cerr << "log ends with a partial frame after " << frames.size() << " frames" << endl;
+            break;
+        }
+        frames.emplace_back( std::move( frame ) );
+    }
+    return true;
+}
+
+/// @brief  Set the simulated driver station to the recorded state
+static void SetDriverStation
+(
+    const InputFrame&       frame
+)
+{
+    frc::sim::DriverStationSim::SetEnabled( ( frame.flags & FLAGS::ENABLED ) != 0 );
+    frc::sim::DriverStationSim::SetAutonomous( ( frame.flags & FLAGS::AUTONOMOUS ) != 0 );
+    frc::sim::DriverStationSim::SetTest( ( frame.flags & FLAGS::TEST ) != 0 );
+    frc::sim::DriverStationSim::SetDsAttached( ( frame.flags & FLAGS::DS_ATTACHED ) != 0 );
+    frc::sim::DriverStationSim::SetAllianceStationId( static_cast<HAL_AllianceStationID>( frame.alliance ) );
+    frc::sim::DriverStationSim::SetMatchTime( frame.matchTime );
+    frc::sim::DriverStationSim::NotifyNewData();
+}
+
+/// @return string - empty if the commands match, otherwise the first difference
+static string CompareOutputs
+(
+    const vector<pair<int, double>>&    recorded,
+    const vector<pair<int, double>>&    replayed,
+    double                              tolerance
+)
+{
+    auto count = min( recorded.size(), replayed.size() );
+    for ( size_t inx=0; inx<count; ++inx )
+    {
+        if ( recorded[inx].first != replayed[inx].first || abs( recorded[inx].second - replayed[inx].second ) > tolerance )
+        {
+            return string( "command " ) + to_string( inx ) + 
+                   string( ": recorded motor " ) + to_string( recorded[inx].first ) + string( " = " ) + to_string( recorded[inx].second ) +
+                   string( ", replayed motor " ) + to_string( replayed[inx].first ) + string( " = " ) + to_string( replayed[inx].second );
+        }
+    }
+    if ( recorded.size() != replayed.size() )
+    {
+        return string( "recorded " ) + to_string( recorded.size() ) + string( " commands, replayed " ) + to_string( replayed.size() );
+    }
+    return string();
+}
+
+/// @return string - empty if the executor outputs match, otherwise the first difference
+static string CompareExecutor
+(
+    const vector<ExecutorSample>&       recorded,
+    const vector<ExecutorSample>&       replayed,
+    double                              tolerance
+)
+{
+    auto count = min( recorded.size(), replayed.size() );
+    for ( size_t inx=0; inx<count; ++inx )
+    {
+        if ( recorded[inx].loop != replayed[inx].loop || abs( recorded[inx].output - replayed[inx].output ) > tolerance )
+        {
+            return string( "executor sample " ) + to_string( inx ) + 
+                   string( ": recorded loop " ) + to_string( recorded[inx].loop ) + string( " = " ) + to_string( recorded[inx].output ) +
+                   string( ", replayed loop " ) + to_string( replayed[inx].loop ) + string( " = " ) + to_string( replayed[inx].output );
+        }
+    }
+    if ( recorded.size() != replayed.size() )
+    {
+        return string( "recorded " ) + to_string( recorded.size() ) + string( " executor samples, replayed " ) + to_string( replayed.size() );
+    }
+    return string();
+}
+
+/// @brief  Steps the paused clock, running the odometry cycles that fall due on the way
+class ReplayClock
+{
+    public:
+        explicit ReplayClock
+        (
+            SwerveChassis*      chassis
+        ) : m_chassis( chassis ),
+            m_nextOdometry( 0.0 )
+        {
+        }
+
+        void AdvanceTo
+        (
+            double              time
+        )
+        {
+            auto period = m_chassis != nullptr ? units::time::second_t( m_chassis->GetOdometryPeriod() ).to<double>() : 0.0;
+            if ( period > 0.0 )
+            {
+                if ( m_nextOdometry <= 0.0 )
+                {
+                    m_nextOdometry = Now() + period;
+                }
+                while ( m_nextOdometry <= time )
+                {
+                    Step( m_nextOdometry );
+                    m_chassis->StepOdometry();
+                    m_nextOdometry += period;
+                }
+            }
+            Step( time );
+        }
+
+    private:
+        static double Now()
+        {
+            return frc::Timer::GetFPGATimestamp().to<double>();
+        }
+
+        static void Step
+        (
+            double              time
+        )
+        {
+            auto now = Now();
+            if ( time > now )
+            {
+                frc::sim::StepTiming( units::time::second_t( time - now ) );
+            }
+        }
+
+        SwerveChassis*      m_chassis;
+        double              m_nextOdometry;
+};
+
+/// @brief  Run the recorded executor cycles [next, ...) that started by the given time, one Step per cycle
+/// @return size_t - index of the first sample not run
+static size_t RunExecutorCycles
+(
+    const InputFrame&       frame,
+    size_t                  next,
+    double                  until,
+    ReplayClock&            clock
+)
+{
+    auto executor = RioControlExecutor::GetInstance();
+    auto recorder = InputRecorder::GetInstance();
+    while ( next < frame.executor.size() && frame.executor[next].cycleTime <= until )
+    {
+        auto cycleTime = frame.executor[next].cycleTime;
+        auto end = next;
+        while ( end < frame.executor.size() && frame.executor[end].cycleTime == cycleTime )
+        {
+            ++end;
+        }
+        clock.AdvanceTo( cycleTime );
+        recorder->SetReplayExecutorCycle( next, end );
+        executor->Step();
+        next = end;
+    }
+    recorder->SetReplayExecutorCycle( 0, 0 );
+    return next;
+}
+
+static void PrintLoops
+(
+    const string&           title,
+    vector<LoopResult>      loops,
+    bool                    byRecordedTime,
+    size_t                  count
+)
+{
+    sort( loops.begin(), loops.end(), [byRecordedTime]( const LoopResult& a, const LoopResult& b )
+    {
+        return byRecordedTime ? a.recordedTime > b.recordedTime : a.replayTime > b.replayTime;
+    } );
+
+    cout << title << endl;
+    for ( size_t inx=0; inx<loops.size() && inx<count; ++inx )
+    {
+        cout << "    frame " << loops[inx].frame 
+             << "  recorded " << loops[inx].recordedTime * 1000.0 << " ms"
+             << "  replayed " << loops[inx].replayTime * 1000.0 << " ms" << endl;
+    }
+}
+
+int main
+(
+    int     argc,
+    char**  argv
+)
+{
+    string fileName;
+    double tolerance = 1e-9;
+    size_t until = SIZE_MAX;
+    size_t reportCount = 10;
+    for ( auto inx=1; inx<argc; ++inx )
+    {
+        if ( strcmp( argv[inx], "--tolerance" ) == 0 && inx+1 < argc )
+        {
+            tolerance = atof( argv[++inx] );
+        }
+        else if ( strcmp( argv[inx], "--until" ) == 0 && inx+1 < argc )
+        {
+            until = strtoull( argv[++inx], nullptr, 10 );
+        }
+        else if ( strcmp( argv[inx], "--report" ) == 0 && inx+1 < argc )
+        {
+            reportCount = strtoull( argv[++inx], nullptr, 10 );
+        }
+        else if ( fileName.empty() && argv[inx][0] != '-' )
+        {
+            fileName = argv[inx];
+        }
+        else
+        {
+            fileName.clear();
+            break;
+        }
+    }
+    if ( fileName.empty() )
+    {
+        cerr << "usage: inputReplay <file> [--tolerance <value>] [--until <frame>] [--report <count>]" << endl;
+        return 1;
+    }
+
+    vector<InputFrame> frames;
+    if ( !ReadFrames( fileName, frames ) || frames.empty() )
+    {
+        return 1;
+    }
+
+    HAL_Initialize( 500, 0 );
+    frc::sim::PauseTiming();
+    Logger::GetLogger()->SetLoggingOption( LOGGER_OPTION::EAT_IT );
+
+    // the executor and odometry threads would run against the stepped clock at random points; step them here
+    RioControlExecutor::GetInstance()->SetStepped();
+
+    ReplayRobot robot;
+    robot.RobotInit();
+    robot.SimulationInit();
+
+    SwerveChassis* swerve = nullptr;
+    auto chassis = ChassisFactory::GetChassisFactory()->GetIChassis();
+    if ( chassis != nullptr && chassis->GetType() == IChassis::CHASSIS_TYPE::SWERVE )
+    {
+        swerve = ChassisFactory::GetChassisFactory()->GetSwerveChassis();
+        swerve->SetOdometryStepped();
+    }
+    ReplayClock clock( swerve );
+
+    auto recorder = InputRecorder::GetInstance();
+    recorder->StartReplay();
+
+    vector<LoopResult> loops;
+    loops.reserve( frames.size() );
+    size_t mismatches = 0;
+    auto wallStart = chrono::steady_clock::now();
+    for ( size_t inx=0; inx<frames.size() && inx<=until; ++inx )
+    {
+        const auto& frame = frames[inx];
+        SetDriverStation( frame );
+        recorder->SetReplayFrame( &frame );
+
+        // the executor cycles recorded with this loop ran before it started or while it ran; move the virtual 
+        // clock through them to the recorded loop so timers and timestamps match the match
+        auto nextCycle = RunExecutorCycles( frame, 0, frame.timestamp, clock );
+        clock.AdvanceTo( frame.timestamp );
+
+        auto loopStart = chrono::steady_clock::now();
+        robot.RunLoop();
+        auto replayTime = chrono::duration<double>( chrono::steady_clock::now() - loopStart ).count();
+        loops.emplace_back( LoopResult{ inx, frame.cycleTime, replayTime } );
+
+        RunExecutorCycles( frame, nextCycle, numeric_limits<double>::max(), clock );
+
+        auto difference = CompareOutputs( frame.outputs, recorder->GetReplayedOutputs(), tolerance );
+        if ( difference.empty() )
+        {
+            difference = CompareExecutor( frame.executor, recorder->GetReplayedExecutor(), tolerance );
+        }
+        if ( !difference.empty() )
+        {
+            if ( mismatches < reportCount )
+            {
+                cout << "frame " << inx << " differs: " << difference << endl;
+            }
+            ++mismatches;
+        }
+    }
+    auto wallTime = chrono::duration<double>( chrono::steady_clock::now() - wallStart ).count();
+
+    auto recordedSpan = loops.empty() ? 0.0 : frames[loops.back().frame].timestamp - frames.front().timestamp;
+    cout << "replayed " << loops.size() << " of " << frames.size() << " loops: " 
+         << recordedSpan << " s recorded in " << wallTime << " s"; 
+    if ( wallTime > 0.0 )
+    {
+        cout << " (" << recordedSpan / wallTime << "x real time)";
+    }
+    cout << endl;
+    cout << mismatches << " loops with different motor commands or executor outputs" << endl;
+
+    auto overruns = count_if( loops.begin(), loops.end(), []( const LoopResult& loop ) { return loop.recordedTime > LOOP_PERIOD * 1.1; } );
+    cout << overruns << " recorded loops longer than " << LOOP_PERIOD * 1000.0 << " ms" << endl;
+    PrintLoops( "longest recorded loops:", loops, true, reportCount );
+    PrintLoops( "slowest replayed loops:", loops, false, reportCount );
+
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+// C++ Includes
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// Team 302 includes
+#include <utils/TelemetryFormat.h>
+#include <TelemetryReader.h>
+
+using namespace std;
+
+TelemetryReader::TelemetryReader() : m_data(),
+                                     m_pos(nullptr),
+                                     m_end(nullptr),
+                                     m_signals(),
+                                     m_timestamp(0),
+                                     m_error(false),
+                                     m_errorMsg()
+{
+}
+
+/// @brief read the file and check its header
+/// @param [in] std::string: path of the .t302 file
+/// @returns bool: true if the file is a telemetry file this reader understands
+bool TelemetryReader::Open
+(
+    const string&       path
+)
+{
+    ifstream file(path, ios::binary);
+    if (!file)
+    {
+        return Fail(string("can't open ") + path);
+    }
+    m_data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    m_pos = m_data.data();
+    m_end = m_pos + m_data.size();
+    m_signals.clear();
+    m_timestamp = 0;
+    m_error = false;
+
+    if (m_data.size() < sizeof(TelemetryFormat::MAGIC) + 2 || 
+        memcmp(m_pos, TelemetryFormat::MAGIC, sizeof(TelemetryFormat::MAGIC)) != 0)
+    {
+        return Fail(string("not a telemetry file"));
+    }
+    m_pos += sizeof(TelemetryFormat::MAGIC);
+    auto version = static_cast<uint16_t>(m_pos[0] | (m_pos[1] << 8));
+    m_pos += 2;
+    if (version != TelemetryFormat::VERSION)
+    {
+        return Fail(string("unsupported version ") + to_string(version));
+    }
+    return true;
+}
+
+/// @brief decode the next sample; signal definitions are picked up along the way
+/// @param [out] TelemetrySample: decoded sample
+/// @returns bool: false at the end of the file or if the file is corrupt (see HasError)
+bool TelemetryReader::Next
+(
+    TelemetrySample&    sample
+)
+{
+    while (!m_error && m_pos < m_end)
+    {
+        auto chunk = *m_pos++;
+        if (chunk == TelemetryFormat::CHUNK_TYPE::SIGNAL)
+        {
+            if (!ReadSignal())
+            {
+                return false;
+            }
+            continue;
+        }
+        if (chunk != TelemetryFormat::CHUNK_TYPE::SAMPLE)
+        {
+            return Fail(string("unknown chunk type ") + to_string(chunk));
+        }
+
+        uint64_t id = 0;
+        uint64_t delta = 0;
+        if (!TelemetryFormat::ReadVarint(m_pos, m_end, id) || !TelemetryFormat::ReadVarint(m_pos, m_end, delta))
+        {
+            return Fail(string("truncated sample"));
+        }
+        if (id >= m_signals.size())
+        {
+            return Fail(string("sample for undefined signal ") + to_string(id));
+        }
+        m_timestamp += delta;
+
+        auto& signal = m_signals[id];
+        sample.signalId = id;
+        sample.timestamp = m_timestamp;
+        sample.value = 0.0;
+        sample.text.clear();
+        switch (signal.type)
+        {
+            case TelemetryFormat::SIGNAL_TYPE::STRING_SIGNAL:
+                if (!ReadString(sample.text))
+                {
+                    return false;
+                }
+                break;
+
+            case TelemetryFormat::SIGNAL_TYPE::DOUBLE_SIGNAL:
+            {
+                uint64_t bits = 0;
+                if (!TelemetryFormat::ReadDoubleDelta(m_pos, m_end, signal.previous, bits))
+                {
+                    return Fail(string("truncated double"));
+                }
+                signal.previous = bits;
+                sample.value = TelemetryFormat::BitsToDouble(bits);
+            }
+            break;
+
+            default:    // BOOL_SIGNAL and INT_SIGNAL
+            {
+                uint64_t encoded = 0;
+                if (!TelemetryFormat::ReadVarint(m_pos, m_end, encoded))
+                {
+                    return Fail(string("truncated integer"));
+                }
+                auto value = static_cast<int64_t>(signal.previous) + TelemetryFormat::ZigZagDecode(encoded);
+                signal.previous = static_cast<uint64_t>(value);
+                sample.value = static_cast<double>(value);
+            }
+            break;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool TelemetryReader::ReadSignal()
+{
+    TelemetrySignal signal;
+    if (!TelemetryFormat::ReadVarint(m_pos, m_end, signal.id) || m_pos >= m_end)
+    {
+        return Fail(string("truncated signal"));
+    }
+    if (signal.id != m_signals.size())
+    {
+        return Fail(string("signal ids out of order"));
+    }
+    auto type = *m_pos++;
+    if (type > TelemetryFormat::SIGNAL_TYPE::INT_SIGNAL)
+    {
+        return Fail(string("unknown signal type ") + to_string(type));
+    }
+    signal.type = static_cast<TelemetryFormat::SIGNAL_TYPE>(type);
+    signal.previous = 0;
+    if (!ReadString(signal.group) || !ReadString(signal.identifier))
+    {
+        return false;
+    }
+    m_signals.push_back(signal);
+    return true;
+}
+
+bool TelemetryReader::ReadString
+(
+    string&             text
+)
+{
+    uint64_t len = 0;
+    if (!TelemetryFormat::ReadVarint(m_pos, m_end, len) || len > static_cast<uint64_t>(m_end - m_pos))
+    {
+        return Fail(string("truncated string"));
+    }
+    text.assign(reinterpret_cast<const char*>(m_pos), len);
+    m_pos += len;
+    return true;
+}
+
+bool TelemetryReader::Fail
+(
+    const string&       msg
+)
+{
+    m_error = true;
+    m_errorMsg = msg;
+    return false;
+}
@@ -0,0 +1,96 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+#pragma once
+
+// C++ Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Team 302 includes
+#include <utils/TelemetryFormat.h>
+
+/// @brief one signal (group + identifier) defined in a telemetry file
+struct TelemetrySignal
+{
+    uint64_t                        id;
+    TelemetryFormat::SIGNAL_TYPE    type;
+    std::string                     group;
+    std::string                     identifier;
+    uint64_t                        previous;       // decoder state
+};
+
+/// @brief one decoded sample
+struct TelemetrySample
+{
+    uint64_t        signalId;
+    uint64_t        timestamp;      // microseconds (FPGA time)
+    double          value;          // DOUBLE, INT and BOOL signals
+    std::string     text;           // STRING signals
+};
+
+/// @brief Desktop reader for the binary telemetry files written by the robot's TelemetryRecorder.
+class TelemetryReader
+{
+    public:
+        TelemetryReader();
+        ~TelemetryReader() = default;
+
+        /// @brief read the file and check its header
+        /// @param [in] std::string: path of the .t302 file
+        /// @returns bool: true if the file is a telemetry file this reader understands
+        bool Open
+        (
+            const std::string&      path
+        );
+
+        /// @brief decode the next sample; signal definitions are picked up along the way
+        /// @param [out] TelemetrySample: decoded sample
+        /// @returns bool: false at the end of the file or if the file is corrupt (see HasError)
+        bool Next
+        (
+            TelemetrySample&        sample
+        );
+
+        /// @returns the signals defined so far, indexed by signal id
+        const std::vector<TelemetrySignal>& GetSignals() const { return m_signals; }
+
+        /// @returns bool: true if decoding stopped because of bad data (e.g. a truncated file)
+        bool HasError() const { return m_error; }
+
+        /// @returns std::string: description of the error
+        std::string GetError() const { return m_errorMsg; }
+
+    private:
+        bool ReadSignal();
+        bool ReadString
+        (
+            std::string&            text
+        );
+        bool Fail
+        (
+            const std::string&      msg
+        );
+
+        std::vector<uint8_t>            m_data;
+        const uint8_t*                  m_pos;
+        const uint8_t*                  m_end;
+        std::vector<TelemetrySignal>    m_signals;
+        uint64_t                        m_timestamp;
+        bool                            m_error;
+        std::string                     m_errorMsg;
+};
@@ -0,0 +1,149 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+//========================================================================================================
+/// TelemetryToCsv.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Desktop tool that converts a robot telemetry file (see Logger::SetTelemetryRecording) to CSV.
+///
+///     TelemetryToCsv <file.t302>          one row per sample:  time,group,identifier,value
+///     TelemetryToCsv <file.t302> --wide   one row per timestamp and one column per signal; a column 
+///                                         keeps its last value until the signal is logged again
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Team 302 includes
+#include <TelemetryReader.h>
+
+using namespace std;
+
+static string Quote
+(
+    const string&   text
+)
+{
+    string quoted("\"");
+    for (auto c : text)
+    {
+        quoted += c;
+        if (c == '"')
+        {
+            quoted += c;
+        }
+    }
+    quoted += "\"";
+    return quoted;
+}
+
+static string FormatValue
+(
+    const TelemetrySignal&  signal,
+    const TelemetrySample&  sample
+)
+{
+    switch (signal.type)
+    {
+        case TelemetryFormat::SIGNAL_TYPE::STRING_SIGNAL:
+            return Quote(sample.text);
+
+        case TelemetryFormat::SIGNAL_TYPE::BOOL_SIGNAL:
+        case TelemetryFormat::SIGNAL_TYPE::INT_SIGNAL:
+            return to_string(static_cast<long long>(sample.value));
+
+        default:
+        {
+            char text[32];
+            snprintf(text, sizeof(text), "%.10g", sample.value);
+            return string(text);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        cerr << "usage: TelemetryToCsv <file.t302> [--wide]" << endl;
+        return 1;
+    }
+    auto wide = argc > 2 && string(argv[2]) == string("--wide");
+
+    TelemetryReader reader;
+    if (!reader.Open(argv[1]))
+    {
+        cerr << argv[1] << ": " << reader.GetError() << endl;
+        return 1;
+    }
+
+    TelemetrySample sample;
+    if (!wide)
+    {
+        cout << "time,group,identifier,value\n";
+        while (reader.Next(sample))
+        {
+            auto& signal = reader.GetSignals()[sample.signalId];
+            cout << to_string(sample.timestamp / 1.0e6) << "," << Quote(signal.group) << "," 
+                 << Quote(signal.identifier) << "," << FormatValue(signal, sample) << "\n";
+        }
+    }
+    else
+    {
+        // signals are defined as they are first logged, so read everything before writing the header
+        vector<TelemetrySample> samples;
+        while (reader.Next(sample))
+        {
+            samples.push_back(sample);
+        }
+        auto& signals = reader.GetSignals();
+
+        cout << "time";
+        for (auto& signal : signals)
+        {
+            cout << "," << Quote(signal.group + string("/") + signal.identifier);
+        }
+        cout << "\n";
+
+        vector<string> row(signals.size());
+        for (size_t inx=0; inx<samples.size(); ++inx)
+        {
+            row[samples[inx].signalId] = FormatValue(signals[samples[inx].signalId], samples[inx]);
+            if (inx+1 == samples.size() || samples[inx+1].timestamp != samples[inx].timestamp)
+            {
+                cout << to_string(samples[inx].timestamp / 1.0e6);
+                for (auto& value : row)
+                {
+                    cout << "," << value;
+                }
+                cout << "\n";
+            }
+        }
+    }
+
+    if (reader.HasError())
+    {
+        cerr << argv[1] << ": " << reader.GetError() << endl;
+        return 2;
+    }
+    return 0;
+}
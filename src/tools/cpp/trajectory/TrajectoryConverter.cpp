@@ -0,0 +1,174 @@
+
+//====================================================================================================================================================
+// Copyright 2022 Lake Orion Robotics FIRST Team 302
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+// DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+//====================================================================================================================================================
+
+//========================================================================================================
+/// TrajectoryConverter.cpp
+//========================================================================================================
+///
+/// File Description:
+///     Desktop tool that converts PathWeaver / PathPlanner json trajectories to the binary format in
+///     auton/TrajectoryFormat.h.  The .traj file is written next to the json file; TrajectoryCache
+///     loads it instead of the json when both are deployed and the json hasn't changed since.
+///
+///     TrajectoryConverter <file.json | directory> ...
+///
+///     e.g. from the repository root (the convertTrajectories gradle task, which deploy depends on, 
+///     runs exactly this):
+///     TrajectoryConverter src/main/deploy/paths src/main/deploy/pathplanner/generatedJSON
+///
+//========================================================================================================
+
+// C++ Includes
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// FRC includes
+#include <frc/trajectory/Trajectory.h>
+#include <frc/trajectory/TrajectoryUtil.h>
+#include <wpi/fs.h>
+
+// Team 302 includes
+#include <auton/TrajectoryFormat.h>
+
+using namespace std;
+using namespace TrajectoryFormat;
+
+static bool Convert
+(
+    const string&   jsonPath,
+    const string&   binaryPath
+)
+{
+    frc::Trajectory trajectory;
+    try
+    {
+        trajectory = frc::TrajectoryUtil::FromPathweaverJson(jsonPath);
+    }
+    catch (const exception& e)
+    {
+        cerr << jsonPath << ": " << e.what() << endl;
+        return false;
+    }
+
+    auto& states = trajectory.States();
+    if (states.empty())
+    {
+        cerr << jsonPath << ": no states" << endl;
+        return false;
+    }
+
+    vector<float> columns[NUM_COLUMNS];
+    for (auto& column : columns)
+    {
+        column.reserve(states.size());
+    }
+    for (auto& state : states)
+    {
+        columns[TIME].push_back(state.t.to<float>());
+        columns[X].push_back(state.pose.X().to<float>());
+        columns[Y].push_back(state.pose.Y().to<float>());
+        columns[HEADING].push_back(state.pose.Rotation().Radians().to<float>());
+        columns[VELOCITY].push_back(state.velocity.to<float>());
+        columns[ACCELERATION].push_back(state.acceleration.to<float>());
+        columns[CURVATURE].push_back(state.curvature.to<float>());
+    }
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.columns = NUM_COLUMNS;
+    header.count = static_cast<uint32_t>(states.size());
+
+    // TrajectoryCache compares this with the deployed json and ignores the binary if the path changed
+    ifstream json(jsonPath, ios::binary);
+    string text((istreambuf_iterator<char>(json)), istreambuf_iterator<char>());
+    header.source = HashSource(text.data(), text.size());
+    header.sourceSize = text.size();
+
+    // both the roboRIO and the desktop are little endian, so the arrays are written as they are in memory
+    ofstream file(binaryPath, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (auto& column : columns)
+    {
+        file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(float));
+    }
+    if (!file)
+    {
+        cerr << binaryPath << ": write failed" << endl;
+        return false;
+    }
+
+    cout << jsonPath << " -> " << binaryPath << " (" << states.size() << " states)" << endl;
+    return true;
+}
+
+static bool IsJson
+(
+    const fs::path&     path
+)
+{
+    return path.extension() == ".json";
+}
+
+int main
+(
+    int     argc,
+    char**  argv
+)
+{
+    if (argc < 2)
+    {
+        cerr << "usage: TrajectoryConverter <file.json | directory> ..." << endl;
+        return 1;
+    }
+
+    vector<fs::path> files;
+    for (auto inx=1; inx<argc; ++inx)
+    {
+        fs::path arg(argv[inx]);
+        if (fs::is_directory(arg))
+        {
+            for (auto& entry : fs::directory_iterator(arg))
+            {
+                if (entry.is_regular_file() && IsJson(entry.path()))
+                {
+                    files.push_back(entry.path());
+                }
+            }
+        }
+        else
+        {
+            files.push_back(arg);
+        }
+    }
+
+    auto failures = 0;
+    for (auto& file : files)
+    {
+        auto binary = file.parent_path() / BinaryName(file.filename().string());
+        if (!Convert(file.string(), binary.string()))
+        {
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}